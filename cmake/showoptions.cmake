@@ -79,6 +79,12 @@ else()
   message(STATUS "Build extractors      : No  (default)")
 endif()
 
+if(BUILD_BENCH)
+  message(STATUS "Build mangos-bench    : Yes")
+else()
+  message(STATUS "Build mangos-bench    : No  (default)")
+endif()
+
 if(BUILD_RECASTDEMOMOD)
   message(STATUS "Build RecastDemoMod   : Yes")
 else()
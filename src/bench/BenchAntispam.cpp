@@ -0,0 +1,258 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Chat message classification of the antispam module, run on its analysis workers for every message.
+*/
+
+#include "Util/CodeBench.h"
+#include "Anticheat/module/ahocorasick.hpp"
+#include "Anticheat/module/dldist.hpp"
+
+#include <algorithm>
+#include <regex>
+
+namespace
+{
+    uint32 const CORPUS_MESSAGES        = 2000;
+    uint32 const BLACKLIST_ENTRIES      = 400;
+    uint32 const UNIQUENESS_WINDOW      = 20;               // unique messages a session keeps for the repetition check
+    uint32 const UNIQUENESS_THRESHOLD   = 5;                // Antispam.UniquenessThreshold default
+
+    char const* const spamWords[] = { "GOLD", "CHEAP", "FAST", "DELIVERY", "WWW", "COM", "POWERLEVEL", "DISCOUNT", "BUY", "SELL" };
+    char const* const chatWords[] = { "anyone", "for", "deadmines", "lf", "tank", "need", "healer", "wts", "wtb", "linen", "cloth",
+                                      "pst", "lfg", "ony", "mc", "bwl", "guild", "recruiting", "thanks", "inv", "please", "where", "is" };
+
+    uint32 NextRandom(uint32& seed)
+    {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    }
+
+    // the ascii steps of AntispamMgr::NormalizeStringInternal with the default mask, the module itself is only built with USE_ANTICHEAT
+    std::string Normalize(std::string const& message)
+    {
+        static std::regex const colorRegex("(\\|c\\w{8})");
+        static std::regex const linkRegex("(\\|H[\\w|\\W]{1,}\\|h)");
+        static std::regex const controlRegex("([[:cntrl:]]+)");
+        static std::regex const punctRegex("([[:punct:]]+)");
+        static std::regex const spaceRegex("(\\s+|_)");
+
+        std::string result = std::regex_replace(message, colorRegex, "");
+        result = std::regex_replace(result, linkRegex, "");
+        result = std::regex_replace(result, controlRegex, "");
+        result = std::regex_replace(result, punctRegex, "");
+        result = std::regex_replace(result, spaceRegex, "");
+        std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    struct Blacklist
+    {
+        std::vector<std::pair<std::string, std::string>> entries;
+        nam::aho_corasick original;
+        nam::aho_corasick normalized;
+    };
+
+    // word pairs the way gold sellers advertise, plus made up site names
+    Blacklist CreateBlacklist()
+    {
+        Blacklist blacklist;
+        uint32 seed = 4711;
+        while (blacklist.entries.size() < BLACKLIST_ENTRIES)
+        {
+            std::string entry = spamWords[NextRandom(seed) % 10];
+            entry += NextRandom(seed) % 2 ? " " : "";
+            entry += spamWords[NextRandom(seed) % 10];
+            if (blacklist.entries.size() % 4 == 0)
+                entry += std::to_string(NextRandom(seed) % 1000);
+            blacklist.entries.emplace_back(entry, Normalize(entry));
+        }
+
+        for (size_t i = 0; i < blacklist.entries.size(); ++i)
+        {
+            blacklist.original.add(blacklist.entries[i].first, i);
+            blacklist.normalized.add(blacklist.entries[i].second, i);
+        }
+        blacklist.original.build();
+        blacklist.normalized.build();
+        return blacklist;
+    }
+
+    // one in ten messages is an advertisement, obfuscated with colors, punctuation and spacing
+    std::vector<std::string> CreateCorpus()
+    {
+        std::vector<std::string> corpus;
+        uint32 seed = 12345;
+        for (uint32 i = 0; i < CORPUS_MESSAGES; ++i)
+        {
+            std::string message;
+            if (i % 10 == 0)
+            {
+                message = "|cffff0000";
+                for (uint32 words = 4 + NextRandom(seed) % 4; words; --words)
+                {
+                    for (char const* c = spamWords[NextRandom(seed) % 10]; *c; ++c)
+                    {
+                        message += *c;
+                        if (NextRandom(seed) % 3 == 0)
+                            message += NextRandom(seed) % 2 ? "." : " ";
+                    }
+                    message += ' ';
+                }
+                message += "|r";
+            }
+            else
+            {
+                for (uint32 words = 3 + NextRandom(seed) % 8; words; --words)
+                {
+                    message += chatWords[NextRandom(seed) % 23];
+                    message += ' ';
+                }
+            }
+            corpus.push_back(message);
+        }
+        return corpus;
+    }
+
+    // non-overlapping occurrences of every entry, as AntispamMgr::CheckBlacklist counts them
+    uint32 CountMatches(nam::aho_corasick const& automaton, std::string const& text, std::vector<std::pair<std::string, std::string>> const& entries,
+        bool normalized, std::vector<size_t>& nextStart)
+    {
+        uint32 count = 0;
+        std::fill(nextStart.begin(), nextStart.end(), 0);
+        automaton.match(text, [&](size_t id, size_t pos)
+        {
+            if (pos < nextStart[id])
+                return;
+
+            ++count;
+            nextStart[id] = pos + (normalized ? entries[id].second : entries[id].first).length();
+        });
+        return count;
+    }
+
+    // the blacklist scan before the automaton, one find loop per entry and form
+    uint32 CountFinds(std::string const& text, std::string const& entry)
+    {
+        uint32 count = 0;
+        for (size_t pos = text.find(entry); pos != std::string::npos; pos = text.find(entry, pos + entry.length()))
+            ++count;
+        return count;
+    }
+
+    void SetMessageRate(BenchState& state, uint32 matches)
+    {
+        double const seconds = state.GetElapsedNanos() / 1e9;
+        uint64 const messages = seconds > 0.0 ? uint64(state.GetIterations() * CORPUS_MESSAGES / seconds) : 0;
+        state.SetLabel(std::to_string(messages) + " messages/s, " + std::to_string(matches) + " matches");
+    }
+}
+
+BENCHMARK(AntispamBlacklistFind)
+{
+    Blacklist blacklist = CreateBlacklist();
+    std::vector<std::pair<std::string, std::string>> corpus;
+    for (std::string const& message : CreateCorpus())
+        corpus.emplace_back(message, Normalize(message));
+
+    uint32 matches = 0;
+    while (state.KeepRunning())
+    {
+        matches = 0;
+        for (auto const& message : corpus)
+        {
+            for (auto const& entry : blacklist.entries)
+            {
+                matches += CountFinds(message.first, entry.first);
+                matches += CountFinds(message.second, entry.second);
+            }
+        }
+        BenchDoNotOptimize(matches);
+    }
+
+    SetMessageRate(state, matches);
+}
+
+BENCHMARK(AntispamBlacklistAutomaton)
+{
+    Blacklist blacklist = CreateBlacklist();
+    std::vector<std::pair<std::string, std::string>> corpus;
+    for (std::string const& message : CreateCorpus())
+        corpus.emplace_back(message, Normalize(message));
+
+    std::vector<size_t> nextStart(blacklist.entries.size());
+    uint32 matches = 0;
+    while (state.KeepRunning())
+    {
+        matches = 0;
+        for (auto const& message : corpus)
+        {
+            matches += CountMatches(blacklist.original, message.first, blacklist.entries, false, nextStart);
+            matches += CountMatches(blacklist.normalized, message.second, blacklist.entries, true, nextStart);
+        }
+        BenchDoNotOptimize(matches);
+    }
+
+    SetMessageRate(state, matches);
+}
+
+// everything an analysis worker does per message: normalization, the blacklist and the repetition check against
+// the recent unique messages of the session
+BENCHMARK(AntispamClassify)
+{
+    Blacklist blacklist = CreateBlacklist();
+    std::vector<std::string> corpus = CreateCorpus();
+
+    std::vector<size_t> nextStart(blacklist.entries.size());
+    std::vector<std::string> uniqueMessages;
+    uint32 matches = 0;
+    while (state.KeepRunning())
+    {
+        matches = 0;
+        uniqueMessages.clear();
+        for (std::string const& message : corpus)
+        {
+            std::string const normalized = Normalize(message);
+            matches += CountMatches(blacklist.original, message, blacklist.entries, false, nextStart);
+            matches += CountMatches(blacklist.normalized, normalized, blacklist.entries, true, nextStart);
+
+            bool repeated = false;
+            for (std::string const& unique : uniqueMessages)
+            {
+                if (uint32(nam::damerau_levenshtein_distance(normalized, unique)) < UNIQUENESS_THRESHOLD)
+                {
+                    repeated = true;
+                    break;
+                }
+            }
+
+            if (!repeated)
+            {
+                if (uniqueMessages.size() == UNIQUENESS_WINDOW)
+                    uniqueMessages.erase(uniqueMessages.begin());
+                uniqueMessages.push_back(normalized);
+            }
+        }
+        BenchDoNotOptimize(matches);
+    }
+
+    SetMessageRate(state, matches);
+}
@@ -0,0 +1,290 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Server side SRP6 verification and the realmd login path, run for every login.
+*/
+
+#include "Util/CodeBench.h"
+#include "Auth/SRP6.h"
+
+#include <boost/asio.hpp>
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    // account TEST with password TEST
+    char const* const BENCH_PASS_HASH = "3D0D99423E31FCC67A6745EC89D70D700344BC76";
+    char const* const BENCH_SALT      = "B7A0F4C1F9F1C43E5F8B9F5D6C3E2A1B0F9E8D7C6B5A49382716050403020100";
+
+    struct LoginSetup
+    {
+        LoginSetup()
+        {
+            SRP6 srp;
+            srp.CalculateVerifier(BENCH_PASS_HASH, BENCH_SALT);
+            verifier = srp.GetVerifier();
+
+            // what the client sends as its public ephemeral, g^a mod N
+            BigNumber a, g = srp.GetGeneratorModulo(), N = srp.GetPrime();
+            a.SetRand(19 * 8);
+            clientPublic = g.ModExp(a, N).AsByteArray(32);
+        }
+
+        BigNumber verifier;
+        std::vector<uint8> clientPublic;
+    };
+
+    // the big number operations as SRP6 did them before the shared contexts, a new BN_CTX for every operation
+    void FreshMul(BigNumber& a, BigNumber& b, BigNumber& result)
+    {
+        BN_CTX* ctx = BN_CTX_new();
+        BN_mul(result.BN(), a.BN(), b.BN(), ctx);
+        BN_CTX_free(ctx);
+    }
+
+    void FreshMod(BigNumber& a, BigNumber& m, BigNumber& result)
+    {
+        BN_CTX* ctx = BN_CTX_new();
+        BN_mod(result.BN(), a.BN(), m.BN(), ctx);
+        BN_CTX_free(ctx);
+    }
+
+    void FreshModExp(BigNumber& base, BigNumber& exponent, BigNumber& m, BigNumber& result)
+    {
+        BN_CTX* ctx = BN_CTX_new();
+        BN_mod_exp(result.BN(), base.BN(), exponent.BN(), m.BN(), ctx);
+        BN_CTX_free(ctx);
+    }
+
+    void SetLoginRate(BenchState& state, uint32 loginsPerIteration, char const* unit)
+    {
+        double const seconds = state.GetElapsedNanos() / 1e9;
+        state.SetLabel(std::to_string(seconds > 0.0 ? uint64(state.GetIterations() * loginsPerIteration / seconds) : 0) + unit);
+    }
+
+    uint32 const LOGIN_STORM                = 128;          // logins handled per iteration, all arriving at once
+    uint32 const LOGIN_NETWORK_THREADS      = 4;
+    uint32 const LOGIN_DATABASE_CONNECTIONS = 2;            // LoginDatabaseConnections default
+    std::chrono::microseconds const LOGIN_QUERY_LATENCY(100);   // one round trip to a local MySQL
+
+    // stands in for a MySQL connection, a query holds it for the round trip
+    struct StubDatabaseConnection
+    {
+        void Query(uint32 queries)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            std::this_thread::sleep_for(LOGIN_QUERY_LATENCY * queries);
+        }
+
+        std::mutex lock;
+    };
+
+    // the handlers before the change, querying the single query connection on the network thread
+    struct SynchronousQueries
+    {
+        template <class Handler>
+        void Run(boost::asio::io_context& /*network*/, uint32 queries, Handler handler)
+        {
+            connection.Query(queries);
+            handler();
+        }
+
+        StubDatabaseConnection connection;
+    };
+
+    // AuthSocket::AsyncQuery, one worker per query connection, the result is posted back to the network threads
+    struct AsyncQueries
+    {
+        AsyncQueries() : connections(LOGIN_DATABASE_CONNECTIONS), work(boost::asio::make_work_guard(context))
+        {
+            for (uint32 i = 0; i < LOGIN_DATABASE_CONNECTIONS; ++i)
+                threads.emplace_back([this, i]() { t_connection = &connections[i]; context.run(); });
+        }
+
+        ~AsyncQueries()
+        {
+            work.reset();
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        template <class Handler>
+        void Run(boost::asio::io_context& network, uint32 queries, Handler handler)
+        {
+            boost::asio::post(context, [&network, queries, handler]()
+            {
+                t_connection->Query(queries);
+                boost::asio::post(network, handler);
+            });
+        }
+
+        static thread_local StubDatabaseConnection* t_connection;
+
+        std::vector<StubDatabaseConnection> connections;
+        boost::asio::io_context context;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
+        std::vector<std::thread> threads;
+    };
+
+    thread_local StubDatabaseConnection* AsyncQueries::t_connection = nullptr;
+
+    // logon challenge (ip ban, account and account ban), logon proof (session key and account_logons) and realm
+    // list (account and numchars) of every login, with the SRP6 work of the challenge and proof on the network threads
+    template <class Queries>
+    void RunLoginStorm(Queries& queries, std::vector<SRP6>& logins, std::vector<uint8>& clientPublic)
+    {
+        boost::asio::io_context network;
+        auto work = boost::asio::make_work_guard(network);
+        std::atomic<uint32> completed(0);
+
+        for (SRP6& login : logins)
+        {
+            SRP6* srp = &login;
+            boost::asio::post(network, [&, srp]()
+            {
+                queries.Run(network, 3, [&, srp]()
+                {
+                    srp->CalculateHostPublicEphemeral();
+                    boost::asio::post(network, [&, srp]()
+                    {
+                        srp->CalculateSessionKey(clientPublic.data(), int(clientPublic.size()));
+                        queries.Run(network, 2, [&]()
+                        {
+                            boost::asio::post(network, [&]()
+                            {
+                                queries.Run(network, 2, [&]()
+                                {
+                                    if (++completed == logins.size())
+                                        work.reset();
+                                });
+                            });
+                        });
+                    });
+                });
+            });
+        }
+
+        std::vector<std::thread> threads;
+        for (uint32 i = 0; i < LOGIN_NETWORK_THREADS; ++i)
+            threads.emplace_back([&network]() { network.run(); });
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::vector<SRP6> CreateLogins(LoginSetup const& setup)
+    {
+        char const* verifier = setup.verifier.AsHexStr();
+        std::vector<SRP6> logins(LOGIN_STORM);
+        for (SRP6& srp : logins)
+        {
+            srp.SetSalt(BENCH_SALT);
+            srp.SetVerifier(verifier);
+        }
+        OPENSSL_free((void*)verifier);
+        return logins;
+    }
+}
+
+// CalculateHostPublicEphemeral and CalculateSessionKey of the realmd logon challenge and proof
+BENCHMARK(SRP6VerifyFreshContext)
+{
+    LoginSetup setup;
+    SRP6 srp;
+    BigNumber N = srp.GetPrime(), g = srp.GetGeneratorModulo(), three(3);
+    BigNumber v = setup.verifier;
+
+    BigNumber b, B, gmod, v3, sum, A, remainder, u, vu, Avu, S;
+    while (state.KeepRunning())
+    {
+        b.SetRand(19 * 8);
+        FreshModExp(g, b, N, gmod);
+        FreshMul(v, three, v3);
+        BN_add(sum.BN(), v3.BN(), gmod.BN());
+        FreshMod(sum, N, B);
+
+        A.SetBinary(setup.clientPublic.data(), int(setup.clientPublic.size()));
+        FreshMod(A, N, remainder);
+        if (remainder.isZero())
+            continue;
+
+        Sha1Hash sha;
+        sha.UpdateBigNumbers(&A, &B, nullptr);
+        sha.Finalize();
+        u.SetBinary(sha.GetDigest(), 20);
+        FreshModExp(v, u, N, vu);
+        FreshMul(A, vu, Avu);
+        FreshModExp(Avu, b, N, S);
+        BenchDoNotOptimize(S.BN());
+    }
+
+    SetLoginRate(state, 1, " logins/s per thread");
+}
+
+// the same steps through SRP6, which uses the thread's BN_CTX and the shared Montgomery context for N
+BENCHMARK(SRP6VerifySharedContext)
+{
+    LoginSetup setup;
+    SRP6 srp;
+    char const* verifier = setup.verifier.AsHexStr();
+    srp.SetSalt(BENCH_SALT);
+    srp.SetVerifier(verifier);
+    OPENSSL_free((void*)verifier);
+
+    std::vector<uint8> clientPublic = setup.clientPublic;
+    while (state.KeepRunning())
+    {
+        srp.CalculateHostPublicEphemeral();
+        bool valid = srp.CalculateSessionKey(clientPublic.data(), int(clientPublic.size()));
+        BenchDoNotOptimize(valid);
+    }
+
+    SetLoginRate(state, 1, " logins/s per thread");
+}
+
+// a login storm after a restart against a stub database with a fixed round trip, the queries of
+// every login either block a network thread on the one query connection or go to the workers
+BENCHMARK(RealmdLoginStormSynchronous)
+{
+    LoginSetup setup;
+    std::vector<SRP6> logins = CreateLogins(setup);
+    SynchronousQueries queries;
+
+    while (state.KeepRunning())
+        RunLoginStorm(queries, logins, setup.clientPublic);
+
+    SetLoginRate(state, LOGIN_STORM, " logins/s");
+}
+
+BENCHMARK(RealmdLoginStormAsync)
+{
+    LoginSetup setup;
+    std::vector<SRP6> logins = CreateLogins(setup);
+    AsyncQueries queries;
+
+    while (state.KeepRunning())
+        RunLoginStorm(queries, logins, setup.clientPublic);
+
+    SetLoginRate(state, LOGIN_STORM, " logins/s");
+}
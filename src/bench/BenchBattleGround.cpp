@@ -0,0 +1,185 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Rated arena matchmaking of the battleground queue thread, run for every queue update.
+*/
+
+#include "Util/CodeBench.h"
+#include "BattleGround/BattleGroundQueue.h"
+
+#include <algorithm>
+
+namespace
+{
+    uint32 const QUEUED_PLAYERS         = 10000;
+    uint32 const TEAM_SIZE              = 2;                // 2v2, every queued team is one group
+    uint32 const RATING_WINDOW          = 150;              // Arena.MaxRatingDifference, the default 0 widens it to 5000
+    uint32 const RATING_DISCARD_TIMER   = 600000;           // Arena.RatingDiscardTimer default
+    uint32 const QUEUE_NOW              = 3600000;          // queue thread time, an hour after startup
+    uint32 const QUEUE_JOIN_SPREAD      = 30;               // ms between two joins, the queue filled up in the last minutes
+
+    typedef std::list<GroupQueueInfo*> GroupsQueueType;
+    typedef std::map<uint32, GroupsQueueType> RatingBucketMap;
+
+    // the premade queues of one bracket and their rating buckets, as BattleGroundQueueItem keeps them
+    struct RatedQueue
+    {
+        std::vector<GroupQueueInfo> groups;
+        GroupsQueueType queued[PVP_TEAM_COUNT];
+        RatingBucketMap buckets[PVP_TEAM_COUNT];
+    };
+
+    // ratings are spread around 1500 like on a live realm, both factions join alternately
+    void CreateRatedQueue(RatedQueue& queue)
+    {
+        uint32 seed = 12345;
+        auto random = [&seed](uint32 range) { seed = seed * 1103515245 + 12345; return (seed >> 16) % range; };
+
+        uint32 const teams = QUEUED_PLAYERS / TEAM_SIZE;
+        queue.groups.resize(teams);
+        for (uint32 i = 0; i < teams; ++i)
+        {
+            GroupQueueInfo& group = queue.groups[i];
+            group.groupTeam = i % 2 ? HORDE : ALLIANCE;
+            group.isRated = true;
+            group.arenaType = ARENA_TYPE_2v2;
+            group.arenaTeamId = i + 1;
+            group.joinTime = QUEUE_NOW - (teams - i) * QUEUE_JOIN_SPREAD;
+            group.isInvitedToBgInstanceGuid = 0;
+            group.arenaTeamRating = 900 + random(400) + random(400) + random(400);
+            group.opponentsTeamRating = 0;
+            group.queueIndex = i % 2 ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
+
+            GroupsQueueType& queued = queue.queued[group.queueIndex];
+            group.queuePos = queued.insert(queued.end(), &group);
+            GroupsQueueType& bucket = queue.buckets[group.queueIndex][group.arenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE];
+            group.ratingPos = bucket.insert(bucket.end(), &group);
+        }
+    }
+
+    // the queue walk BattleGroundQueueItem::Update did before the buckets, the first team in join order which matches
+    GroupQueueInfo* ScanRatedGroup(RatedQueue& queue, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude)
+    {
+        for (GroupQueueInfo* groupInfo : queue.queued[index])
+        {
+            if (!groupInfo->isInvitedToBgInstanceGuid && groupInfo != exclude
+                && ((groupInfo->arenaTeamRating >= minRating && groupInfo->arenaTeamRating <= maxRating) || groupInfo->joinTime < discardTime))
+                return groupInfo;
+        }
+        return nullptr;
+    }
+
+    // BattleGroundQueueItem::SelectRatedGroup, the head of the queue for the discard rule and the buckets in the window
+    GroupQueueInfo* SelectRatedGroup(RatedQueue& queue, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude)
+    {
+        for (GroupQueueInfo* groupInfo : queue.queued[index])
+        {
+            if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude)
+                continue;
+
+            if (groupInfo->joinTime < discardTime)
+                return groupInfo;
+
+            break;
+        }
+
+        GroupQueueInfo* selected = nullptr;
+        RatingBucketMap& buckets = queue.buckets[index];
+        for (RatingBucketMap::iterator itr = buckets.lower_bound(minRating / BG_QUEUE_RATING_BUCKET_SIZE); itr != buckets.end() && itr->first <= maxRating / BG_QUEUE_RATING_BUCKET_SIZE; ++itr)
+        {
+            for (GroupQueueInfo* groupInfo : itr->second)
+            {
+                if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude || groupInfo->arenaTeamRating < minRating || groupInfo->arenaTeamRating > maxRating)
+                    continue;
+
+                if (!selected || WorldTimer::getMSTimeDiff(groupInfo->joinTime, QUEUE_NOW) > WorldTimer::getMSTimeDiff(selected->joinTime, QUEUE_NOW))
+                    selected = groupInfo;
+                break;
+            }
+        }
+
+        return selected;
+    }
+
+    // one rated pass of BattleGroundQueueItem::Update for the rating of the team that triggered it: a team from
+    // each faction, otherwise a second team from the faction that had one
+    template <class Select>
+    uint32 MatchRatedPass(RatedQueue& queue, uint32 arenaRating, Select select)
+    {
+        uint32 const minRating = arenaRating <= RATING_WINDOW ? 0 : arenaRating - RATING_WINDOW;
+        uint32 const maxRating = arenaRating + RATING_WINDOW;
+        uint32 const discardTime = QUEUE_NOW - RATING_DISCARD_TIMER;
+
+        GroupQueueInfo* selected[PVP_TEAM_COUNT];
+        for (uint32 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
+            selected[i] = select(queue, i, minRating, maxRating, discardTime, nullptr);
+
+        if (!selected[TEAM_INDEX_ALLIANCE] && selected[TEAM_INDEX_HORDE])
+            selected[TEAM_INDEX_ALLIANCE] = select(queue, BG_QUEUE_PREMADE_HORDE, minRating, maxRating, discardTime, selected[TEAM_INDEX_HORDE]);
+        if (!selected[TEAM_INDEX_HORDE] && selected[TEAM_INDEX_ALLIANCE])
+            selected[TEAM_INDEX_HORDE] = select(queue, BG_QUEUE_PREMADE_ALLIANCE, minRating, maxRating, discardTime, selected[TEAM_INDEX_ALLIANCE]);
+
+        return selected[TEAM_INDEX_ALLIANCE] && selected[TEAM_INDEX_HORDE] ? 1 : 0;
+    }
+
+    // every pass is triggered by another queued team, the match found is not invited so the load stays the same -
+    // or by a team rated above everyone else, the pass a long queue spends most of its updates on
+    template <class Select>
+    void RunRatedPasses(BenchState& state, Select select, bool unmatched)
+    {
+        RatedQueue queue;
+        CreateRatedQueue(queue);
+
+        std::vector<uint32> triggers;
+        for (GroupQueueInfo const& group : queue.groups)
+            triggers.push_back(group.arenaTeamRating);
+        if (unmatched)
+            triggers.assign(1, *std::max_element(triggers.begin(), triggers.end()) + RATING_WINDOW + 1);
+
+        uint32 passes = 0, matches = 0;
+        while (state.KeepRunning())
+        {
+            matches += MatchRatedPass(queue, triggers[passes++ % triggers.size()], select);
+            BenchDoNotOptimize(matches);
+        }
+
+        state.SetLabel(std::to_string(QUEUED_PLAYERS) + " players queued, " + std::to_string(passes ? uint64(matches) * 100 / passes : 0) + "% passes matched");
+    }
+}
+
+BENCHMARK(ArenaMatchQueueScan)
+{
+    RunRatedPasses(state, ScanRatedGroup, false);
+}
+
+BENCHMARK(ArenaMatchRatingBuckets)
+{
+    RunRatedPasses(state, SelectRatedGroup, false);
+}
+
+BENCHMARK(ArenaNoMatchQueueScan)
+{
+    RunRatedPasses(state, ScanRatedGroup, true);
+}
+
+BENCHMARK(ArenaNoMatchRatingBuckets)
+{
+    RunRatedPasses(state, SelectRatedGroup, true);
+}
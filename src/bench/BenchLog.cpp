@@ -0,0 +1,139 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Log file output from the map update threads, synchronous and through the asynchronous writer.
+*/
+
+#include "Util/CodeBench.h"
+#include "Config/Config.h"
+#include "Log/Log.h"
+#include "Platform/Filesystem.h"
+
+#include <fstream>
+#include <thread>
+
+namespace
+{
+    uint32 const LOG_THREADS                = 8;            // map update threads logging at once
+    uint32 const LOG_MESSAGES_PER_THREAD    = 2000;
+
+#ifdef _WIN32
+    char const* const NULL_DEVICE = "NUL";
+#else
+    char const* const NULL_DEVICE = "/dev/null";
+#endif
+
+    // points sLog at a log file on the null device for debug messages only, the console stays quiet, and
+    // back to no log file afterwards - the cost measured is formatting and the hand off, not the disk
+    class BenchLogFile
+    {
+        public:
+            BenchLogFile() : m_configFile((MaNGOS::Filesystem::temp_directory_path() / "mangos-bench-log.conf").string())
+            {
+                LoadConfig(std::string("LogFile = ") + NULL_DEVICE + "\nLogLevel = 0\nLogFileLevel = 3\n");
+            }
+
+            ~BenchLogFile()
+            {
+                LoadConfig("");
+            }
+
+            bool IsOpen() const { return m_open; }
+
+        private:
+            void LoadConfig(std::string const& content)
+            {
+                {
+                    std::ofstream out(m_configFile, std::ofstream::trunc);
+                    out << content;
+                }
+
+                m_open = sConfig.SetSource(m_configFile, "MangosBench_") && !content.empty();
+                sLog.Initialize();
+
+                MaNGOS::Filesystem::remove(m_configFile);
+            }
+
+            std::string m_configFile;
+            bool m_open = false;
+    };
+
+    void WriteFromThreads()
+    {
+        std::vector<std::thread> threads;
+        for (uint32 i = 0; i < LOG_THREADS; ++i)
+        {
+            threads.emplace_back([i]()
+            {
+                for (uint32 message = 0; message < LOG_MESSAGES_PER_THREAD; ++message)
+                    sLog.outDebug("Map update thread %u: creature %u reached its waypoint", i, message);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    void SetMessageRate(BenchState& state, std::string const& detail = "")
+    {
+        double const seconds = state.GetElapsedNanos() / 1e9;
+        uint64 const messages = seconds > 0.0 ? uint64(state.GetIterations() * LOG_THREADS * LOG_MESSAGES_PER_THREAD / seconds) : 0;
+        state.SetLabel(std::to_string(messages) + " messages/s" + detail);
+    }
+}
+
+// every thread takes the log lock and writes its message itself
+BENCHMARK(LogWriteSynchronous)
+{
+    BenchLogFile logFile;
+    if (!logFile.IsOpen())
+    {
+        state.Skip("could not write the log config");
+        return;
+    }
+
+    while (state.KeepRunning())
+        WriteFromThreads();
+
+    SetMessageRate(state);
+}
+
+// every thread pushes into its own queue, StopAsyncWriter returns once everything queued is written
+BENCHMARK(LogWriteAsync)
+{
+    BenchLogFile logFile;
+    if (!logFile.IsOpen())
+    {
+        state.Skip("could not write the log config");
+        return;
+    }
+
+    uint64 const written = sLog.GetAsyncWrittenCount();
+    uint64 const blocked = sLog.GetAsyncBlockedCount();
+    while (state.KeepRunning())
+    {
+        sLog.StartAsyncWriter();
+        WriteFromThreads();
+        sLog.StopAsyncWriter();
+    }
+
+    uint64 const lost = state.GetIterations() * LOG_THREADS * LOG_MESSAGES_PER_THREAD - (sLog.GetAsyncWrittenCount() - written);
+    SetMessageRate(state, ", " + std::to_string(sLog.GetAsyncBlockedCount() - blocked) + " pushes blocked, " + std::to_string(lost) + " not written");
+}
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Grid, terrain and navigation lookups done for every moving object.
+*/
+
+#include "Util/CodeBench.h"
+#include "Grids/Cell.h"
+#include "Maps/GridMap.h"
+#include "Maps/GridMapDefines.h"
+#include "Entities/ObjectDefines.h"
+#include "MotionGenerators/MoveMap.h"
+#include "Util/Util.h"
+
+#include <bitset>
+#include <cmath>
+
+extern std::string g_benchDataDir;
+extern char const* MAP_MAGIC;
+extern char const* MAP_VERSION_MAGIC;
+extern char const* MAP_HEIGHT_MAGIC;
+
+// the cell walk of Map::Update for active objects: every cell in visibility range is marked and visited once
+BENCHMARK(CellAreaVisit)
+{
+    std::vector<std::pair<float, float>> positions;
+    for (uint32 i = 0; i < 64; ++i)
+        positions.emplace_back(-9000.0f + frand(-400.0f, 400.0f), -100.0f + frand(-400.0f, 400.0f));
+
+    std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP * TOTAL_NUMBER_OF_CELLS_PER_MAP> marked;
+    while (state.KeepRunning())
+    {
+        marked.reset();
+        uint32 visited = 0;
+        for (auto const& position : positions)
+        {
+            CellArea area = Cell::CalculateCellArea(position.first, position.second, DEFAULT_VISIBILITY_DISTANCE);
+            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+            {
+                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                {
+                    uint32 cellId = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                    if (marked.test(cellId))
+                        continue;
+
+                    marked.set(cellId);
+                    Cell cell(CellPair(x, y));
+                    visited += cell.GridX() + cell.CellY();
+                }
+            }
+        }
+        BenchDoNotOptimize(visited);
+    }
+}
+
+// a generated float height grid, so the benchmark runs without extracted client data
+BENCHMARK(GridMapGetHeight)
+{
+    std::string file = g_benchDataDir.empty() ? std::string("bench_grid.map") : g_benchDataDir + "bench_grid.map";
+    {
+        std::vector<float> v9(129 * 129), v8(128 * 128);
+        for (uint32 i = 0; i < v9.size(); ++i)
+            v9[i] = 50.0f + 20.0f * std::sin(i * 0.01f);
+        for (uint32 i = 0; i < v8.size(); ++i)
+            v8[i] = 50.0f + 20.0f * std::cos(i * 0.01f);
+
+        GridMapFileHeader header = {};
+        header.mapMagic = *((uint32 const*)(MAP_MAGIC));
+        header.versionMagic = *((uint32 const*)(MAP_VERSION_MAGIC));
+        header.heightMapOffset = sizeof(header);
+        header.heightMapSize = sizeof(GridMapHeightHeader) + (v9.size() + v8.size()) * sizeof(float);
+
+        GridMapHeightHeader height = {};
+        height.fourcc = *((uint32 const*)(MAP_HEIGHT_MAGIC));
+        height.gridHeight = 30.0f;
+        height.gridMaxHeight = 70.0f;
+
+        FILE* out = fopen(file.c_str(), "wb");
+        if (!out)
+        {
+            state.Skip("can not write " + file);
+            return;
+        }
+
+        fwrite(&header, sizeof(header), 1, out);
+        fwrite(&height, sizeof(height), 1, out);
+        fwrite(v9.data(), sizeof(float), v9.size(), out);
+        fwrite(v8.data(), sizeof(float), v8.size(), out);
+        fclose(out);
+    }
+
+    GridMap grid;
+    bool loaded = grid.loadData(file.c_str());
+    remove(file.c_str());
+    if (!loaded)
+    {
+        state.Skip("generated grid did not load");
+        return;
+    }
+
+    // grid 32,32 spans 0 .. -SIZE_OF_GRIDS on both axes
+    std::vector<std::pair<float, float>> positions;
+    for (uint32 i = 0; i < 256; ++i)
+        positions.emplace_back(-frand(0.0f, SIZE_OF_GRIDS), -frand(0.0f, SIZE_OF_GRIDS));
+
+    while (state.KeepRunning())
+    {
+        float sum = 0.0f;
+        for (auto const& position : positions)
+            sum += grid.getHeight(position.first, position.second);
+        BenchDoNotOptimize(sum);
+    }
+}
+
+// the detour queries of PathFinder::calculate on real navmesh tiles, a path through Northshire Valley
+BENCHMARK(PathFinderNavMesh)
+{
+    if (g_benchDataDir.empty())
+    {
+        state.Skip("needs --data with extracted mmaps");
+        return;
+    }
+
+    uint32 const mapId = 0;
+    float const start[3] = { -132.49f, 83.53f, -8949.95f };           // detour order: y, z, x
+    float const end[3] = { -53.77f, 81.49f, -9034.42f };
+
+    MMAP::MMapManager manager;
+    if (!manager.loadMapInstance(g_benchDataDir, mapId, 0))
+    {
+        state.Skip("no mmaps for map 0 in " + g_benchDataDir);
+        return;
+    }
+
+    int32 gx = int32(32 - start[2] / SIZE_OF_GRIDS);
+    int32 gy = int32(32 - start[0] / SIZE_OF_GRIDS);
+    for (int32 x = gx - 1; x <= gx + 1; ++x)
+        for (int32 y = gy - 1; y <= gy + 1; ++y)
+            manager.loadMap(g_benchDataDir, mapId, x, y);
+
+    dtNavMeshQuery const* query = manager.GetNavMeshQuery(mapId, 0);
+    dtQueryFilter filter;
+    float const extents[3] = { 3.0f, 5.0f, 3.0f };
+    float nearest[3];
+    dtPolyRef startPoly = 0, endPoly = 0;
+    if (!query || dtStatusFailed(query->findNearestPoly(start, extents, &filter, &startPoly, nearest)) || !startPoly ||
+            dtStatusFailed(query->findNearestPoly(end, extents, &filter, &endPoly, nearest)) || !endPoly)
+    {
+        state.Skip("no navmesh polygons at the path ends");
+        return;
+    }
+
+    dtPolyRef polys[256];
+    float points[74 * 3];
+    while (state.KeepRunning())
+    {
+        int polyCount = 0, pointCount = 0;
+        query->findPath(startPoly, endPoly, start, end, &filter, polys, &polyCount, 256);
+        query->findStraightPath(start, end, polys, polyCount, points, nullptr, nullptr, &pointCount, 74);
+        BenchDoNotOptimize(pointCount);
+    }
+}
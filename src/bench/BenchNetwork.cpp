@@ -0,0 +1,244 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Packet building and parsing, run for every packet sent or received.
+*/
+
+#include "Util/CodeBench.h"
+#include "Util/ByteBuffer.h"
+#include "Server/AuthCrypt.h"
+#include "Auth/BigNumber.h"
+#include "Util/BufferPool.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+BENCHMARK(ByteBufferWrite)
+{
+    ByteBuffer buffer(256);
+    while (state.KeepRunning())
+    {
+        buffer.clear();
+        for (uint32 i = 0; i < 8; ++i)
+        {
+            buffer << uint32(i);
+            buffer << float(i * 1.5f);
+            buffer.appendPackGUID(uint64(0xF130000000000000ULL | i));
+        }
+        buffer << "Hello from the benchmark";
+        BenchDoNotOptimize(buffer.contents());
+    }
+    state.SetBytesProcessed(buffer.size());
+}
+
+BENCHMARK(ByteBufferRead)
+{
+    ByteBuffer buffer(256);
+    for (uint32 i = 0; i < 8; ++i)
+    {
+        buffer << uint32(i);
+        buffer << float(i * 1.5f);
+        buffer.appendPackGUID(uint64(0xF130000000000000ULL | i));
+    }
+    buffer << "Hello from the benchmark";
+
+    while (state.KeepRunning())
+    {
+        buffer.rpos(0);
+        uint64 sum = 0;
+        for (uint32 i = 0; i < 8; ++i)
+        {
+            sum += buffer.read<uint32>();
+            sum += uint64(buffer.read<float>());
+            sum += buffer.readPackGUID();
+        }
+        std::string text;
+        buffer >> text;
+        BenchDoNotOptimize(sum);
+        BenchDoNotOptimize(text);
+    }
+    state.SetBytesProcessed(buffer.size());
+}
+
+// world packet headers, 4 bytes encrypted per sent and 6 per received packet
+BENCHMARK(AuthCryptHeaders)
+{
+    BigNumber key;
+    key.SetRand(40 * 8);
+
+    AuthCrypt crypt;
+    crypt.Init(&key);
+
+    std::array<uint8, 6> header = { 0x00, 0x10, 0xDC, 0x00, 0x00, 0x00 };
+    while (state.KeepRunning())
+    {
+        crypt.EncryptSend(header.data(), 4);
+        crypt.DecryptRecv(header.data(), 6);
+        BenchDoNotOptimize(header);
+    }
+    state.SetBytesProcessed(10);
+}
+
+namespace
+{
+    uint32 const PACKET_BATCH = 1024;                       // packets built per iteration
+
+    // stands in for a socket thread, whose write completions drop the last reference to the sent messages
+    template <class Message>
+    class MessageReleaser
+    {
+        public:
+            MessageReleaser() : m_stop(false), m_released(0), m_thread([this]() { Run(); }) {}
+            ~MessageReleaser()
+            {
+                m_stop = true;
+                m_thread.join();
+            }
+
+            void Send(std::shared_ptr<Message>&& message)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_pending.push_back(std::move(message));
+            }
+
+            void WaitReleased(uint64 sent)
+            {
+                while (m_released.load(std::memory_order_acquire) < sent)
+                    std::this_thread::yield();
+            }
+
+        private:
+            void Run()
+            {
+                std::vector<std::shared_ptr<Message>> batch;
+                while (!m_stop)
+                {
+                    {
+                        std::lock_guard<std::mutex> guard(m_lock);
+                        batch.swap(m_pending);
+                    }
+
+                    if (batch.empty())
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    uint64 released = batch.size();
+                    batch.clear();
+                    m_released.fetch_add(released, std::memory_order_release);
+                }
+            }
+
+            std::mutex m_lock;
+            std::vector<std::shared_ptr<Message>> m_pending;
+            std::atomic<bool> m_stop;
+            std::atomic<uint64> m_released;
+            std::thread m_thread;
+    };
+
+    void SetPacketRate(BenchState& state, std::string const& label)
+    {
+        double const seconds = state.GetElapsedNanos() / 1e9;
+        uint64 const packets = seconds > 0.0 ? uint64(state.GetIterations() * PACKET_BATCH / seconds) : 0;
+        state.SetLabel(std::to_string(packets) + " packets/s" + label);
+    }
+
+    // a map thread builds a 60-250 byte packet, WorldSocket::SendPacket copies it into a message with its header and
+    // a socket thread frees the message once written. The packet is built in a vector of ByteBuffer's storage type,
+    // so the heap and pooled cases only differ in where their buffer, message and control block come from
+    template <template <class> class Allocator>
+    uint64 SendPackets(BenchState& state)
+    {
+        typedef std::vector<uint8, Allocator<uint8>> Buffer;
+        typedef std::vector<char, Allocator<char>> Message;
+
+        MessageReleaser<Message> socket;
+        uint64 sent = 0;
+        while (state.KeepRunning())
+        {
+            for (uint32 i = 0; i < PACKET_BATCH; ++i)
+            {
+                Buffer packet;
+                packet.reserve(200);
+                for (uint32 value = 0; value < 12 + i % 40; ++value)
+                {
+                    uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+                    packet.insert(packet.end(), bytes, bytes + sizeof(value));
+                }
+
+                std::shared_ptr<Message> message = std::allocate_shared<Message>(Allocator<Message>(), 4 + packet.size());
+                memcpy(message->data() + 4, packet.data(), packet.size());
+                socket.Send(std::move(message));
+            }
+
+            sent += PACKET_BATCH;
+            socket.WaitReleased(sent);
+        }
+        return sent;
+    }
+}
+
+BENCHMARK(PacketSendHeap)
+{
+    SendPackets<std::allocator>(state);
+    SetPacketRate(state, "");
+}
+
+BENCHMARK(PacketSendPooled)
+{
+    uint64 const heapAllocationsBefore = BufferPool::GetStatistic().heapAllocations;
+    uint64 const sent = SendPackets<BufferPoolAllocator>(state);
+
+    char perPacket[32];
+    snprintf(perPacket, sizeof(perPacket), "%.3f", sent ? double(BufferPool::GetStatistic().heapAllocations - heapAllocationsBefore) / sent : 0.0);
+    SetPacketRate(state, std::string(", ") + perPacket + " pool heap allocations per packet");
+}
+
+// the production path, ByteBuffer (always pooled) copied into the pooled message of WorldSocket
+BENCHMARK(PacketSendByteBuffer)
+{
+    typedef std::vector<char, BufferPoolAllocator<char>> PooledMessage;
+
+    MessageReleaser<PooledMessage> socket;
+    uint64 sent = 0;
+    while (state.KeepRunning())
+    {
+        for (uint32 i = 0; i < PACKET_BATCH; ++i)
+        {
+            ByteBuffer packet(200);
+            for (uint32 value = 0; value < 12 + i % 40; ++value)
+                packet << value;
+
+            std::shared_ptr<PooledMessage> message = std::allocate_shared<PooledMessage>(BufferPoolAllocator<PooledMessage>(), 4 + packet.size());
+            memcpy(message->data() + 4, packet.contents(), packet.size());
+            socket.Send(std::move(message));
+        }
+
+        sent += PACKET_BATCH;
+        socket.WaitReleased(sent);
+    }
+
+    SetPacketRate(state, "");
+}
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Per object work of the map update: value updates, loot generation and respawn.
+*/
+
+#include "Util/CodeBench.h"
+#include "Entities/UpdateMask.h"
+#include "Entities/UpdateFields.h"
+#include "Loot/LootMgr.h"
+#include "Entities/Creature.h"
+#include "Entities/GameObject.h"
+#include "Util/BufferPool.h"
+
+#include <cstring>
+
+// walks a player sized mask the way Object::BuildValuesUpdate does, with a typical sparse set of changes
+BENCHMARK(UpdateMaskIterate)
+{
+    UpdateMask mask;
+    mask.SetCount(PLAYER_END);
+    for (uint32 index = 0; index < PLAYER_END; index += 13)
+        mask.SetBit(index);
+
+    while (state.KeepRunning())
+    {
+        uint32 changed = 0;
+        for (uint32 index = 0; index < mask.GetCount(); ++index)
+            if (mask.GetBit(index))
+                ++changed;
+        BenchDoNotOptimize(changed);
+    }
+    state.SetBytesProcessed(mask.GetLength());
+}
+
+BENCHMARK(UpdateMaskCombine)
+{
+    UpdateMask changed, visible;
+    changed.SetCount(PLAYER_END);
+    visible.SetCount(PLAYER_END);
+    for (uint32 index = 0; index < PLAYER_END; index += 7)
+        changed.SetBit(index);
+    for (uint32 index = 0; index < PLAYER_END; index += 3)
+        visible.SetBit(index);
+
+    while (state.KeepRunning())
+    {
+        UpdateMask result = changed & visible;
+        BenchDoNotOptimize(result.GetMask());
+    }
+    state.SetBytesProcessed(changed.GetLength());
+}
+
+// the chance rolls of a creature loot table, rates are left out so no config or item data is needed
+BENCHMARK(LootRoll)
+{
+    std::vector<LootStoreItem> entries;
+    for (uint32 i = 0; i < 24; ++i)
+        entries.emplace_back(i, 0, i < 4 ? 100.0f : 50.0f / (i + 1), 0, 0, 1, 1);
+    for (uint32 i = 0; i < 4; ++i)
+        entries.emplace_back(24 + i, 0, -35.0f, 0, 0, 1, 1);                  // quest drops
+
+    while (state.KeepRunning())
+    {
+        uint32 dropped = 0;
+        for (LootStoreItem const& entry : entries)
+            if (entry.Roll(false))
+                ++dropped;
+        BenchDoNotOptimize(dropped);
+    }
+}
+
+namespace
+{
+    // a continent with fast respawns, every iteration frees the storage of a random spawn and allocates its replacement -
+    // only the object and its values array, constructors, Create, AI and motion master are not run
+    uint32 const RESPAWN_CREATURES      = 4000;
+    uint32 const RESPAWN_GAMEOBJECTS    = 1000;
+
+    struct SpawnStorage
+    {
+        void* object;
+        uint32* values;
+        bool creature;
+    };
+
+    size_t GetObjectSize(bool creature) { return creature ? sizeof(Creature) : sizeof(GameObject); }
+    size_t GetValuesSize(bool creature) { return (creature ? uint32(UNIT_END) : uint32(GAMEOBJECT_END)) * sizeof(uint32); }
+
+    struct HeapSpawnAllocation
+    {
+        static SpawnStorage Allocate(bool creature)
+        {
+            return { ::operator new(GetObjectSize(creature)), static_cast<uint32*>(::operator new(GetValuesSize(creature))), creature };
+        }
+
+        static void Free(SpawnStorage const& spawn)
+        {
+            ::operator delete(spawn.object);
+            ::operator delete(spawn.values);
+        }
+    };
+
+    // the class operators without running constructors, so no templates or map are needed
+    struct PooledSpawnAllocation
+    {
+        static SpawnStorage Allocate(bool creature)
+        {
+            void* object = creature ? Creature::operator new(sizeof(Creature)) : GameObject::operator new(sizeof(GameObject));
+            return { object, static_cast<uint32*>(BufferPool::Allocate(GetValuesSize(creature))), creature };
+        }
+
+        static void Free(SpawnStorage const& spawn)
+        {
+            if (spawn.creature)
+                Creature::operator delete(spawn.object, sizeof(Creature));
+            else
+                GameObject::operator delete(spawn.object, sizeof(GameObject));
+            BufferPool::Free(spawn.values, GetValuesSize(spawn.creature));
+        }
+    };
+
+    template <class Allocation>
+    size_t RunRespawnCycle(BenchState& state)
+    {
+        std::vector<SpawnStorage> spawns;
+        size_t objectBytes = 0;
+        for (uint32 i = 0; i < RESPAWN_CREATURES + RESPAWN_GAMEOBJECTS; ++i)
+        {
+            spawns.push_back(Allocation::Allocate(i < RESPAWN_CREATURES));
+            objectBytes += GetObjectSize(spawns.back().creature);
+        }
+
+        uint32 seed = 12345;
+        while (state.KeepRunning())
+        {
+            seed = seed * 1103515245 + 12345;
+            SpawnStorage& spawn = spawns[(seed >> 8) % spawns.size()];
+            Allocation::Free(spawn);
+            spawn = Allocation::Allocate(spawn.creature);
+
+            // first cache line of the object and the cleared values, as the constructor and _InitValues would touch them
+            memset(spawn.object, 0, 64);
+            memset(spawn.values, 0, GetValuesSize(spawn.creature));
+        }
+
+        for (SpawnStorage const& spawn : spawns)
+            Allocation::Free(spawn);
+
+        return objectBytes;
+    }
+}
+
+BENCHMARK(RespawnStorageAllocationHeap)
+{
+    size_t objectBytes = RunRespawnCycle<HeapSpawnAllocation>(state);
+    state.SetLabel(std::to_string(objectBytes / 1024) + " KB of objects");
+}
+
+BENCHMARK(RespawnStorageAllocationPooled)
+{
+    size_t objectBytes = RunRespawnCycle<PooledSpawnAllocation>(state);
+
+    uint64 slabBytes = 0;
+    for (uint32 i = 0; i < SlabAllocator::GetAllocatorCount(); ++i)
+    {
+        SlabAllocator const* slab = SlabAllocator::GetAllocator(i);
+        if (strcmp(slab->GetName(), "creature") == 0 || strcmp(slab->GetName(), "gameobject") == 0)
+            slabBytes += slab->GetStatistic().slabs * SLAB_SIZE;
+    }
+
+    state.SetLabel(std::to_string(objectBytes / 1024) + " KB of objects in " + std::to_string(slabBytes / 1024) + " KB of slabs");
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Finding the players to notify of a friend's status change, run on every login, logout and status change.
+*/
+
+#include "Util/CodeBench.h"
+#include "Social/SocialMgr.h"
+
+namespace
+{
+    uint32 const ONLINE_PLAYERS = 5000;
+
+    // the loaded social lists, keyed by player low guid as SocialMgr keeps them
+    typedef std::map<uint32, PlayerSocialMap> SocialLists;
+
+    // every player has up to SOCIALMGR_FRIEND_LIMIT friends and a few ignores, the lister index is filled from
+    // the friend flags the way SocialMgr::LoadFromDB fills it
+    void CreateSocialLists(SocialLists& lists, FriendListerMap& listers)
+    {
+        uint32 seed = 12345;
+        auto random = [&seed](uint32 range) { seed = seed * 1103515245 + 12345; return (seed >> 16) % range; };
+
+        for (uint32 player = 1; player <= ONLINE_PLAYERS; ++player)
+        {
+            PlayerSocialMap& social = lists[player];
+            for (uint32 friends = random(SOCIALMGR_FRIEND_LIMIT + 1); friends; --friends)
+                social[1 + random(ONLINE_PLAYERS)].Flags |= SOCIAL_FLAG_FRIEND;
+            for (uint32 ignores = random(4); ignores; --ignores)
+                social[1 + random(ONLINE_PLAYERS)].Flags |= SOCIAL_FLAG_IGNORED;
+
+            for (auto const& itr : social)
+                if (itr.second.Flags & SOCIAL_FLAG_FRIEND)
+                    listers[itr.first].insert(player);
+        }
+    }
+}
+
+// the scan BroadcastToFriendListers did before the index, one friend list lookup per online player
+BENCHMARK(FriendStatusBroadcastScan)
+{
+    SocialLists lists;
+    FriendListerMap listers;
+    CreateSocialLists(lists, listers);
+
+    uint32 broadcaster = 0, notified = 0;
+    while (state.KeepRunning())
+    {
+        broadcaster = broadcaster % ONLINE_PLAYERS + 1;
+        for (auto const& itr : lists)
+        {
+            PlayerSocialMap::const_iterator itr2 = itr.second.find(broadcaster);
+            if (itr2 != itr.second.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND))
+                notified += itr.first;
+        }
+        BenchDoNotOptimize(notified);
+    }
+}
+
+BENCHMARK(FriendStatusBroadcastIndex)
+{
+    SocialLists lists;
+    FriendListerMap listers;
+    CreateSocialLists(lists, listers);
+
+    uint32 broadcaster = 0, notified = 0;
+    while (state.KeepRunning())
+    {
+        broadcaster = broadcaster % ONLINE_PLAYERS + 1;
+        FriendListerMap::const_iterator itr = listers.find(broadcaster);
+        if (itr != listers.end())
+            for (uint32 listerGuid : itr->second)
+                notified += listerGuid;
+        BenchDoNotOptimize(notified);
+    }
+
+    uint64 entries = 0;
+    for (auto const& itr : listers)
+        entries += itr.second.size();
+    state.SetLabel(std::to_string(ONLINE_PLAYERS) + " players, " + std::to_string(entries) + " index entries");
+}
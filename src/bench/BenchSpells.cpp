@@ -0,0 +1,166 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup bench
+    Allocation of spells, aura holders and auras over a simulated raid fight.
+*/
+
+#include "Util/CodeBench.h"
+#include "Spells/Spell.h"
+#include "Spells/SpellAuras.h"
+
+#include <cstring>
+
+namespace
+{
+    uint32 const FIGHT_TICKS        = 600;                  // 30 seconds of 50 ms map ticks
+    uint32 const FIGHT_MAX_LIFETIME = 600;                  // ticks, longest aura
+    uint32 const FIGHT_WHEEL_SIZE   = 1024;
+
+    enum FightObjectType
+    {
+        FIGHT_SPELL,
+        FIGHT_HOLDER,
+        FIGHT_AURA,
+        FIGHT_AREA_AURA,
+    };
+
+    size_t const fightObjectSizes[] = { sizeof(Spell), sizeof(SpellAuraHolder), sizeof(Aura), sizeof(AreaAura) };
+
+    struct FightObject
+    {
+        void* ptr;
+        FightObjectType type;
+    };
+
+    typedef std::vector<std::vector<FightObject>> FightWheel;
+
+    struct HeapAllocation
+    {
+        static void* Allocate(FightObjectType type) { return ::operator new(fightObjectSizes[type]); }
+        static void Free(void* ptr, FightObjectType /*type*/) { ::operator delete(ptr); }
+    };
+
+    // the class operators without running constructors, so no caster or spell data is needed
+    struct SlabAllocation
+    {
+        static void* Allocate(FightObjectType type)
+        {
+            switch (type)
+            {
+                case FIGHT_SPELL:       return Spell::operator new(sizeof(Spell));
+                case FIGHT_HOLDER:      return SpellAuraHolder::operator new(sizeof(SpellAuraHolder));
+                case FIGHT_AURA:        return Aura::operator new(sizeof(Aura));
+                case FIGHT_AREA_AURA:   return Aura::operator new(sizeof(AreaAura));
+            }
+            return nullptr;
+        }
+
+        static void Free(void* ptr, FightObjectType type)
+        {
+            switch (type)
+            {
+                case FIGHT_SPELL:       Spell::operator delete(ptr, sizeof(Spell)); break;
+                case FIGHT_HOLDER:      SpellAuraHolder::operator delete(ptr, sizeof(SpellAuraHolder)); break;
+                case FIGHT_AURA:        Aura::operator delete(ptr, sizeof(Aura)); break;
+                case FIGHT_AREA_AURA:   Aura::operator delete(ptr, sizeof(AreaAura)); break;
+            }
+        }
+    };
+
+    // 25 players with procs and triggered spells: 8 spells and 6 aura applications per tick. Spells live for
+    // their cast and travel time, holders with one to three auras for 1 to 30 seconds. Expired objects are
+    // freed in one batch per tick, the way CleanupDeletedAuras frees them at the owner's next update.
+    template <class Allocation>
+    size_t SimulateRaidFight(FightWheel& wheel)
+    {
+        uint32 seed = 12345;
+        auto random = [&seed](uint32 range) { seed = seed * 1103515245 + 12345; return (seed >> 16) % range; };
+
+        size_t liveBytes = 0, peakBytes = 0;
+        auto create = [&](uint32 expires, FightObjectType type)
+        {
+            void* ptr = Allocation::Allocate(type);
+            memset(ptr, 0, 64);                             // first cache line, as the constructor would touch it
+            wheel[expires % FIGHT_WHEEL_SIZE].push_back({ ptr, type });
+            liveBytes += fightObjectSizes[type];
+            peakBytes = std::max(peakBytes, liveBytes);
+        };
+
+        for (uint32 tick = 0; tick < FIGHT_TICKS + FIGHT_MAX_LIFETIME; ++tick)
+        {
+            std::vector<FightObject>& expired = wheel[tick % FIGHT_WHEEL_SIZE];
+            for (FightObject const& object : expired)
+            {
+                Allocation::Free(object.ptr, object.type);
+                liveBytes -= fightObjectSizes[object.type];
+            }
+            expired.clear();
+
+            if (tick >= FIGHT_TICKS)
+                continue;
+
+            for (uint32 i = 0; i < 8; ++i)
+                create(tick + 1 + random(60), FIGHT_SPELL);
+
+            for (uint32 i = 0; i < 6; ++i)
+            {
+                uint32 expires = tick + 20 + random(FIGHT_MAX_LIFETIME - 20);
+                create(expires, FIGHT_HOLDER);
+                for (uint32 auras = 1 + random(3); auras; --auras)
+                    create(expires, random(8) ? FIGHT_AURA : FIGHT_AREA_AURA);
+            }
+        }
+
+        return peakBytes;
+    }
+
+    FightWheel CreateFightWheel()
+    {
+        FightWheel wheel(FIGHT_WHEEL_SIZE);
+        for (std::vector<FightObject>& slot : wheel)
+            slot.reserve(64);
+        return wheel;
+    }
+}
+
+BENCHMARK(RaidFightHeapAllocation)
+{
+    FightWheel wheel = CreateFightWheel();
+    size_t peakBytes = 0;
+    while (state.KeepRunning())
+        peakBytes = SimulateRaidFight<HeapAllocation>(wheel);
+
+    state.SetLabel("peak " + std::to_string(peakBytes / 1024) + " KB live");
+}
+
+BENCHMARK(RaidFightSlabAllocation)
+{
+    FightWheel wheel = CreateFightWheel();
+    size_t peakBytes = 0;
+    while (state.KeepRunning())
+        peakBytes = SimulateRaidFight<SlabAllocation>(wheel);
+
+    // what the slabs hold on to compared to what the fight needed at its peak
+    uint64 slabBytes = 0;
+    for (uint32 i = 0; i < SlabAllocator::GetAllocatorCount(); ++i)
+        slabBytes += SlabAllocator::GetAllocator(i)->GetStatistic().slabs * SLAB_SIZE;
+
+    state.SetLabel("peak " + std::to_string(peakBytes / 1024) + " KB live, " + std::to_string(slabBytes / 1024) + " KB in slabs");
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup bench Microbenchmarks
+/// @{
+/// \file
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Util/CodeBench.h"
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <string>
+
+// the game library expects the globals of the server executable
+DatabaseType WorldDatabase;
+DatabaseType CharacterDatabase;
+DatabaseType LoginDatabase;
+DatabaseType LogsDatabase;
+
+uint32 realmID;
+
+std::string g_benchDataDir;                                 ///< DataDir for benchmarks running on extracted client data
+
+/// Runs the registered benchmarks
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::string jsonFile;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("filter,f", boost::program_options::value<std::string>(&options.filter), "only run benchmarks containing this in their name")
+    ("repetitions,r", boost::program_options::value<uint32>(&options.repetitions)->default_value(10), "measured runs per benchmark")
+    ("min-time,t", boost::program_options::value<double>(&options.minTime)->default_value(0.1), "minimum seconds per run")
+    ("warmup,w", boost::program_options::value<double>(&options.warmupTime)->default_value(0.1), "seconds of unmeasured runs before measuring")
+    ("json,j", boost::program_options::value<std::string>(&jsonFile), "write the results as JSON to this file")
+    ("data,d", boost::program_options::value<std::string>(&g_benchDataDir), "DataDir with extracted maps/mmaps, benchmarks needing it are skipped without")
+    ("help,h", "prints usage");
+
+    try
+    {
+        boost::program_options::variables_map vm;
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+    }
+    catch (boost::program_options::error const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if (!g_benchDataDir.empty() && g_benchDataDir.back() != '/' && g_benchDataDir.back() != '\\')
+        g_benchDataDir.push_back('/');
+
+    std::vector<BenchResult> results = BenchRegistry::Run(options);
+    BenchRegistry::Print(results);
+
+    if (!jsonFile.empty() && !BenchRegistry::WriteJson(jsonFile, results))
+    {
+        std::cerr << "ERROR: could not write " << jsonFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @}
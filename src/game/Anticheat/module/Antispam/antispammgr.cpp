@@ -143,6 +143,12 @@ AntispamMgr::~AntispamMgr()
 {
     _shutdownRequested = true;
     _worker.join();
+
+    // the dispatcher is gone, so nothing else will touch the analysis workers
+    _analysisQueue.Cancel();
+
+    for (auto &w : _analysisWorkers)
+        w.join();
 }
 
 void AntispamMgr::WorkerLoop()
@@ -157,12 +163,26 @@ void AntispamMgr::WorkerLoop()
 
         if (sAnticheatConfig.EnableAntispam())
         {
+            // the pool is started here rather than in the constructor because the config is not loaded yet at that time
+            if (_analysisWorkers.empty())
+            {
+                auto const threads = std::max(1u, sAnticheatConfig.GetAntispamAnalysisThreads());
+
+                for (auto i = 0u; i < threads; ++i)
+                    _analysisWorkers.emplace_back(&AntispamMgr::AnalysisWorkerLoop, this);
+            }
+
             std::unordered_set<std::shared_ptr<Antispam> > workQueue;
 
-            // lock the mutex only long enough to move the work queue to a local container and expire old blacklist history
+            // lock the mutex only long enough to move the work queue to a local container
             {
-                std::lock_guard<std::mutex> guard(_mutex);
+                std::lock_guard<std::mutex> guard(_workQueueMutex);
                 workQueue = std::move(_workQueue);
+            }
+
+            // expire old blacklist history
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
 
                 for (auto i = _temporaryCache.begin(); i != _temporaryCache.end(); )
                 {
@@ -173,13 +193,18 @@ void AntispamMgr::WorkerLoop()
                 }
             }
 
+            // each session is queued at most once per tick, and Antispam::Analyze() locks the session itself
             for (auto const &s : workQueue)
-                s->Analyze();
+                _analysisQueue.Push(std::shared_ptr<Antispam>(s));
         }
         else
         {
+            {
+                std::lock_guard<std::mutex> guard(_workQueueMutex);
+                _workQueue.clear();
+            }
+
             std::lock_guard<std::mutex> guard(_mutex);
-            _workQueue.clear();
             _temporaryCache.clear();
         }
 
@@ -196,6 +221,38 @@ void AntispamMgr::WorkerLoop()
     }
 }
 
+void AntispamMgr::AnalysisWorkerLoop()
+{
+    while (!_shutdownRequested)
+    {
+        std::shared_ptr<Antispam> session;
+
+        // returns without a session once the queue has been cancelled
+        _analysisQueue.WaitAndPop(session);
+
+        if (session)
+            session->Analyze();
+    }
+}
+
+void AntispamMgr::CompileBlacklist()
+{
+    auto matcher = std::make_shared<BlacklistMatcher>();
+
+    matcher->entries = _blacklist;
+
+    for (size_t i = 0; i < _blacklist.size(); ++i)
+    {
+        matcher->original.add(_blacklist[i].first, i);
+        matcher->normalized.add(_blacklist[i].second, i);
+    }
+
+    matcher->original.build();
+    matcher->normalized.build();
+
+    _blacklistMatcher = std::move(matcher);
+}
+
 void AntispamMgr::LoadFromDB()
 {
     std::lock_guard<std::mutex> guard(_mutex);
@@ -232,6 +289,8 @@ void AntispamMgr::LoadFromDB()
             _blacklist.emplace_back(entry, normEntry);
         } while (queryResult->NextRow());
 
+    CompileBlacklist();
+
     sLog.outString(">> %lu blacklist entries loaded and normalized", uint64(_blacklist.size()));
 
     queryResult = LoginDatabase.Query("SELECT `from`, `to` FROM antispam_replacement");
@@ -303,56 +362,85 @@ void AntispamMgr::BlacklistAdd(const std::string &string_)
     LoginDatabase.CommitTransaction();
 
     _blacklist.emplace_back(entry, normEntry);
+
+    CompileBlacklist();
 }
 
 uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_ptr<const BlacklistMatcher> matcher;
+
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        matcher = _blacklistMatcher;
+    }
+
+    if (!matcher)
+        return 0;
 
+    // normalization does not touch anything guarded by the mutex, see the note on _asciiReplace
     auto const normalizationMask = sAnticheatConfig.GetSpamNormalizationMask();
     auto const msg = NormalizeStringInternal(string, normalizationMask);
 
-    std::stringstream logstr;
-    logstr << "Original message:\n" << string << "\nNormalized message:\n" << msg << "\nBlacklist violations:";
+    auto const &entries = matcher->entries;
+
+    // count non-overlapping occurrences of each entry, matching what repeated std::string::find would report.
+    // the automaton reports occurrences in order of their end position, so an occurrence is counted only
+    // when it starts at or after the end of the previous counted occurrence of the same entry.
+    std::vector<uint32> originalCount(entries.size(), 0), normalizedCount(entries.size(), 0);
+    std::vector<size_t> nextStart(entries.size(), 0);
+
+    matcher->original.match(string, [&](size_t id, size_t pos)
+    {
+        if (pos < nextStart[id])
+            return;
+
+        ++originalCount[id];
+        nextStart[id] = pos + entries[id].first.length();
+    });
+
+    std::fill(nextStart.begin(), nextStart.end(), 0);
+
+    matcher->normalized.match(msg, [&](size_t id, size_t pos)
+    {
+        if (pos < nextStart[id])
+            return;
+
+        ++normalizedCount[id];
+        nextStart[id] = pos + entries[id].second.length();
+    });
 
     uint32 result = 0;
 
-    // for each entry, search the given string for multiple occurrences of both the original and normalized form of the entry
-    for (auto const& entry : _blacklist)
+    for (size_t i = 0; i < entries.size(); ++i)
+        result += originalCount[i] + normalizedCount[i];
+
+    // if there were results found, save the log
+    if (!!result)
     {
-        // search the original string for the original blacklist entry
-        if (!entry.first.empty())
-        {
-            for (auto pos = string.find(entry.first); pos != std::string::npos; pos = string.find(entry.first, pos + entry.first.length()))
-            {
-                logstr << "\nOriginal: \"" << entry.first << "\"";
-                ++result;
-            }
-        }
+        std::stringstream logstr;
+        logstr << "Original message:\n" << string << "\nNormalized message:\n" << msg << "\nBlacklist violations:";
 
-        // search for the normalized blacklist entry
-        if (!entry.second.empty())
+        for (size_t i = 0; i < entries.size(); ++i)
         {
-            for (auto pos = msg.find(entry.second); pos != std::string::npos; pos = msg.find(entry.second, pos + entry.second.length()))
-            {
-                logstr << "\nNormalized: \"" << entry.second << "\"";
-                ++result;
-            }
+            for (auto j = 0u; j < originalCount[i]; ++j)
+                logstr << "\nOriginal: \"" << entries[i].first << "\"";
+
+            for (auto j = 0u; j < normalizedCount[i]; ++j)
+                logstr << "\nNormalized: \"" << entries[i].second << "\"";
         }
-    }
 
-    logstr << "\n";
+        logstr << "\n";
 
-    // if there were results found, save the log
-    if (!!result)
         log = logstr.str();
+    }
 
     return result;
 }
 
 void AntispamMgr::ScheduleAnalysis(std::shared_ptr<Antispam> session)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::mutex> guard(_workQueueMutex);
     _workQueue.insert(session);
 }
 
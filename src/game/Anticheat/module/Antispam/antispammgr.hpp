@@ -9,6 +9,9 @@
 #define __ANTISPAMMGR_HPP_
 
 #include "Policies/Singleton.h"
+#include "Util/ProducerConsumerQueue.h"
+
+#include "../ahocorasick.hpp"
 
 #include <atomic>
 #include <string>
@@ -29,6 +32,14 @@ class Antispam;
 class AntispamMgr
 {
     private:
+        // the blacklist compiled into one automaton per form, so that each message is scanned once regardless of blacklist size
+        struct BlacklistMatcher
+        {
+            std::vector<std::pair<std::string, std::string> > entries;
+            nam::aho_corasick original;
+            nam::aho_corasick normalized;
+        };
+
         // note that once we begin using c++17, std::shared_mutex will be much more performant
         // here as the guarded values are seldom changed but frequently read
         mutable std::mutex _mutex;
@@ -38,15 +49,25 @@ class AntispamMgr
         // this collection contains a pair of strings, the original entry and the normalized version based on current settings
         std::vector<std::pair<std::string, std::string> > _blacklist;
 
+        // immutable snapshot of _blacklist used by CheckBlacklist.  it is replaced, never modified, so that
+        // analysis workers only need the mutex long enough to copy the pointer
+        std::shared_ptr<const BlacklistMatcher> _blacklistMatcher;
+
         // NOTE: _asciiReplace and _unicodeReplace are not protected by _mutex, because it would make the code much more complicated
         // and they should never be changing once the world server has started.
 
         std::vector<std::pair<std::string, std::string> > _asciiReplace;        // replacements for ascii strings (for things like @ -> A or \/\/ -> W etc.)
         std::vector<std::pair<std::wstring, std::wstring> > _unicodeReplace;    // replacements for individual unicode characters
 
-        // set of sessions to analyze in the next tick of the antispam worker thread
+        // set of sessions to analyze in the next tick of the antispam worker thread.  this has its own mutex
+        // so that chat handlers never wait on blacklist or cache operations
+        std::mutex _workQueueMutex;
         std::unordered_set<std::shared_ptr<Antispam> > _workQueue;
 
+        // sessions handed out by the dispatcher thread to the analysis workers
+        ProducerConsumerQueue<std::shared_ptr<Antispam> > _analysisQueue;
+        std::vector<std::thread> _analysisWorkers;
+
         // temporarily cache antispam session information in case they reconnect and resume spamming
         std::unordered_map<uint32, std::pair<uint32, std::shared_ptr<Antispam> > > _temporaryCache;
 
@@ -56,7 +77,11 @@ class AntispamMgr
         // this function performs the actual normalization, but assumes that the mutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
+        // rebuilds _blacklistMatcher from _blacklist, assumes that the mutex is already locked
+        void CompileBlacklist();
+
         void WorkerLoop();
+        void AnalysisWorkerLoop();
 
     public:
         AntispamMgr();
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __AHOCORASICK_HPP_
+#define __AHOCORASICK_HPP_
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+
+namespace nam
+{
+// multi-pattern matcher.  all patterns are compiled into a single automaton so that a text
+// can be searched for every pattern in one pass, rather than one pass per pattern.
+class aho_corasick
+{
+    private:
+        struct node
+        {
+            // sorted by character so lookups can use binary search
+            std::vector<std::pair<unsigned char, uint32_t> > children;
+            uint32_t fail = 0;
+
+            // ids and lengths of the patterns which end at this node, including those reachable through failure links
+            std::vector<std::pair<size_t, size_t> > outputs;
+
+            int32_t child(unsigned char c) const
+            {
+                auto const i = std::lower_bound(children.begin(), children.end(), std::make_pair(c, uint32_t(0)));
+                return i != children.end() && i->first == c ? static_cast<int32_t>(i->second) : -1;
+            }
+        };
+
+        std::vector<node> _nodes;
+        size_t _patterns;
+
+    public:
+        aho_corasick() : _nodes(1), _patterns(0) {}
+
+        // adds a pattern identified by 'id'.  empty patterns are ignored.  build() must be called afterwards
+        void add(const std::string &pattern, size_t id)
+        {
+            if (pattern.empty())
+                return;
+
+            uint32_t current = 0;
+
+            for (auto const c : pattern)
+            {
+                auto const uc = static_cast<unsigned char>(c);
+                auto const next = _nodes[current].child(uc);
+
+                if (next >= 0)
+                {
+                    current = static_cast<uint32_t>(next);
+                    continue;
+                }
+
+                auto const created = static_cast<uint32_t>(_nodes.size());
+                auto &children = _nodes[current].children;
+                children.insert(std::upper_bound(children.begin(), children.end(), std::make_pair(uc, created)), std::make_pair(uc, created));
+                _nodes.emplace_back();
+                current = created;
+            }
+
+            _nodes[current].outputs.emplace_back(id, pattern.length());
+            ++_patterns;
+        }
+
+        // computes failure links breadth first and merges the outputs of each failure target into its source
+        void build()
+        {
+            std::queue<uint32_t> pending;
+
+            for (auto const &c : _nodes[0].children)
+            {
+                _nodes[c.second].fail = 0;
+                pending.push(c.second);
+            }
+
+            while (!pending.empty())
+            {
+                auto const current = pending.front();
+                pending.pop();
+
+                for (auto const &c : _nodes[current].children)
+                {
+                    auto fail = _nodes[current].fail;
+                    int32_t target;
+
+                    while ((target = _nodes[fail].child(c.first)) < 0 && fail != 0)
+                        fail = _nodes[fail].fail;
+
+                    _nodes[c.second].fail = target >= 0 && static_cast<uint32_t>(target) != c.second ? static_cast<uint32_t>(target) : 0;
+
+                    auto const &inherited = _nodes[_nodes[c.second].fail].outputs;
+                    _nodes[c.second].outputs.insert(_nodes[c.second].outputs.end(), inherited.begin(), inherited.end());
+
+                    pending.push(c.second);
+                }
+            }
+        }
+
+        size_t size() const { return _patterns; }
+        bool empty() const { return !_patterns; }
+
+        // invokes callback(id, position) for every occurrence of every pattern in 'text', where 'position'
+        // is the offset of the first character of the occurrence.  occurrences are reported in order of
+        // their end position, so overlapping occurrences of the same pattern are reported as well.
+        template <typename Callback>
+        void match(const std::string &text, Callback &&callback) const
+        {
+            uint32_t current = 0;
+
+            for (size_t i = 0; i < text.length(); ++i)
+            {
+                auto const uc = static_cast<unsigned char>(text[i]);
+                int32_t next;
+
+                while ((next = _nodes[current].child(uc)) < 0 && current != 0)
+                    current = _nodes[current].fail;
+
+                current = next >= 0 ? static_cast<uint32_t>(next) : 0;
+
+                for (auto const &o : _nodes[current].outputs)
+                    callback(o.first, i + 1 - o.second);
+            }
+        }
+};
+}
+
+#endif /* !__AHOCORASICK_HPP_ */
@@ -84,6 +84,7 @@ void AnticheatConfig::loadConfigSettings()
     setConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_LEVEL, "Antispam.MaxLevel", 25);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_NORMALIZE_MASK, "Antispam.NormalizeMask", 0);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_ANALYSIS_TIMER, "Antispam.AnalysisTimer", 30);
+    setConfig(CONFIG_UINT32_AC_ANTISPAM_ANALYSIS_THREADS, "Antispam.AnalysisThreads", 2);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_RATE, "Antispam.MaxRate", 30);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_RATE_GRACE_PERIOD, "Antispam.RateGracePeriod", 45);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_UNIQUE_PERCENTAGE, "Antispam.MaxUniquePercentage", 90);
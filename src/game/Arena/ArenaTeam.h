@@ -173,6 +173,7 @@ class ArenaTeam
         bool LoadMembersFromDB(QueryResult* arenaTeamMembersResult);
 
         void SaveToDB();
+        void SaveStatsToDB();                               // team row only, for use inside a caller's transaction
 
         void BroadcastPacket(WorldPacket const& packet) const;
 
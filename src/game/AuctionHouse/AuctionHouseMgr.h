@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Server/DBCStructure.h"
+#include "Util/MemoryTracker.h"
 
 class Item;
 class Player;
@@ -53,7 +54,7 @@ enum AuctionAction
     AUCTION_BID_PLACED  = 2                                 // ERR_AUCTION_BID_PLACED
 };
 
-struct AuctionEntry
+struct AuctionEntry : public MemoryTracked<MEMORY_TAG_AUCTIONS>
 {
     uint32 Id;
     uint32 itemGuidLow;                                     // can be 0 after send won mail with item
@@ -97,7 +98,8 @@ class AuctionHouseObject
                 delete itr->second;
         }
 
-        typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
+        typedef std::map<uint32, AuctionEntry*, std::less<uint32>,
+                MemoryTrackingAllocator<std::pair<const uint32, AuctionEntry*>, MEMORY_TAG_AUCTIONS> > AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
 
         uint32 GetCount() const { return AuctionsMap.size(); }
@@ -41,6 +41,10 @@
 
 #include "Policies/Singleton.h"
 
+#include <chrono>
+#include <future>
+#include <thread>
+
 INSTANTIATE_SINGLETON_1(BattleGroundMgr);
 
 /*********************************************************/
@@ -651,46 +655,119 @@ void BattleGroundMgr::DistributeArenaPoints() const
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_ONLINE_START);
 
-    // temporary structure for storing maximum points to add values for all players
-    std::map<uint32, uint32> PlayerPoints;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-    // at first update all points for all team members
+    std::vector<ArenaTeam*> teams;
     for (ObjectMgr::ArenaTeamMap::iterator team_itr = sObjectMgr.GetArenaTeamMapBegin(); team_itr != sObjectMgr.GetArenaTeamMapEnd(); ++team_itr)
-    {
         if (ArenaTeam* at = team_itr->second)
+            teams.push_back(at);
+
+    // at first compute points for all team members, teams are only read so chunks can run in parallel
+    std::map<uint32, uint32> PlayerPoints;
+    {
+        size_t const teamsPerTask = 256;
+        size_t taskCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), (teams.size() + teamsPerTask - 1) / teamsPerTask);
+
+        std::vector<std::future<std::map<uint32, uint32>>> futures;
+        for (size_t task = 1; task < taskCount; ++task)
+        {
+            futures.push_back(std::async(std::launch::async, [&teams, task, taskCount]()
+            {
+                std::map<uint32, uint32> points;
+                for (size_t i = task; i < teams.size(); i += taskCount)
+                    teams[i]->UpdateArenaPointsHelper(points);
+                return points;
+            }));
+        }
+
+        for (size_t i = 0; i < teams.size(); i += std::max<size_t>(taskCount, 1))
+            teams[i]->UpdateArenaPointsHelper(PlayerPoints);
+
+        // a player in several teams gets the highest points of any of them
+        for (auto& future : futures)
         {
-            at->UpdateArenaPointsHelper(PlayerPoints);
+            for (auto const& points : future.get())
+            {
+                uint32& current = PlayerPoints[points.first];
+                current = std::max(current, points.second);
+            }
         }
     }
 
-    // cycle that gives points to all players
-    for (auto& PlayerPoint : PlayerPoints)
+    uint32 computeTime = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+    // group players by amount so the update is a few multi-row statements instead of one per player
+    std::map<uint32, std::vector<uint32>> PlayersByPoints;
+    for (auto const& PlayerPoint : PlayerPoints)
+        if (PlayerPoint.second)
+            PlayersByPoints[PlayerPoint.second].push_back(PlayerPoint.first);
+
+    CharacterDatabase.BeginTransaction();
+
+    size_t const guidsPerStatement = 1000;
+    for (auto const& PointGroup : PlayersByPoints)
     {
-        // update to database
-        CharacterDatabase.PExecute("UPDATE characters SET arenaPoints = arenaPoints + '%u' WHERE guid = '%u'", PlayerPoint.second, PlayerPoint.first);
-        // add points if player is online
-        if (Player* pl = sObjectMgr.GetPlayer(ObjectGuid(HIGHGUID_PLAYER, PlayerPoint.first)))
-            pl->ModifyArenaPoints(PlayerPoint.second);
+        for (size_t first = 0; first < PointGroup.second.size(); first += guidsPerStatement)
+        {
+            std::ostringstream guids;
+            size_t last = std::min(first + guidsPerStatement, PointGroup.second.size());
+            for (size_t i = first; i < last; ++i)
+                guids << (i != first ? "," : "") << PointGroup.second[i];
+
+            CharacterDatabase.PExecute("UPDATE characters SET arenaPoints = arenaPoints + '%u' WHERE guid IN (%s)", PointGroup.first, guids.str().c_str());
+        }
     }
 
-    PlayerPoints.clear();
+    // add points to online players on the thread of the map they are in
+    for (auto const& PlayerPoint : PlayerPoints)
+    {
+        if (!PlayerPoint.second)
+            continue;
+
+        Player* pl = sObjectMgr.GetPlayer(ObjectGuid(HIGHGUID_PLAYER, PlayerPoint.first));
+        if (!pl)
+            continue;
+
+        ObjectGuid guid = pl->GetObjectGuid();
+        uint32 points = PlayerPoint.second;
+        pl->GetMap()->GetMessager().AddMessage([guid, points](Map* map)
+        {
+            if (Player* player = map->GetPlayer(guid))
+                player->ModifyArenaPoints(points);
+            else                                            // left the map before the message ran
+            {
+                sWorld.GetMessager().AddMessage([guid, points](World* /*world*/)
+                {
+                    if (Player* player = sObjectMgr.GetPlayer(guid, false))
+                        player->ModifyArenaPoints(points);
+                });
+            }
+        });
+    }
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_ONLINE_END);
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_TEAM_START);
-    for (ObjectMgr::ArenaTeamMap::iterator titr = sObjectMgr.GetArenaTeamMapBegin(); titr != sObjectMgr.GetArenaTeamMapEnd(); ++titr)
+
+    // member ratings are saved after every match, so only the weekly counters need resetting per member
+    CharacterDatabase.Execute("UPDATE arena_team_member SET played_week = 0, wons_week = 0");
+    for (ArenaTeam* at : teams)
     {
-        if (ArenaTeam* at = titr->second)
-        {
-            at->FinishWeek();                              // set played this week etc values to 0 in memory, too
-            at->SaveToDB();                                // save changes
-            at->NotifyStatsChanged();                      // notify the players of the changes
-        }
+        at->FinishWeek();                                  // set played this week etc values to 0 in memory, too
+        at->SaveStatsToDB();                               // save changes
     }
 
+    CharacterDatabase.CommitTransaction();
+
+    for (ArenaTeam* at : teams)
+        at->NotifyStatsChanged();                          // notify the players of the changes
+
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_TEAM_END);
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_END);
+
+    sLog.outString("Arena points distributed to %u players of %u teams in %u ms (%u ms computing points)", uint32(PlayerPoints.size()), uint32(teams.size()),
+                   uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()), computeTime);
 }
 
 /**
@@ -1348,6 +1425,17 @@ uint32 BattleGroundMgr::GetMinLevelForBattleGroundBracketId(BattleGroundBracketI
     return 10 * bracket_id + bg->GetMinLevel();
 }
 
+/**
+  Function returns the map spawn mode of a battleground of the given type and bracket
+*/
+uint8 BattleGroundMgr::GetBattleGroundSpawnMode(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId) const
+{
+    if (bgTypeId == BATTLEGROUND_AV && GetMinLevelForBattleGroundBracketId(bracketId, bgTypeId) >= 61)
+        return uint8(DUNGEON_DIFFICULTY_HEROIC);
+
+    return uint8(DUNGEON_DIFFICULTY_NORMAL);
+}
+
 uint32 BattleGroundMgr::GetMaxLevelForBattleGroundBracketId(BattleGroundBracketId bracket_id, BattleGroundTypeId bgTypeId) const
 {
     if (bracket_id >= BG_BRACKET_ID_LAST)
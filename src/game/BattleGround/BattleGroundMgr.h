@@ -132,6 +132,7 @@ class BattleGroundMgr
         std::set<uint32> const& GetUsedRefLootIds() const { return m_usedRefloot; }
 
         uint32 GetMinLevelForBattleGroundBracketId(BattleGroundBracketId bracket_id, BattleGroundTypeId bgTypeId) const;
+        uint8 GetBattleGroundSpawnMode(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId) const;
         uint32 GetMaxLevelForBattleGroundBracketId(BattleGroundBracketId bracket_id, BattleGroundTypeId bgTypeId) const;
         BattleGroundBracketId GetBattleGroundBracketIdFromLevel(BattleGroundTypeId bgTypeId, uint32 playerLevel) const;
 
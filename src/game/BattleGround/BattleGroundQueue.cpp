@@ -26,7 +26,7 @@
  /***            BATTLEGROUND QUEUE SYSTEM              ***/
  /*********************************************************/
 
-BattleGroundQueueItem::BattleGroundQueueItem()
+BattleGroundQueueItem::BattleGroundQueueItem() : m_statQueuedGroups(0), m_statUpdates(0), m_statUpdateTime(0), m_statInvitedGroups(0), m_statInvitedWaitTime(0)
 {
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
@@ -136,6 +136,91 @@ bool BattleGroundQueueItem::SelectionPool::AddGroup(GroupQueueInfo* queueInfo, u
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
 
+/**
+  Method that stores a group at the end (or front) of a queue and, for rated arena teams, in its rating bucket
+
+  @param    group queue info
+  @param    queue index (BG_QUEUE_*)
+  @param    insert at the front
+*/
+void BattleGroundQueueItem::AddToQueue(GroupQueueInfo* groupInfo, uint32 index, bool front)
+{
+    GroupsQueueType& queued = m_queuedGroups[groupInfo->bgBracketId][index];
+    groupInfo->queueIndex = index;
+    groupInfo->queuePos = queued.insert(front ? queued.begin() : queued.end(), groupInfo);
+
+    // rated arena teams are always queued as premade
+    if (groupInfo->isRated && index < BG_QUEUE_NORMAL_ALLIANCE)
+    {
+        GroupsQueueType& bucket = m_ratedGroups[groupInfo->bgBracketId][index][groupInfo->arenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE];
+        groupInfo->ratingPos = bucket.insert(front ? bucket.begin() : bucket.end(), groupInfo);
+    }
+}
+
+/**
+  Method that unlinks a group from its queue and rating bucket, the group itself is not deleted
+
+  @param    group queue info
+*/
+void BattleGroundQueueItem::RemoveFromQueue(GroupQueueInfo* groupInfo)
+{
+    m_queuedGroups[groupInfo->bgBracketId][groupInfo->queueIndex].erase(groupInfo->queuePos);
+
+    if (groupInfo->isRated && groupInfo->queueIndex < BG_QUEUE_NORMAL_ALLIANCE)
+    {
+        RatingBucketMap& buckets = m_ratedGroups[groupInfo->bgBracketId][groupInfo->queueIndex];
+        RatingBucketMap::iterator itr = buckets.find(groupInfo->arenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE);
+        itr->second.erase(groupInfo->ratingPos);
+        if (itr->second.empty())
+            buckets.erase(itr);
+    }
+}
+
+/**
+  Method that returns the not yet invited rated arena team which joined first and either has its rating
+  in [minRating, maxRating] or joined before discardTime - only the buckets in the rating window are searched
+
+  @param    bracket id
+  @param    queue index (BG_QUEUE_PREMADE_*)
+  @param    min rating
+  @param    max rating
+  @param    discard time
+  @param    group to skip
+*/
+GroupQueueInfo* BattleGroundQueueItem::SelectRatedGroup(BattleGroundBracketId bracketId, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude)
+{
+    // the queue is kept in join order, so only its first waiting team can have joined before discardTime
+    for (GroupQueueInfo* groupInfo : m_queuedGroups[bracketId][index])
+    {
+        if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude)
+            continue;
+
+        if (groupInfo->joinTime < discardTime)
+            return groupInfo;
+
+        break;
+    }
+
+    // first waiting team of every bucket in range, keep the one waiting longest
+    uint32 now = WorldTimer::getMSTime();
+    GroupQueueInfo* selected = nullptr;
+    RatingBucketMap& buckets = m_ratedGroups[bracketId][index];
+    for (RatingBucketMap::iterator itr = buckets.lower_bound(minRating / BG_QUEUE_RATING_BUCKET_SIZE); itr != buckets.end() && itr->first <= maxRating / BG_QUEUE_RATING_BUCKET_SIZE; ++itr)
+    {
+        for (GroupQueueInfo* groupInfo : itr->second)
+        {
+            if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude || groupInfo->arenaTeamRating < minRating || groupInfo->arenaTeamRating > maxRating)
+                continue;
+
+            if (!selected || WorldTimer::getMSTimeDiff(groupInfo->joinTime, now) > WorldTimer::getMSTimeDiff(selected->joinTime, now))
+                selected = groupInfo;
+            break;
+        }
+    }
+
+    return selected;
+}
+
 /**
   Function that adds group or player (grp == nullptr) to battleground queue with the given leader and specifications
 
@@ -210,7 +295,8 @@ GroupQueueInfo* BattleGroundQueueItem::AddGroup(ObjectGuid leader, AddGroupToQue
         }
 
         // add GroupInfo to m_QueuedGroups
-        m_queuedGroups[bracketId][index].push_back(queueInfo);
+        AddToQueue(queueInfo, index);
+        ++m_statQueuedGroups;
 
         // announce to world, this code needs mutex
         if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -331,8 +417,6 @@ uint32 BattleGroundQueueItem::GetAverageQueueWaitTime(GroupQueueInfo* queueInfo,
 */
 void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid guid, bool decreaseInvitedCount)
 {
-    int32 bracketId = -1;                                   // signed for proper for-loop finish
-
     // remove player from map, if he's there
     QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
     if (itr == m_queuedPlayers.end())
@@ -341,40 +425,9 @@ void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid gu
         return;
     }
 
+    // the group keeps its own queue position, no need to search the brackets for it
     GroupQueueInfo* group = itr->second.groupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = GetTeamIndexByTeamId(group->groupTeam);
-
-    for (int8 bracketIdTmp = MAX_BATTLEGROUND_BRACKETS - 1; bracketIdTmp >= 0 && bracketId == -1; --bracketIdTmp)
-    {
-        // we must check premade and normal team's queue - because when players from premade are joining bg,
-        // they leave groupinfo so we can't use its players size to find out index
-        for (uint8 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (GroupsQueueType::iterator group_itr_tmp = m_queuedGroups[bracketIdTmp][j].begin(); group_itr_tmp != m_queuedGroups[bracketIdTmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracketId = bracketIdTmp;
-                    group_itr = group_itr_tmp;
-                    // we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-
-    // player can't be in queue without group, but just in case
-    if (bracketId == -1)
-    {
-        sLog.outError("BattleGroundQueueItem: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
-        return;
-    }
-    DEBUG_LOG("BattleGroundQueueItem: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)bracketId);
+    DEBUG_LOG("BattleGroundQueueItem: Removing %s, from bracket_id %u", guid.GetString().c_str(), uint32(group->bgBracketId));
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -423,7 +476,8 @@ void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid gu
     // remove group queue info if needed
     if (group->players.empty())
     {
-        m_queuedGroups[bracketId][index].erase(group_itr);
+        RemoveFromQueue(group);
+        --m_statQueuedGroups;
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -514,6 +568,10 @@ bool BattleGroundQueueItem::InviteGroupToBg(GroupQueueInfo* groupInfo, BattleGro
 
         groupInfo->removeInviteTime = WorldTimer::getMSTime() + INVITE_ACCEPT_WAIT_TIME;
 
+        // time to match, for .bg queuestats
+        ++m_statInvitedGroups;
+        m_statInvitedWaitTime += WorldTimer::getMSTimeDiff(groupInfo->joinTime, WorldTimer::getMSTime());
+
         // loop through the players
         for (auto itr = groupInfo->players.begin(); itr != groupInfo->players.end(); ++itr)
         {
@@ -702,8 +760,9 @@ bool BattleGroundQueueItem::CheckPremadeMatch(BattleGroundBracketId bracketId, u
             if (!(*itr)->isInvitedToBgInstanceGuid && ((*itr)->joinTime < time_before || (*itr)->players.size() < minPlayersPerTeam))
             {
                 // we must insert group to normal queue and erase pointer from premade queue
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                GroupQueueInfo* groupInfo = *itr;
+                RemoveFromQueue(groupInfo);
+                AddToQueue(groupInfo, BG_QUEUE_NORMAL_ALLIANCE + i, true);
             }
         }
     }
@@ -793,14 +852,11 @@ bool BattleGroundQueueItem::CheckSkirmishForSameFaction(BattleGroundBracketId br
     // store last ginfo pointer
     GroupQueueInfo* ginfo = m_selectionPools[teamIdx].selectedGroups.back();
     // set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].begin();
-    for (; itr_team != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-
-    if (itr_team == m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end())
+    if (ginfo->queueIndex != uint32(BG_QUEUE_NORMAL_ALLIANCE + teamIdx))
         return false;
 
+    GroupsQueueType::iterator itr_team = ginfo->queuePos;
+
     GroupsQueueType::iterator itr_team2 = itr_team;
     ++itr_team2;
     // invite players to other selection pool
@@ -820,20 +876,9 @@ bool BattleGroundQueueItem::CheckSkirmishForSameFaction(BattleGroundBracketId br
         // set correct team
         (*itr)->groupTeam = otherTeamId;
 
-        // add team to other queue
-        m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx].push_front(*itr);
-
-        // remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].erase(itr2);
-                break;
-            }
-        }
+        // move team from old queue to other queue
+        RemoveFromQueue(*itr);
+        AddToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx, true);
     }
     return true;
 }
@@ -974,7 +1019,7 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
             BattleGroundInQueueInfo bgInfo;
             bgInfo.Fill(bgTemplate);
             bgInfo.bracketId = bracketId;
-            bgInfo.instanceId = sMapMgr.GenerateInstanceId();
+            bgInfo.instanceId = sMapMgr.ReserveBattleGroundInstanceId(bgTemplate->GetMapId(), sBattleGroundMgr.GetBattleGroundSpawnMode(bgTypeId, bracketId));
             bgInfo.m_clientInstanceId = queue.CreateClientVisibleInstanceId(bgTypeId, bracketId);
 
             // invite those selection pools
@@ -1025,7 +1070,7 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
             BattleGroundInQueueInfo bgInfo;
             bgInfo.Fill(bgTemplate);
             bgInfo.bracketId = bracketId;
-            bgInfo.instanceId = sMapMgr.GenerateInstanceId();
+            bgInfo.instanceId = sMapMgr.ReserveBattleGroundInstanceId(bgTemplate->GetMapId(), sBattleGroundMgr.GetBattleGroundSpawnMode(bgTypeId, bracketId));
             bgInfo.m_clientInstanceId = queue.CreateClientVisibleInstanceId(bgTypeId, bracketId);
 
             // invite those selection pools
@@ -1088,63 +1133,32 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
 
         // we need to find 2 teams which will play next game
 
-        GroupsQueueType::iterator itr_team[PVP_TEAM_COUNT];
+        GroupQueueInfo* selectedGroups[PVP_TEAM_COUNT];
 
         // optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
         {
-            // take the group that joined first
-            itr_team[i] = m_queuedGroups[bracketId][i].begin();
-            for (; itr_team[i] != m_queuedGroups[bracketId][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if (!(*itr_team[i])->isInvitedToBgInstanceGuid
-                    && (((*itr_team[i])->arenaTeamRating >= arenaMinRating && (*itr_team[i])->arenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[i])->joinTime < discardTime))
-                {
-                    m_selectionPools[i].AddGroup((*itr_team[i]), maxPlayersPerTeam, 0);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
+            // take the matching group that joined first
+            selectedGroups[i] = SelectRatedGroup(bracketId, i, arenaMinRating, arenaMaxRating, discardTime);
+            if (selectedGroups[i])
+                m_selectionPools[i].AddGroup(selectedGroups[i], maxPlayersPerTeam, 0);
         }
         // now we are done if we have 2 groups - ali vs horde!
         // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
+        // continue search for matching group in HORDE queue
         if (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_ALLIANCE] = itr_team[TEAM_INDEX_HORDE];
-            ++itr_team[TEAM_INDEX_ALLIANCE];
-
-            for (; itr_team[TEAM_INDEX_ALLIANCE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[TEAM_INDEX_ALLIANCE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_ALLIANCE])->isInvitedToBgInstanceGuid
-                    && (((*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[TEAM_INDEX_ALLIANCE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*itr_team[TEAM_INDEX_ALLIANCE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+            selectedGroups[TEAM_INDEX_ALLIANCE] = SelectRatedGroup(bracketId, BG_QUEUE_PREMADE_HORDE, arenaMinRating, arenaMaxRating, discardTime, selectedGroups[TEAM_INDEX_HORDE]);
+            if (selectedGroups[TEAM_INDEX_ALLIANCE])
+                m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup(selectedGroups[TEAM_INDEX_ALLIANCE], maxPlayersPerTeam, 0);
         }
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
+        // continue search for matching group in ALLIANCE queue
         if (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_HORDE] = itr_team[TEAM_INDEX_ALLIANCE];
-            ++itr_team[TEAM_INDEX_HORDE];
-
-            for (; itr_team[TEAM_INDEX_HORDE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[TEAM_INDEX_HORDE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_HORDE])->isInvitedToBgInstanceGuid
-                    && (((*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[TEAM_INDEX_HORDE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*itr_team[TEAM_INDEX_HORDE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+            selectedGroups[TEAM_INDEX_HORDE] = SelectRatedGroup(bracketId, BG_QUEUE_PREMADE_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, selectedGroups[TEAM_INDEX_ALLIANCE]);
+            if (selectedGroups[TEAM_INDEX_HORDE])
+                m_selectionPools[TEAM_INDEX_HORDE].AddGroup(selectedGroups[TEAM_INDEX_HORDE], maxPlayersPerTeam, 0);
         }
 
         // if we have 2 teams, then start new arena and invite players!
@@ -1167,13 +1181,13 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
             BattleGroundInQueueInfo bgInfo;
             bgInfo.Fill(bgTemplate);
             bgInfo.bracketId = bracketId;
-            bgInfo.instanceId = sMapMgr.GenerateInstanceId();
+            bgInfo.instanceId = sMapMgr.ReserveBattleGroundInstanceId(bgTemplate->GetMapId(), sBattleGroundMgr.GetBattleGroundSpawnMode(bgTypeId, bracketId));
             bgInfo.m_clientInstanceId = queue.CreateClientVisibleInstanceId(bgTypeId, bracketId);
             bgInfo.isRated = true;
             bgInfo.arenaType = arenaType;
 
-            GroupQueueInfo* firstGroup = *(itr_team[TEAM_INDEX_ALLIANCE]);
-            GroupQueueInfo* secondGroup = *(itr_team[TEAM_INDEX_HORDE]);
+            GroupQueueInfo* firstGroup = selectedGroups[TEAM_INDEX_ALLIANCE];
+            GroupQueueInfo* secondGroup = selectedGroups[TEAM_INDEX_HORDE];
 
             firstGroup->opponentsTeamRating = secondGroup->arenaTeamRating;
             DEBUG_LOG("Setting oposite teamrating for team %u to %u", firstGroup->arenaTeamId, firstGroup->opponentsTeamRating);
@@ -1183,18 +1197,15 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (firstGroup->groupTeam != ALLIANCE)
             {
-                // add to alliance queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].push_front(firstGroup);
-                // erase from horde queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].erase(itr_team[TEAM_INDEX_ALLIANCE]);
-                itr_team[TEAM_INDEX_ALLIANCE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].begin();
+                // erase from horde queue and add to alliance queue
+                RemoveFromQueue(firstGroup);
+                AddToQueue(firstGroup, BG_QUEUE_PREMADE_ALLIANCE, true);
             }
 
             if (secondGroup->groupTeam != HORDE)
             {
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].push_front(secondGroup);
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[TEAM_INDEX_HORDE]);
-                itr_team[TEAM_INDEX_HORDE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].begin();
+                RemoveFromQueue(secondGroup);
+                AddToQueue(secondGroup, BG_QUEUE_PREMADE_HORDE, true);
             }
 
             InviteGroupToBg(firstGroup, bgInfo, ALLIANCE);
@@ -1386,7 +1397,7 @@ void BattleGroundQueue::Update()
                 BattleGroundTypeId bgTypeId = BattleGroundTypeId((i >> 8) & 255);
                 BattleGroundBracketId bracket_id = BattleGroundBracketId(i & 255);
 
-                m_battleGroundQueues[bgQueueTypeId].Update(*this, bgTypeId, bracket_id, arenaType, arenaRating > 0, arenaRating);
+                UpdateQueueItem(bgQueueTypeId, bgTypeId, bracket_id, arenaType, arenaRating > 0, arenaRating);
             }
         }
 
@@ -1398,9 +1409,9 @@ void BattleGroundQueue::Update()
             {
                 // forced update for level 70 rated arenas
                 DEBUG_LOG("BattleGroundMgr: UPDATING ARENA QUEUES");
-                m_battleGroundQueues[BATTLEGROUND_QUEUE_2v2].Update(*this, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_2v2, true, 0);
-                m_battleGroundQueues[BATTLEGROUND_QUEUE_3v3].Update(*this, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_3v3, true, 0);
-                m_battleGroundQueues[BATTLEGROUND_QUEUE_5v5].Update(*this, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_5v5, true, 0);
+                UpdateQueueItem(BATTLEGROUND_QUEUE_2v2, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_2v2, true, 0);
+                UpdateQueueItem(BATTLEGROUND_QUEUE_3v3, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_3v3, true, 0);
+                UpdateQueueItem(BATTLEGROUND_QUEUE_5v5, BATTLEGROUND_AA, BG_BRACKET_ID_FIRST, ARENA_TYPE_5v5, true, 0);
 
                 m_nextRatingDiscardUpdate = now + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER));
             }
@@ -1420,10 +1431,22 @@ void BattleGroundQueue::Update()
             }
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // matching is driven by queue events - sleep until the next message arrives or a timed check is due,
+        // but wake up at least once per second to notice world shutdown
+        std::chrono::milliseconds timeout(1000);
+        if (sWorld.getConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE) && sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER))
+            timeout = std::max(std::chrono::milliseconds(0), std::min(timeout, std::chrono::duration_cast<std::chrono::milliseconds>(m_nextRatingDiscardUpdate - now)));
+        GetMessager().WaitForMessages(timeout);
     };
 }
 
+void BattleGroundQueue::UpdateQueueItem(BattleGroundQueueTypeId bgQueueTypeId, BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId, ArenaType arenaType, bool isRated, uint32 arenaRating)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    m_battleGroundQueues[bgQueueTypeId].Update(*this, bgTypeId, bracketId, arenaType, isRated, arenaRating);
+    m_battleGroundQueues[bgQueueTypeId].AddUpdateTime(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 void BattleGroundQueue::InitAutomaticArenaPointDistribution()
 {
     if (sWorld.getConfig(CONFIG_BOOL_ARENA_AUTO_DISTRIBUTE_POINTS))
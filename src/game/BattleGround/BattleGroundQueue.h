@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "BattleGround/BattleGround.h"
 
+#include <atomic>
+
 struct GroupQueueInfo;                                      // type predefinition
 struct PlayerQueueInfo                                      // stores information for players in queue
 {
@@ -56,8 +58,13 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  desiredInstanceId;                              // queued for this instance specifically
     uint32  arenaTeamRating;                                // if rated match, inited to the rating of the team
     uint32  opponentsTeamRating;                            // for rated arena matches
+    uint32  queueIndex;                                     // BG_QUEUE_* list the group is stored in
+    std::list<GroupQueueInfo*>::iterator queuePos;          // position in that list, for constant time removal
+    std::list<GroupQueueInfo*>::iterator ratingPos;         // position in the rating bucket, rated arena teams only
 };
 
+#define BG_QUEUE_RATING_BUCKET_SIZE 100                     // width of the rating buckets rated arena teams are indexed by
+
 struct BattleGroundInQueueInfo
 {
     BattleGroundTypeId bgTypeId;
@@ -143,6 +150,14 @@ class BattleGroundQueueItem
         void PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
         uint32 GetAverageQueueWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
 
+        // matching statistics, updated by the queue thread and read by .bg queuestats
+        void AddUpdateTime(uint64 micros) { ++m_statUpdates; m_statUpdateTime += micros; }
+        uint32 GetQueuedGroupCount() const { return m_statQueuedGroups; }
+        uint64 GetUpdateCount() const { return m_statUpdates; }
+        uint64 GetUpdateTime() const { return m_statUpdateTime; }
+        uint64 GetInvitedGroupCount() const { return m_statInvitedGroups; }
+        uint64 GetInvitedWaitTime() const { return m_statInvitedWaitTime; }
+
     private:
         typedef std::map<ObjectGuid, PlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_queuedPlayers;
@@ -161,6 +176,15 @@ class BattleGroundQueueItem
         */
         GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // rated arena teams from the premade queues, keyed by arenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE
+        // every bucket keeps join order, so the rating window can be searched without walking the whole queue
+        typedef std::map<uint32, GroupsQueueType> RatingBucketMap;
+        RatingBucketMap m_ratedGroups[MAX_BATTLEGROUND_BRACKETS][PVP_TEAM_COUNT];
+
+        void AddToQueue(GroupQueueInfo* groupInfo, uint32 index, bool front = false);
+        void RemoveFromQueue(GroupQueueInfo* groupInfo);
+        GroupQueueInfo* SelectRatedGroup(BattleGroundBracketId bracketId, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude = nullptr);
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -183,6 +207,12 @@ class BattleGroundQueueItem
         uint32 m_waitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_waitTimeLastPlayer[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_sumOfWaitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
+
+        std::atomic<uint32> m_statQueuedGroups;
+        std::atomic<uint64> m_statUpdates;
+        std::atomic<uint64> m_statUpdateTime;
+        std::atomic<uint64> m_statInvitedGroups;
+        std::atomic<uint64> m_statInvitedWaitTime;
 };
 
 /*
@@ -273,6 +303,8 @@ class BattleGroundQueue
 
         void BuildBattleGroundListPacket(WorldPacket& data, ObjectGuid guid, uint32 playerLevel, BattleGroundTypeId bgTypeId) const;
     private:
+        void UpdateQueueItem(BattleGroundQueueTypeId bgQueueTypeId, BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId, ArenaType arenaType, bool isRated, uint32 arenaRating);
+
         BattleGroundQueueItem m_battleGroundQueues[MAX_BATTLEGROUND_QUEUE_TYPES];
 
         BgFreeSlotQueueType m_bgFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID];
@@ -118,9 +118,7 @@ void Channel::Join(Player* player, const char* password)
 
     data.clear();
 
-    PlayerInfo& pinfo = m_players[guid];
-    pinfo.player = guid;
-    pinfo.flags = MEMBER_FLAG_NONE;
+    AddPlayerInfo(player);
 
     MakeYouJoined(data, m_name, *this);
     SendToOne(data, guid);
@@ -160,9 +158,9 @@ void Channel::Leave(Player* player, bool send)
         data.clear();
     }
 
-    bool changeowner = m_players[guid].IsOwner();
+    bool changeowner = GetPlayerInfo(guid)->IsOwner();
 
-    m_players.erase(guid);
+    RemovePlayerInfo(guid);
 
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_SILENT_JOIN);
     const bool silent = (level && player->GetSession()->GetSecurity() >= level);
@@ -195,7 +193,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -243,7 +241,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
         MakePlayerKicked(data, m_name, targetGuid, guid);
 
     SendToAll(data);
-    m_players.erase(targetGuid);
+    RemovePlayerInfo(targetGuid);
     target->LeftChannel(this);
 
     if (changeowner && !IsPublic())
@@ -265,7 +263,7 @@ void Channel::UnBan(Player* player, const char* targetName)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -314,7 +312,7 @@ void Channel::SetPassword(Player* player, const char* password)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -351,7 +349,7 @@ void Channel::SetModeFlags(Player* player, const char* targetName, ChannelMember
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -519,15 +517,16 @@ void Channel::SendChannelListResponse(Player* player, bool display/*= false*/)
     uint32 count = 0;
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
     {
-        if (Player* member = sObjectMgr.GetPlayer(i->first))
-        {
-            if (visibilityCheck && (member->GetSession()->GetSecurity() > visibilityThreshold || !member->IsVisibleGloballyFor(player)))
-                continue;
+        Player* member = i->plr;
+        if (!member->IsInWorld())
+            continue;
 
-            data << ObjectGuid(i->first);
-            data << uint8(i->second.flags);                 // flags seems to be changed...
-            ++count;
-        }
+        if (visibilityCheck && (member->GetSession()->GetSecurity() > visibilityThreshold || !member->IsVisibleGloballyFor(player)))
+            continue;
+
+        data << ObjectGuid(i->player);
+        data << uint8(i->flags);                            // flags seems to be changed...
+        ++count;
     }
 
     data.put<uint32>(countpos, count);
@@ -550,7 +549,7 @@ void Channel::ToggleAnnouncements(Player* player)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -585,7 +584,7 @@ void Channel::ToggleModeration(Player* player)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!GetPlayerInfo(guid)->IsModerator() && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -620,7 +619,7 @@ void Channel::Say(Player* player, const char* text, uint32 lang)
         return;
     }
 
-    if (m_players[guid].IsMuted())
+    if (GetPlayerInfo(guid)->IsMuted())
     {
         WorldPacket data;
         MakeMuted(data, m_name);
@@ -628,7 +627,7 @@ void Channel::Say(Player* player, const char* text, uint32 lang)
         return;
     }
 
-    const bool moderator = m_players[guid].IsModerator();
+    const bool moderator = GetPlayerInfo(guid)->IsModerator();
 
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
@@ -673,7 +672,10 @@ void Channel::Say(Player* player, const char* text, uint32 lang)
     if (silenced)
         player->GetSession()->SendPacket(data);
     else
+    {
+        CountMessage();
         SendMessage(data, (moderator ? ObjectGuid() : guid));
+    }
 }
 
 void Channel::Invite(Player* player, const char* targetName)
@@ -746,16 +748,78 @@ void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
+    // the packet is built once by the caller, members are visited in storage order without any guid lookups
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+        if (i->plr->IsInWorld())
+            i->plr->GetSession()->SendPacket(data);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+        if (i->plr->IsInWorld())
+            if (!sender || !i->plr->GetSocial()->HasIgnore(sender))
+                i->plr->GetSession()->SendPacket(data);
+}
+
+void Channel::AddPlayerInfo(Player* player)
+{
+    PlayerInfo pinfo;
+    pinfo.player = player->GetObjectGuid();
+    pinfo.plr = player;
+    pinfo.flags = MEMBER_FLAG_NONE;
+
+    m_playerIndex[pinfo.player] = uint32(m_players.size());
+    m_players.push_back(pinfo);
+}
+
+void Channel::RemovePlayerInfo(ObjectGuid guid)
+{
+    PlayerIndexMap::iterator i_itr = m_playerIndex.find(guid);
+    if (i_itr == m_playerIndex.end())
+        return;
+
+    // move the last member into the freed slot to keep storage contiguous
+    uint32 slot = i_itr->second;
+    m_playerIndex.erase(i_itr);
+
+    if (slot != m_players.size() - 1)
+    {
+        m_players[slot] = m_players.back();
+        m_playerIndex[m_players[slot].player] = slot;
+    }
+
+    m_players.pop_back();
+}
+
+void Channel::CountMessage()
+{
+    time_t now = sWorld.GetGameTime();
+
+    if (now - m_windowStart >= CHANNEL_MESSAGE_RATE_WINDOW)
+    {
+        // windows without any message in between count as silent
+        m_lastWindowRate = (now - m_windowStart < 2 * CHANNEL_MESSAGE_RATE_WINDOW) ? float(m_windowMessages) / (now - m_windowStart) : 0.0f;
+        m_windowMessages = 0;
+        m_windowStart = now;
+    }
+
+    ++m_windowMessages;
+    ++m_totalMessages;
+}
+
+float Channel::GetMessageRate() const
+{
+    time_t elapsed = sWorld.GetGameTime() - m_windowStart;
+
+    // current window is complete but not rolled over yet since no message arrived
+    if (elapsed >= 2 * CHANNEL_MESSAGE_RATE_WINDOW)
+        return 0.0f;
+
+    if (elapsed >= CHANNEL_MESSAGE_RATE_WINDOW)
+        return float(m_windowMessages) / elapsed;
+
+    return m_lastWindowRate;
 }
 
 void Channel::Voice(ObjectGuid /*guid1*/, ObjectGuid /*guid2*/) const
@@ -1023,11 +1087,11 @@ ObjectGuid Channel::SelectNewOwner() const
     // Prioritise moderators for owner appointment
     for (auto itr = m_players.begin(); itr != m_players.end(); ++itr)
     {
-        if ((*itr).second.IsModerator())
-            return (*itr).second.player;
+        if ((*itr).IsModerator())
+            return (*itr).player;
     }
 
-    return (m_players.empty() ? ObjectGuid() : m_players.begin()->second.player);
+    return (m_players.empty() ? ObjectGuid() : m_players.begin()->player);
 }
 
 void Channel::SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set)
@@ -1035,10 +1099,14 @@ void Channel::SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set)
     // Restrict input flags to currently supported by this method
     flags = ChannelMemberFlags(uint8(flags) & (MEMBER_FLAG_MODERATOR | MEMBER_FLAG_MUTED));
 
-    if (flags && m_players[guid].HasFlag(flags) != set)
+    PlayerInfo* pinfo = GetPlayerInfo(guid);
+    if (!pinfo)
+        return;
+
+    if (flags && pinfo->HasFlag(flags) != set)
     {
-        uint8 oldFlag = GetPlayerFlags(guid);
-        m_players[guid].SetFlag(flags, set);
+        uint8 oldFlag = pinfo->flags;
+        pinfo->SetFlag(flags, set);
 
         WorldPacket data;
         MakeModeChange(data, m_name, guid, oldFlag, GetPlayerFlags(guid));
@@ -1050,15 +1118,14 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 {
     if (m_ownerGuid)
     {
-        // [] will re-add player after it possible removed
-        PlayerList::iterator p_itr = m_players.find(m_ownerGuid);
-        if (p_itr != m_players.end())
+        // old owner may have left the channel already
+        if (PlayerInfo* pinfo = GetPlayerInfo(m_ownerGuid))
         {
             // old owner retains own moderator powers on transfer to another player only
-            p_itr->second.SetModerator(bool(guid));
+            pinfo->SetModerator(bool(guid));
 
-            uint8 oldFlag = p_itr->second.flags;
-            p_itr->second.SetOwner(false);
+            uint8 oldFlag = pinfo->flags;
+            pinfo->SetOwner(false);
 
             WorldPacket data;
             MakeModeChange(data, m_name, guid, oldFlag, GetPlayerFlags(guid));
@@ -1068,13 +1135,13 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
     m_ownerGuid = guid;
 
-    if (m_ownerGuid)
+    if (PlayerInfo* pinfo = GetPlayerInfo(m_ownerGuid))
     {
         // new owner receives moderator powers as well
-        m_players[m_ownerGuid].SetModerator(true);
+        pinfo->SetModerator(true);
 
-        uint8 oldFlag = GetPlayerFlags(m_ownerGuid);
-        m_players[m_ownerGuid].SetOwner(true);
+        uint8 oldFlag = pinfo->flags;
+        pinfo->SetOwner(true);
 
         WorldPacket data;
         MakeModeChange(data, m_name, guid, oldFlag, GetPlayerFlags(guid));
@@ -1111,8 +1178,8 @@ bool Channel::SetStatic(bool state, bool command/* = false*/)
     {
         for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
         {
-            if (i->second.IsModerator())
-                SetModeFlags(i->second.player, MEMBER_FLAG_MODERATOR, false);
+            if (i->IsModerator())
+                SetModeFlags(i->player, MEMBER_FLAG_MODERATOR, false);
         }
     }
 
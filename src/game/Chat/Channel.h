@@ -25,6 +25,11 @@
 #include "Entities/Player.h"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
+
+// length, in seconds, of the window over which channel message rates are measured
+#define CHANNEL_MESSAGE_RATE_WINDOW 60
 
 enum ChatNotify : uint8
 {
@@ -121,6 +126,7 @@ class Channel
         struct PlayerInfo
         {
             ObjectGuid player;
+            Player* plr;                                    // members always leave on logout, see Player::CleanupChannels
             uint8 flags;
 
             inline bool HasFlag(uint8 flag) const { return (flags & flag) != 0; }
@@ -133,7 +139,9 @@ class Channel
             inline void SetMuted(bool state) { SetFlag(MEMBER_FLAG_MUTED, state); }
         };
 
-        typedef std::map<ObjectGuid, PlayerInfo> PlayerList;
+        // members are stored contiguously for broadcasts, with a guid index for lookups
+        typedef std::vector<PlayerInfo> PlayerList;
+        typedef std::unordered_map<ObjectGuid, uint32> PlayerIndexMap;
 
     public:
         Channel(const std::string& name, uint32 channel_id = 0);
@@ -148,6 +156,9 @@ class Channel
         size_t GetNumPlayers() const { return m_players.size(); }
         uint8 GetFlags() const { return m_flags; }
         bool HasFlag(uint8 flag) const { return (m_flags & flag) != 0; }
+        // player messages per second over the last complete rate window
+        float GetMessageRate() const;
+        uint64 GetTotalMessages() const { return m_totalMessages; }
 
         void Join(Player* player, const char* password);
         void Leave(Player* player, bool send = true);
@@ -219,18 +230,32 @@ class Channel
         void SendToAll(WorldPacket const& data) const;
         void SendMessage(WorldPacket const& data, ObjectGuid sender) const;
 
-        bool IsOn(ObjectGuid who) const { return m_players.find(who) != m_players.end(); }
+        bool IsOn(ObjectGuid who) const { return m_playerIndex.find(who) != m_playerIndex.end(); }
         bool IsBanned(ObjectGuid guid) const { return m_banned.find(guid) != m_banned.end(); }
 
-        uint8 GetPlayerFlags(ObjectGuid guid) const
+        PlayerInfo* GetPlayerInfo(ObjectGuid guid)
+        {
+            PlayerIndexMap::const_iterator i_itr = m_playerIndex.find(guid);
+            return i_itr != m_playerIndex.end() ? &m_players[i_itr->second] : nullptr;
+        }
+
+        PlayerInfo const* GetPlayerInfo(ObjectGuid guid) const
         {
-            PlayerList::const_iterator p_itr = m_players.find(guid);
-            if (p_itr == m_players.end())
-                return 0;
+            PlayerIndexMap::const_iterator i_itr = m_playerIndex.find(guid);
+            return i_itr != m_playerIndex.end() ? &m_players[i_itr->second] : nullptr;
+        }
 
-            return p_itr->second.flags;
+        uint8 GetPlayerFlags(ObjectGuid guid) const
+        {
+            PlayerInfo const* pinfo = GetPlayerInfo(guid);
+            return pinfo ? pinfo->flags : 0;
         }
 
+        void AddPlayerInfo(Player* player);
+        void RemovePlayerInfo(ObjectGuid guid);
+
+        void CountMessage();
+
         ObjectGuid SelectNewOwner() const;
 
         void SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set);
@@ -241,6 +266,7 @@ class Channel
         std::string                 m_password;
         ObjectGuid                  m_ownerGuid;
         PlayerList                  m_players;
+        PlayerIndexMap              m_playerIndex;
         GuidSet                     m_banned;
         const ChatChannelsEntry*    m_entry = nullptr;
         bool                        m_announcements = false;
@@ -249,5 +275,10 @@ class Channel
         // Custom features:
         bool                        m_static = false;
         bool                        m_realmzone = false;
+        // Message rate statistics:
+        uint64                      m_totalMessages = 0;
+        uint32                      m_windowMessages = 0;
+        time_t                      m_windowStart = 0;
+        float                       m_lastWindowRate = 0.0f;
 };
 #endif
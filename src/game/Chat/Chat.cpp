@@ -170,6 +170,7 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "list",           SEC_MODERATOR,      false, &ChatHandler::HandleChannelListCommand,              "", nullptr },
         { "static",         SEC_MODERATOR,      false, &ChatHandler::HandleChannelStaticCommand,            "", nullptr },
+        { "stats",          SEC_ADMINISTRATOR,  false, &ChatHandler::HandleChannelStatsCommand,             "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -346,6 +347,7 @@ ChatCommand* ChatHandler::getCommandTable()
         { "invite",         SEC_GAMEMASTER,     true,  &ChatHandler::HandleGuildInviteCommand,         "", nullptr },
         { "uninvite",       SEC_GAMEMASTER,     true,  &ChatHandler::HandleGuildUninviteCommand,       "", nullptr },
         { "rank",           SEC_GAMEMASTER,     true,  &ChatHandler::HandleGuildRankCommand,           "", nullptr },
+        { "stats",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleGuildStatsCommand,          "", nullptr },
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
 
@@ -812,12 +814,15 @@ ChatCommand* ChatHandler::getCommandTable()
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverIdleShutdownCommandTable },
         { "info",           SEC_PLAYER,         true,  &ChatHandler::HandleServerInfoCommand,          "", nullptr },
         { "log",            SEC_CONSOLE,        true,  nullptr,                                        "", serverLogCommandTable },
+        { "memory",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerMemoryCommand,        "", nullptr },
         { "motd",           SEC_PLAYER,         true,  &ChatHandler::HandleServerMotdCommand,          "", nullptr },
+        { "objectstats",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerObjectStatsCommand,   "", nullptr },
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", nullptr },
         { "resetallraid",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerResetAllRaidCommand,  "", nullptr },
         { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverRestartCommandTable },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverShutdownCommandTable },
         { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverSetCommandTable },
+        { "trace",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerTraceCommand,         "", nullptr },
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
 
@@ -935,10 +940,17 @@ ChatCommand* ChatHandler::getCommandTable()
 
 #include "Anticheat/module/AnticheatChatCommands.h"
 
+    static ChatCommand lfgCommandTable[] =
+    {
+        { "stats",         SEC_ADMINISTRATOR,  true,   &ChatHandler::HandleLfgStatsCommand,            "", nullptr },
+        { nullptr,         0,                  false,  nullptr,                                        "", nullptr }
+    };
+
     static ChatCommand battlegroundCommandTable[] =
     {
         { "start",         SEC_GAMEMASTER,     false,  &ChatHandler::HandleBattlegroundStartCommand,   "", nullptr },
         { "stop",          SEC_GAMEMASTER,     false,  &ChatHandler::HandleBattlegroundStopCommand,    "", nullptr },
+        { "queuestats",    SEC_ADMINISTRATOR,  true,   &ChatHandler::HandleBattlegroundQueueStatsCommand, "", nullptr },
         { nullptr,         0,                  false,  nullptr,                                        "", nullptr }
     };
 
@@ -972,6 +984,7 @@ ChatCommand* ChatHandler::getCommandTable()
         { "learn",          SEC_MODERATOR,      false, nullptr,                                        "", learnCommandTable    },
         { "link",           SEC_ADMINISTRATOR,  false, nullptr,                                        "", linkCommandTable     },
         { "list",           SEC_ADMINISTRATOR,  true,  nullptr,                                        "", listCommandTable     },
+        { "lfg",            SEC_ADMINISTRATOR,  true,  nullptr,                                        "", lfgCommandTable      },
         { "lookup",         SEC_MODERATOR,      true,  nullptr,                                        "", lookupCommandTable   },
         { "modify",         SEC_MODERATOR,      false, nullptr,                                        "", modifyCommandTable   },
         { "npc",            SEC_MODERATOR,      false, nullptr,                                        "", npcCommandTable      },
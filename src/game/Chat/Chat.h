@@ -249,6 +249,7 @@ class ChatHandler
 
         bool HandleChannelListCommand(char* args);
         bool HandleChannelStaticCommand(char* args);
+        bool HandleChannelStatsCommand(char* args);
 
         bool HandleDebugAnimCommand(char* args);
         bool HandleDebugArenaCommand(char* args);
@@ -374,6 +375,7 @@ class ChatHandler
         bool HandleGuildUninviteCommand(char* args);
         bool HandleGuildRankCommand(char* args);
         bool HandleGuildDeleteCommand(char* args);
+        bool HandleGuildStatsCommand(char* args);
 
         bool HandleHonorAddCommand(char* args);
         bool HandleHonorAddKillCommand(char* args);
@@ -646,13 +648,16 @@ class ChatHandler
         bool HandleServerInfoCommand(char* args);
         bool HandleServerLogFilterCommand(char* args);
         bool HandleServerLogLevelCommand(char* args);
+        bool HandleServerMemoryCommand(char* args);
         bool HandleServerMotdCommand(char* args);
+        bool HandleServerObjectStatsCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
         bool HandleServerResetAllRaidCommand(char* args);
         bool HandleServerRestartCommand(char* args);
         bool HandleServerSetMotdCommand(char* args);
         bool HandleServerShutDownCommand(char* args);
         bool HandleServerShutDownCancelCommand(char* args);
+        bool HandleServerTraceCommand(char* args);
 
         bool HandleTeleCommand(char* args);
         bool HandleTeleAddCommand(char* args);
@@ -817,6 +822,9 @@ class ChatHandler
         // Battleground
         bool HandleBattlegroundStartCommand(char* args);
         bool HandleBattlegroundStopCommand(char* args);
+        bool HandleBattlegroundQueueStatsCommand(char* args);
+
+        bool HandleLfgStatsCommand(char* args);
 
         //! Development Commands
         bool HandleSaveAllCommand(char* args);
@@ -2323,6 +2323,33 @@ bool ChatHandler::HandleChannelListCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleChannelStatsCommand(char* args)
+{
+    uint32 max = 10;
+
+    ExtractUInt32(&args, max);
+
+    auto const& map = channelMgr(GetSession()->GetPlayer()->GetTeam())->GetChannels();
+
+    std::vector<Channel const*> list;
+    list.reserve(map.size());
+
+    for (auto const& pair : map)
+        list.push_back(pair.second);
+
+    std::sort(list.begin(), list.end(), [] (Channel const* a, Channel const* b) { return (a->GetMessageRate() > b->GetMessageRate()); });
+
+    const size_t count = std::min(list.size(), size_t(max));
+
+    PSendSysMessage("Channels by message rate (up to %u):", max);
+
+    for (size_t i = 0; i < count; ++i)
+        PSendSysMessage("* \"%s\" - %u members, %.2f messages/sec, " UI64FMTD " messages total",
+                        list[i]->GetName().c_str(), uint32(list[i]->GetNumPlayers()), list[i]->GetMessageRate(), list[i]->GetTotalMessages());
+
+    return true;
+}
+
 bool ChatHandler::HandleChannelStaticCommand(char* args)
 {
     char* name = ExtractLiteralArg(&args);
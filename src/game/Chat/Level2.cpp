@@ -5342,6 +5342,36 @@ bool ChatHandler::HandleBattlegroundStopCommand(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleBattlegroundQueueStatsCommand(char* /*args*/)
+{
+    BattleGroundQueue& queue = sWorld.GetBGQueue();
+    for (uint32 i = BATTLEGROUND_QUEUE_AV; i < MAX_BATTLEGROUND_QUEUE_TYPES; ++i)
+    {
+        BattleGroundQueueItem& queueItem = queue.GetBattleGroundQueue(BattleGroundQueueTypeId(i));
+        uint64 updates = queueItem.GetUpdateCount();
+        uint64 invited = queueItem.GetInvitedGroupCount();
+        PSendSysMessage("Queue %u: %u groups queued, %u updates (avg %u us), %u groups invited (avg wait %u ms)", i, queueItem.GetQueuedGroupCount(),
+            uint32(updates), uint32(updates ? queueItem.GetUpdateTime() / updates : 0), uint32(invited), uint32(invited ? queueItem.GetInvitedWaitTime() / invited : 0));
+    }
+
+    uint64 hits = sMapMgr.GetBgMapPoolHits();
+    uint64 misses = sMapMgr.GetBgMapPoolMisses();
+    uint64 created = sMapMgr.GetBgMapCreateCount();
+    PSendSysMessage("Map pool: %u maps ready, %u hits, %u misses (%u%% hit rate), %u maps created (avg %u us)", sMapMgr.GetBgMapPoolSize(),
+        uint32(hits), uint32(misses), uint32(hits + misses ? hits * 100 / (hits + misses) : 0), uint32(created), uint32(created ? sMapMgr.GetBgMapCreateTime() / created : 0));
+
+    return true;
+}
+
+bool ChatHandler::HandleLfgStatsCommand(char* /*args*/)
+{
+    LFGQueue& queue = sWorld.GetLFGQueue();
+    uint64 matched = queue.GetMatchedCount();
+    PSendSysMessage("LFG queue: %u entries queued, %u players matched (avg time to match %u ms)", queue.GetQueuedCount(),
+        uint32(matched), uint32(matched ? queue.GetMatchWaitTime() / matched : 0));
+    return true;
+}
+
 bool ChatHandler::LootStatsHelper(char* args, bool full)
 {
     uint32 amountOfCheck = 100000;
@@ -65,6 +65,9 @@
 #include "Globals/UnitCondition.h"
 #include "Globals/CombatCondition.h"
 #include "World/WorldStateExpression.h"
+#include "Util/Tracer.h"
+#include "Util/MemoryTracker.h"
+#include "Util/SlabAllocator.h"
 
 #include "MotionGenerators/MoveMap.h"
 
@@ -3169,6 +3172,7 @@ bool ChatHandler::HandleGuildRankCommand(char* args)
     else
         slot->ChangeRank(newrank);
 
+    targetGuild->InvalidateRoster();
     return true;
 }
 
@@ -3192,6 +3196,14 @@ bool ChatHandler::HandleGuildDeleteCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleGuildStatsCommand(char* /*args*/)
+{
+    GuildCacheStatistic const& stats = sGuildMgr.GetCacheStatistic();
+    PSendSysMessage("Guild roster packets built: %u, sent from cache: %u", stats.rosterBuilds, stats.rosterCached);
+    PSendSysMessage("Guild bank tab contents built: %u, sent from cache: %u", stats.bankTabBuilds, stats.bankTabCached);
+    return true;
+}
+
 bool ChatHandler::HandleGetDistanceCommand(char* args)
 {
     WorldObject* obj = nullptr;
@@ -4735,10 +4747,83 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
-    for (const auto& itr : plist)
-        itr.second->SetAtLoginFlag(atLogin);
+    sObjectAccessor.ExecuteOnAllPlayers([atLogin](Player* player)
+    {
+        player->SetAtLoginFlag(atLogin);
+    });
+
+    return true;
+}
+
+bool ChatHandler::HandleServerObjectStatsCommand(char* /*args*/)
+{
+    ObjectRegistryStatistic players = sObjectAccessor.GetPlayerStatistic();
+    PSendSysMessage("Player registry reads: " UI64FMTD " (" UI64FMTD " contended), writes: " UI64FMTD " (" UI64FMTD " contended)",
+                    players.reads, players.contendedReads, players.writes, players.contendedWrites);
+    PSendSysMessage("Player name lookups: " UI64FMTD, sObjectAccessor.GetPlayerNameLookups());
 
+    ObjectRegistryStatistic corpses = HashMapHolder<Corpse>::GetStatistic();
+    PSendSysMessage("Corpse registry reads: " UI64FMTD " (" UI64FMTD " contended), writes: " UI64FMTD " (" UI64FMTD " contended)",
+                    corpses.reads, corpses.contendedReads, corpses.writes, corpses.contendedWrites);
+    return true;
+}
+
+bool ChatHandler::HandleServerMemoryCommand(char* /*args*/)
+{
+    SendSysMessage("Tracked memory (current / peak, live allocations):");
+
+    uint64 total = 0;
+    for (uint32 i = 0; i < MAX_MEMORY_TAGS; ++i)
+    {
+        MemoryTagStatistic statistic = MemoryTracker::GetStatistic(MemoryTag(i));
+        PSendSysMessage("  %-15s " UI64FMTD " KB / " UI64FMTD " KB, " UI64FMTD " allocations",
+                        MemoryTracker::GetTagName(MemoryTag(i)), statistic.bytes / 1024, statistic.peakBytes / 1024, statistic.allocations);
+        total += statistic.bytes;
+    }
+
+    PSendSysMessage("Total tracked: " UI64FMTD " KB", total / 1024);
+
+    BufferPoolStatistic buffers = BufferPool::GetStatistic();
+    PSendSysMessage("Buffer pool: " UI64FMTD " requests, " UI64FMTD " from heap, " UI64FMTD " KB cached",
+                    buffers.requests, buffers.heapAllocations, buffers.cachedBytes / 1024);
+
+    for (uint32 i = 0; i < SlabAllocator::GetAllocatorCount(); ++i)
+    {
+        SlabAllocator const* slab = SlabAllocator::GetAllocator(i);
+        SlabStatistic statistic = slab->GetStatistic();
+        uint64 capacity = statistic.slabs * (SLAB_SIZE / statistic.objectSize);
+        PSendSysMessage("Slab %s: " UI64FMTD " live / " UI64FMTD " peak of " UI64FMTD " slots in " UI64FMTD " slabs, " UI64FMTD " allocations, " UI64FMTD " too large",
+                        slab->GetName(), statistic.liveObjects, statistic.peakObjects, capacity, statistic.slabs, statistic.allocations, statistic.heapFallbacks);
+    }
+
+    if (uint64 resident = MemoryTracker::GetProcessResidentSize())
+        PSendSysMessage("Process resident: " UI64FMTD " KB", resident / 1024);
+    return true;
+}
+
+bool ChatHandler::HandleServerTraceCommand(char* args)
+{
+    uint32 seconds;
+    if (!ExtractOptUInt32(&args, seconds, 10))
+        return false;
+
+    if (!Tracer::IsEnabled())
+    {
+        SendSysMessage("Span recording is disabled, set Trace.Enable in the config.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::string file = sLog.GetLogsDir() + "trace_" + Log::GetTimestampStr() + ".json";
+    int32 count = sTracer.Dump(file, seconds);
+    if (count < 0)
+    {
+        PSendSysMessage("Could not write trace file %s.", file.c_str());
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Wrote %i spans of the last %u seconds to %s.", count, seconds, file.c_str());
     return true;
 }
 
@@ -6263,6 +6348,12 @@ bool ChatHandler::HandleInstanceStatsCommand(char* /*args*/)
     PSendSysMessage("instance saves: %d", numSaves);
     PSendSysMessage("players bound: %d", numBoundPlayers);
     PSendSysMessage("groups bound: %d", numBoundGroups);
+
+    uint64 created = sMapMgr.GetInstanceCreateCount();
+    PSendSysMessage("instances created: " UI64FMTD ", avg preparation time: " UI64FMTD " us", created, created ? sMapMgr.GetInstanceCreateTime() / created : 0);
+
+    uint64 lockHolds = sMapMgr.GetLockHoldCount();
+    PSendSysMessage("map manager lock held: " UI64FMTD " times, avg " UI64FMTD " us, max " UI64FMTD " us", lockHolds, lockHolds ? sMapMgr.GetLockHoldTime() / lockHolds : 0, sMapMgr.GetLockHoldMaxTime());
     return true;
 }
 
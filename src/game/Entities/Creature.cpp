@@ -47,6 +47,8 @@
 #include "Movement/MoveSplineInit.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Maps/SpawnManager.h"
+#include "Entities/TemporarySpawn.h"
+#include "Entities/Totem.h"
 
 // apply implementation of the singletons
 #include "Policies/Singleton.h"
@@ -133,6 +135,9 @@ bool CreatureCreatePos::Relocate(Creature* cr) const
     return true;
 }
 
+// summons churn as much as spawns, pets are rare enough to come from the heap
+SlabAllocator Creature::s_slab("creature", std::max({ sizeof(Creature), sizeof(TemporarySpawn), sizeof(TemporarySpawnWaypoint), sizeof(Totem) }), MEMORY_TAG_WORLD_OBJECTS);
+
 Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_gossipMenuId(0), m_lootMoney(0), m_lootGroupRecipientId(0),
     m_lootStatus(CREATURE_LOOT_STATUS_NONE),
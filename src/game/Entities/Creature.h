@@ -27,6 +27,7 @@
 #include "Util/Util.h"
 #include "Entities/CreatureSpellList.h"
 #include "Entities/CreatureSettings.h"
+#include "Util/SlabAllocator.h"
 
 #include <list>
 #include <memory>
@@ -572,6 +573,10 @@ class Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        // destroyed on despawn and created again on respawn, the slab hands the freed slot to the next spawn of the map thread
+        static void* operator new(size_t size) { return s_slab.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { s_slab.Free(ptr, size); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
         void CleanupsBeforeDelete() override;
@@ -1001,6 +1006,8 @@ class Creature : public Unit
         bool m_imposedCooldown;
 
     private:
+        static SlabAllocator s_slab;
+
         GridReference<Creature> m_gridRef;
         CreatureInfo const* m_creatureInfo;                 // in heroic mode can different from sObjectMgr::GetCreatureTemplate(GetEntry())
 
@@ -61,6 +61,9 @@ QuaternionData QuaternionData::fromEulerAnglesZYX(float Z, float Y, float X)
     return QuaternionData(quat.x, quat.y, quat.z, quat.w);
 }
 
+// transports are few and live as long as their map, they come from the heap
+SlabAllocator GameObject::s_slab("gameobject", sizeof(GameObject), MEMORY_TAG_WORLD_OBJECTS);
+
 GameObject::GameObject() : WorldObject(),
     m_model(nullptr),
     m_captureSlider(0),
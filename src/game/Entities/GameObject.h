@@ -25,6 +25,7 @@
 #include "Util/Util.h"
 #include "AI/BaseAI/GameObjectAI.h"
 #include "Spells/SpellDefines.h"
+#include "Util/SlabAllocator.h"
 
 #include <array>
 
@@ -721,6 +722,10 @@ class GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        // destroyed on despawn and created again on respawn, the slab hands the freed slot to the next spawn of the map thread
+        static void* operator new(size_t size) { return s_slab.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { s_slab.Free(ptr, size); }
+
         static GameObject* CreateGameObject(uint32 entry);
 
         void AddToWorld() override;
@@ -983,6 +988,8 @@ class GameObject : public WorldObject
         GameObjectGroup* m_goGroup;
 
     private:
+        static SlabAllocator s_slab;
+
         void SwitchDoorOrButton(bool activate, bool alternative = false);
         void TickCapturePoint();
         void UpdateModel();                                 // updates model in case displayId were changed
@@ -73,7 +73,7 @@ Object::~Object()
         MANGOS_ASSERT(false);
     }
 
-    delete[] m_uint32Values;
+    BufferPool::Free(m_uint32Values, m_valuesCount * sizeof(uint32));
 
     delete m_loot;
 }
@@ -104,7 +104,8 @@ void Object::RemoveFromWorld()
 
 void Object::_InitValues()
 {
-    m_uint32Values = new uint32[ m_valuesCount ];
+    // respawns free and request the same sizes over and over, the buffer pool recycles them per thread
+    m_uint32Values = static_cast<uint32*>(BufferPool::Allocate(m_valuesCount * sizeof(uint32)));
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
     m_changedValues.resize(m_valuesCount, false);
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "ObjectDefines.h"
 #include "Util/ByteBuffer.h"
+#include "Util/BufferPool.h"
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
 #include "Entities/ObjectGuid.h"
@@ -652,7 +653,7 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        std::vector<bool, BufferPoolAllocator<bool>> m_changedValues;
 
         uint16 m_valuesCount;
 
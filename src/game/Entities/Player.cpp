@@ -601,6 +601,7 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     m_mailsUpdated = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
+    m_mailItemsLoading = false;
 
     m_resetTalentsCost = 0;
     m_resetTalentsTime = 0;
@@ -15998,29 +15999,26 @@ void Player::_LoadItemLoot(std::unique_ptr<QueryResult> queryResult)
     }
 }
 
-// load mailed item which should receive current player
+// load mailed item headers which should receive current player, item instances are loaded at mailbox open
 void Player::_LoadMailedItems(std::unique_ptr<QueryResult> queryResult)
 {
-    //        0          1            2                3      4         5        6      7             8                 9           10          11       12         13
-    // SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
+    //        0        1          2
+    // SELECT mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
     if (!queryResult)
         return;
 
     do
     {
         Field* fields = queryResult->Fetch();
-        uint32 mail_id       = fields[11].GetUInt32();
-        uint32 item_guid_low = fields[12].GetUInt32();
-        uint32 item_template = fields[13].GetUInt32();
+        uint32 mail_id       = fields[0].GetUInt32();
+        uint32 item_guid_low = fields[1].GetUInt32();
+        uint32 item_template = fields[2].GetUInt32();
 
         Mail* mail = GetMail(mail_id);
         if (!mail)
             continue;
-        mail->AddItem(item_guid_low, item_template);
-
-        ItemPrototype const* proto = ObjectMgr::GetItemPrototype(item_template);
 
-        if (!proto)
+        if (!ObjectMgr::GetItemPrototype(item_template))
         {
             sLog.outError("Player %u has unknown item_template (ProtoType) in mailed items(GUID: %u template: %u) in mail (%u), deleted.", GetGUIDLow(), item_guid_low, item_template, mail->messageID);
             CharacterDatabase.PExecute("DELETE FROM mail_items WHERE item_guid = '%u'", item_guid_low);
@@ -16028,12 +16026,42 @@ void Player::_LoadMailedItems(std::unique_ptr<QueryResult> queryResult)
             continue;
         }
 
+        mail->AddItem(item_guid_low, item_template);
+    }
+    while (queryResult->NextRow());
+}
+
+// load item instances of mails, called with result of mailed items query issued at mailbox open
+void Player::LoadMailedItems(QueryResult* queryResult)
+{
+    //        0          1            2                3      4         5        6      7             8                 9           10          11       12         13
+    // SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u' AND mail_id IN (...)
+    if (!queryResult)
+        return;
+
+    do
+    {
+        Field* fields = queryResult->Fetch();
+        uint32 mail_id       = fields[11].GetUInt32();
+        uint32 item_guid_low = fields[12].GetUInt32();
+        uint32 item_template = fields[13].GetUInt32();
+
+        // mail can be deleted or item already loaded (template items) while query was in progress
+        Mail* mail = GetMail(mail_id);
+        if (!mail || mail->state == MAIL_STATE_DELETED || GetMItem(item_guid_low))
+            continue;
+
+        ItemPrototype const* proto = ObjectMgr::GetItemPrototype(item_template);
+        if (!proto)
+            continue;                                       // already reported and removed at mail headers loading
+
         Item* item = NewItemOrBag(proto);
 
         if (!item->LoadFromDB(item_guid_low, fields, GetObjectGuid()))
         {
-            sLog.outError("Player::_LoadMailedItems - Item in mail (%u) doesn't exist !!!! - item guid: %u, deleted from mail", mail->messageID, item_guid_low);
+            sLog.outError("Player::LoadMailedItems - Item in mail (%u) doesn't exist !!!! - item guid: %u, deleted from mail", mail->messageID, item_guid_low);
             CharacterDatabase.PExecute("DELETE FROM mail_items WHERE item_guid = '%u'", item_guid_low);
+            mail->RemoveItem(item_guid_low);
             item->FSetState(ITEM_REMOVED);
             item->SaveToDB();                               // it also deletes item object !
             continue;
@@ -16044,6 +16072,33 @@ void Player::_LoadMailedItems(std::unique_ptr<QueryResult> queryResult)
     while (queryResult->NextRow());
 }
 
+// load item instances of all mails at once, for cases without mailbox interaction (playerbots)
+void Player::LoadAllMailedItems()
+{
+    if (m_mailItemsLoading)
+        return;
+
+    bool needLoad = false;
+    for (PlayerMails::const_iterator itr = m_mail.begin(); itr != m_mail.end() && !needLoad; ++itr)
+        needLoad = !HasMailedItemsLoaded(*itr);
+
+    if (!needLoad)
+        return;
+
+    auto queryResult = CharacterDatabase.PQuery("SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template "
+                       "FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", GetGUIDLow());
+    LoadMailedItems(queryResult.get());
+}
+
+bool Player::HasMailedItemsLoaded(Mail const* mail) const
+{
+    for (MailItemInfoVec::const_iterator itr = mail->items.begin(); itr != mail->items.end(); ++itr)
+        if (mMitems.find(itr->item_guid) == mMitems.end())
+            return false;
+
+    return true;
+}
+
 void Player::_LoadMails(std::unique_ptr<QueryResult> queryResult)
 {
     m_mail.clear();
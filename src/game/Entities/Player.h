@@ -1457,12 +1457,17 @@ class Player : public Unit
         PlayerMails::iterator GetMailBegin() { return m_mail.begin();}
         PlayerMails::iterator GetMailEnd() { return m_mail.end();}
 
+        void LoadMailedItems(QueryResult* queryResult);
+        void LoadAllMailedItems();
+        bool HasMailedItemsLoaded(Mail const* mail) const;
+
         /*********************************************************/
         /*** MAILED ITEMS SYSTEM ***/
         /*********************************************************/
 
         uint8 unReadMails;
         time_t m_nextMailDelivereTime;
+        bool m_mailItemsLoading;                            // mailed items query in progress, mail list will be sent at result
 
         typedef std::unordered_map<uint32, Item*> ItemMap;
 
@@ -53,7 +53,17 @@
 #include "Spells/SpellStacking.h"
 
 #ifdef BUILD_METRICS
- #include "Metric/Metric.h"
+ #include "Metric/MetricRegistry.h"
+
+namespace
+{
+    // durations in microseconds, shared by all units so the hot path never builds tags
+    metric::histogram g_unitUpdateMetric("unit.update", {}, metric::histogram::exponential_bounds(1, 2, 16));
+    metric::histogram g_unitUpdateAIMetric("unit.update.ai", {}, metric::histogram::exponential_bounds(1, 2, 16));
+    metric::histogram g_unitUpdateSpellsMetric("unit.update.spells", {}, metric::histogram::exponential_bounds(1, 2, 16));
+    metric::histogram g_unitUpdateSplineMetric("unit.updatesplinemovement", {}, metric::histogram::exponential_bounds(1, 2, 16));
+    metric::counter g_unitUpdateHoldersMetric("unit.update.spells.holders");
+}
 #endif
 
 #include <math.h>
@@ -477,13 +487,7 @@ void Unit::Update(const uint32 diff)
     if (!IsInWorld())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    metric::timer<std::chrono::microseconds> meas(g_unitUpdateMetric);
 #endif
 
     /*if(p_time > m_AurasCheck)
@@ -532,13 +536,7 @@ void Unit::Update(const uint32 diff)
     if (AI() && IsAlive())
     {
 #ifdef BUILD_METRICS
-        metric::duration<std::chrono::microseconds> meas_ai("unit.update.ai", {
-            { "entry", std::to_string(GetEntry()) },
-            { "guid", std::to_string(GetGUIDLow()) },
-            { "unit_type", std::to_string(GetGUIDHigh()) },
-            { "map_id", std::to_string(GetMapId()) },
-            { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
+        metric::timer<std::chrono::microseconds> meas_ai(g_unitUpdateAIMetric);
 #endif
 
         AI()->UpdateAI(diff);   // AI not react good at real update delays (while freeze in non-active part of map)
@@ -4328,15 +4326,8 @@ uint32 Unit::GetWeaponSkillValue(WeaponAttackType attType, Unit const* target) c
 void Unit::_UpdateSpells(uint32 time)
 {
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update.spells", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
-
-    std::vector<uint32> updatedSpellIds;
+    metric::timer<std::chrono::microseconds> meas(g_unitUpdateSpellsMetric);
+    uint64 updatedHolders = 0;
 #endif
 
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
@@ -4360,7 +4351,7 @@ void Unit::_UpdateSpells(uint32 time)
         ++m_spellAuraHoldersUpdateIterator;                 // need shift to next for allow update if need into aura update
         i_holder->UpdateHolder(time);
 #ifdef BUILD_METRICS
-        updatedSpellIds.push_back(i_holder->GetId());
+        ++updatedHolders;
 #endif
     }
 
@@ -4378,10 +4369,7 @@ void Unit::_UpdateSpells(uint32 time)
             ++iter;
     }
 #ifdef BUILD_METRICS
-    std::string logging;
-    for (uint32 spellId : updatedSpellIds)
-        logging += std::to_string(spellId) + ",";
-    meas.add_field("spells", "\"" + logging + "\"");
+    g_unitUpdateHoldersMetric.add(updatedHolders);
 #endif
 }
 
@@ -11597,13 +11585,7 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     if (movespline->Finalized())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.updatesplinemovement", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    metric::timer<std::chrono::microseconds> meas(g_unitUpdateSplineMetric);
 #endif
     movespline->updateState(t_diff);
     bool arrived = movespline->Finalized();
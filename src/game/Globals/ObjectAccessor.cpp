@@ -35,35 +35,95 @@
 INSTANTIATE_SINGLETON_2(ObjectAccessor, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(ObjectAccessor, std::mutex);
 
+template<class T>
+typename HashMapHolder<T>::ReadGuard HashMapHolder<T>::LockForRead(Shard& shard)
+{
+    shard.reads.fetch_add(1, std::memory_order_relaxed);
+    ReadGuard guard(shard.lock, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+        shard.contendedReads.fetch_add(1, std::memory_order_relaxed);
+        guard.lock();
+    }
+    return guard;
+}
+
+template<class T>
+typename HashMapHolder<T>::WriteGuard HashMapHolder<T>::LockForWrite(Shard& shard)
+{
+    shard.writes.fetch_add(1, std::memory_order_relaxed);
+    WriteGuard guard(shard.lock, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+        shard.contendedWrites.fetch_add(1, std::memory_order_relaxed);
+        guard.lock();
+    }
+    return guard;
+}
+
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap[o->GetObjectGuid()] = o;
+    Shard& shard = GetShard(o->GetObjectGuid());
+    WriteGuard guard = LockForWrite(shard);
+    shard.objects[o->GetObjectGuid()] = o;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap.erase(o->GetObjectGuid());
+    Shard& shard = GetShard(o->GetObjectGuid());
+    WriteGuard guard = LockForWrite(shard);
+    shard.objects.erase(o->GetObjectGuid());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    ReadGuard guard(i_lock);
-    typename MapType::iterator itr = m_objectMap.find(guid);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    Shard& shard = GetShard(guid);
+    ReadGuard guard = LockForRead(shard);
+    typename MapType::const_iterator itr = shard.objects.find(guid);
+    return (itr != shard.objects.end()) ? itr->second : nullptr;
+}
+
+template<class T>
+void HashMapHolder<T>::DoForAll(std::function<void(T*)> const& executor)
+{
+    for (Shard& shard : m_shards)
+    {
+        ReadGuard guard = LockForRead(shard);
+        for (auto& itr : shard.objects)
+            executor(itr.second);
+    }
 }
 
 template<class T>
-typename HashMapHolder<T>::MapType& HashMapHolder<T>::GetContainer() { return m_objectMap; }
+size_t HashMapHolder<T>::GetCount()
+{
+    size_t count = 0;
+    for (Shard& shard : m_shards)
+    {
+        ReadGuard guard(shard.lock);
+        count += shard.objects.size();
+    }
+    return count;
+}
 
 template<class T>
-typename HashMapHolder<T>::LockType& HashMapHolder<T>::GetLock() { return i_lock; }
+ObjectRegistryStatistic HashMapHolder<T>::GetStatistic()
+{
+    ObjectRegistryStatistic stats;
+    for (Shard const& shard : m_shards)
+    {
+        stats.reads += shard.reads;
+        stats.contendedReads += shard.contendedReads;
+        stats.writes += shard.writes;
+        stats.contendedWrites += shard.contendedWrites;
+    }
+    return stats;
+}
 
-ObjectAccessor::ObjectAccessor() {}
+ObjectAccessor::ObjectAccessor() : i_playerNameLookups(0) {}
 ObjectAccessor::~ObjectAccessor()
 {
     for (Player2CorpsesMapType::const_iterator itr = i_player2corpse.begin(); itr != i_player2corpse.end(); ++itr)
@@ -113,38 +173,58 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && (::strcmp(name, iter->second->GetName()) == 0))
-            return iter->second;
+    ObjectAccessor& accessor = sObjectAccessor;
+    ++accessor.i_playerNameLookups;
+
+    std::shared_lock<std::shared_mutex> lock(accessor.i_playerNamesLock);
+    auto itr = accessor.i_playerNames.find(name);
+    if (itr == accessor.i_playerNames.end() || !itr->second->IsInWorld())
+        return nullptr;
 
-    return nullptr;
+    return itr->second;
 }
 
 void ObjectAccessor::SaveAllPlayers() const
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (auto& itr : m)
+    HashMapHolder<Player>::DoForAll([](Player* plr)
     {
-        if (itr.second->IsInWorld())
-            itr.second->GetMap()->GetMessager().AddMessage([guid = itr.second->GetObjectGuid()](Map* map)
+        if (plr->IsInWorld())
+            plr->GetMap()->GetMessager().AddMessage([guid = plr->GetObjectGuid()](Map* map)
             {
                 if (Player* player = map->GetPlayer(guid))
                     player->SaveToDB();
             });
         else
-            itr.second->SaveToDB();
-    }
+            plr->SaveToDB();
+    });
 }
 
 void ObjectAccessor::ExecuteOnAllPlayers(std::function<void(Player*)> executor)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        executor(itr->second);
+    HashMapHolder<Player>::DoForAll(executor);
+}
+
+ObjectRegistryStatistic ObjectAccessor::GetPlayerStatistic() const
+{
+    return HashMapHolder<Player>::GetStatistic();
+}
+
+void ObjectAccessor::AddObject(Player* object)
+{
+    HashMapHolder<Player>::Insert(object);
+
+    std::unique_lock<std::shared_mutex> lock(i_playerNamesLock);
+    i_playerNames[object->GetName()] = object;
+}
+
+void ObjectAccessor::RemoveObject(Player* object)
+{
+    HashMapHolder<Player>::Remove(object);
+
+    std::unique_lock<std::shared_mutex> lock(i_playerNamesLock);
+    auto itr = i_playerNames.find(object->GetName());
+    if (itr != i_playerNames.end() && itr->second == object)
+        i_playerNames.erase(itr);
 }
 
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
@@ -311,8 +391,7 @@ void ObjectAccessor::RemoveOldCorpses()
 
 /// Define the static member of HashMapHolder
 
-template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HashMapHolder<T>::SHARD_COUNT];
 
 /// Global definitions for the hashmap storage
 
@@ -31,22 +31,32 @@
 #include "Entities/Player.h"
 #include "Entities/Corpse.h"
 
+#include <atomic>
 #include <functional>
 #include <mutex>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
 class Map;
 
+struct ObjectRegistryStatistic
+{
+    uint64 reads = 0;
+    uint64 contendedReads = 0;                              // reads which had to wait for a writer
+    uint64 writes = 0;
+    uint64 contendedWrites = 0;
+};
+
 template <class T>
 class HashMapHolder
 {
     public:
 
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef std::shared_mutex LockType;
+        typedef std::shared_lock<LockType> ReadGuard;
+        typedef std::unique_lock<LockType> WriteGuard;
 
         static void Insert(T* o);
 
@@ -54,17 +64,37 @@ class HashMapHolder
 
         static T* Find(ObjectGuid guid);
 
-        static MapType& GetContainer();
+        // shards are read locked one at a time while visited, executor must not add or remove objects of this type
+        static void DoForAll(std::function<void(T*)> const& executor);
+
+        static size_t GetCount();
 
-        static LockType& GetLock();
+        static ObjectRegistryStatistic GetStatistic();
 
     private:
 
+        // objects are spread over independently locked shards by guid so lookups from
+        // different map threads seldom share a lock or a cache line
+        static constexpr uint32 SHARD_COUNT = 16;
+
+        struct alignas(64) Shard
+        {
+            LockType lock;
+            MapType objects;
+            std::atomic<uint64> reads{0};
+            std::atomic<uint64> contendedReads{0};
+            std::atomic<uint64> writes{0};
+            std::atomic<uint64> contendedWrites{0};
+        };
+
+        static Shard& GetShard(ObjectGuid guid) { return m_shards[guid.GetCounter() % SHARD_COUNT]; }
+        static ReadGuard LockForRead(Shard& shard);
+        static WriteGuard LockForWrite(Shard& shard);
+
         // Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static Shard m_shards[SHARD_COUNT];
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex> >
@@ -88,14 +118,12 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         static Player* FindPlayerByName(const char* name);
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers() const
-        {
-            return HashMapHolder<Player>::GetContainer();
-        }
-
         void SaveAllPlayers() const;
         void ExecuteOnAllPlayers(std::function<void(Player*)> executor);
 
+        ObjectRegistryStatistic GetPlayerStatistic() const;
+        uint64 GetPlayerNameLookups() const { return i_playerNameLookups; }
+
         // Corpse access
         Corpse* GetCorpseForPlayerGUID(ObjectGuid guid);
         static Corpse* GetCorpseInMap(ObjectGuid guid, uint32 mapid);
@@ -107,14 +135,19 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { HashMapHolder<Corpse>::Insert(object); }
-        void AddObject(Player* object) { HashMapHolder<Player>::Insert(object); }
+        void AddObject(Player* object);
         void RemoveObject(Corpse* object) { HashMapHolder<Corpse>::Remove(object); }
-        void RemoveObject(Player* object) { HashMapHolder<Player>::Remove(object); }
+        void RemoveObject(Player* object);
 
     private:
 
         Player2CorpsesMapType   i_player2corpse;
 
+        // secondary index for name lookups, names do not change while a player is in the registry
+        std::unordered_map<std::string, Player*> i_playerNames;
+        mutable std::shared_mutex i_playerNamesLock;
+        std::atomic<uint64> i_playerNameLookups;
+
         typedef std::mutex LockType;
         typedef MaNGOS::GeneralLock<LockType > Guard;
 
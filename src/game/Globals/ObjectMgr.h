@@ -36,6 +36,7 @@
 #include "Globals/Conditions.h"
 #include "Maps/SpawnGroupDefines.h"
 #include "Util/UniqueTrackablePtr.h"
+#include "Util/MemoryTracker.h"
 
 #include <map>
 #include <climits>
@@ -145,8 +146,10 @@ struct CellObjectGuids
     CellGuidSet gameobjects;
     CellCorpseSet corpses;
 };
-typedef std::unordered_map<uint32/*cell_id*/, CellObjectGuids> CellObjectGuidsMap;
-typedef std::unordered_map<uint32/*(mapid,spawnMode) pair*/, CellObjectGuidsMap> MapObjectGuids;
+typedef std::unordered_map<uint32/*cell_id*/, CellObjectGuids, std::hash<uint32>, std::equal_to<uint32>,
+        MemoryTrackingAllocator<std::pair<const uint32, CellObjectGuids>, MEMORY_TAG_OBJECTMGR> > CellObjectGuidsMap;
+typedef std::unordered_map<uint32/*(mapid,spawnMode) pair*/, CellObjectGuidsMap, std::hash<uint32>, std::equal_to<uint32>,
+        MemoryTrackingAllocator<std::pair<const uint32, CellObjectGuidsMap>, MEMORY_TAG_OBJECTMGR> > MapObjectGuids;
 
 // mangos string ranges
 #define MIN_MANGOS_STRING_ID           1                    // 'mangos_string'
@@ -165,7 +168,8 @@ struct MangosStringLocale
 };
 
 typedef std::unordered_map<uint32, CreatureSpawnTemplate> CreatureSpawnTemplateMap;
-typedef std::unordered_map<uint32 /*guid*/, CreatureData> CreatureDataMap;
+typedef std::unordered_map<uint32 /*guid*/, CreatureData, std::hash<uint32>, std::equal_to<uint32>,
+        MemoryTrackingAllocator<std::pair<const uint32, CreatureData>, MEMORY_TAG_OBJECTMGR> > CreatureDataMap;
 typedef CreatureDataMap::value_type CreatureDataPair;
 
 class FindCreatureData
@@ -188,7 +192,8 @@ class FindCreatureData
         float i_spawnedDist;
 };
 
-typedef std::unordered_map<uint32, GameObjectData> GameObjectDataMap;
+typedef std::unordered_map<uint32, GameObjectData, std::hash<uint32>, std::equal_to<uint32>,
+        MemoryTrackingAllocator<std::pair<const uint32, GameObjectData>, MEMORY_TAG_OBJECTMGR> > GameObjectDataMap;
 typedef GameObjectDataMap::value_type GameObjectDataPair;
 
 class FindGOData
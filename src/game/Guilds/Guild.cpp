@@ -101,6 +101,8 @@ Guild::Guild()
     m_GuildBankEventLogNextGuid_Money = 0;
     for (unsigned int& i : m_GuildBankEventLogNextGuid_Item)
         i = 0;
+
+    InvalidateRoster();
 }
 
 Guild::~Guild()
@@ -177,6 +179,8 @@ void Guild::CreateDefaultGuildRanks(int locale_idx)
 
 bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 {
+    InvalidateRoster();
+
     Player* pl = sObjectMgr.GetPlayer(plGuid);
     if (pl)
     {
@@ -265,6 +269,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 void Guild::SetMOTD(std::string motd)
 {
     MOTD = motd;
+    InvalidateRoster();
 
     // motd now can be used for encoding to DB
     CharacterDatabase.escape_string(motd);
@@ -274,6 +279,7 @@ void Guild::SetMOTD(std::string motd)
 void Guild::SetGINFO(std::string ginfo)
 {
     GINFO = ginfo;
+    InvalidateRoster();
 
     // ginfo now can be used for encoding to DB
     CharacterDatabase.escape_string(ginfo);
@@ -510,6 +516,7 @@ void Guild::SetLeader(ObjectGuid guid)
         return;
 
     m_LeaderGuid = guid;
+    InvalidateRoster();
     slot->ChangeRank(GR_GUILDMASTER);
 
     CharacterDatabase.PExecute("UPDATE guild SET leaderguid='%u' WHERE guildid='%u'", guid.GetCounter(), m_Id);
@@ -527,6 +534,8 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
 {
     uint32 lowguid = guid.GetCounter();
 
+    InvalidateRoster();
+
     // guild master can be deleted when loading guild and guid doesn't exist in characters table
     // or when he is removed from guild by gm command
     if (m_LeaderGuid == guid && !isDisbanding)
@@ -760,9 +769,38 @@ void Guild::Disband()
 }
 
 void Guild::Roster(WorldSession* session /*= nullptr*/)
+{
+    if (session)
+        session->SendPacket(GetRosterPacket(HasRankRight(session->GetPlayer()->GetRank(), GR_RIGHT_VIEWOFFNOTE)));
+    else
+    {
+        // broadcast used after guild changes, cached data outdated
+        InvalidateRoster();
+        BroadcastPacket(GetRosterPacket(false));
+    }
+    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
+}
+
+WorldPacket const& Guild::GetRosterPacket(bool officerNotes)
+{
+    // online members level/zone changes not tracked, so cached roster also expire in short time
+    time_t now = time(nullptr);
+    if (m_rosterCacheTime[officerNotes] && now < m_rosterCacheTime[officerNotes] + GUILD_ROSTER_CACHE_TIME)
+    {
+        ++sGuildMgr.GetCacheStatistic().rosterCached;
+        return m_rosterCache[officerNotes];
+    }
+
+    BuildRoster(m_rosterCache[officerNotes], officerNotes);
+    m_rosterCacheTime[officerNotes] = now;
+    ++sGuildMgr.GetCacheStatistic().rosterBuilds;
+    return m_rosterCache[officerNotes];
+}
+
+void Guild::BuildRoster(WorldPacket& data, bool officerNotes) const
 {
     // we can only guess size
-    WorldPacket data(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + m_Ranks.size() * (4 + 4 + GUILD_BANK_MAX_TABS * (4 + 4)) + members.size() * 50));
+    data.Initialize(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + m_Ranks.size() * (4 + 4 + GUILD_BANK_MAX_TABS * (4 + 4)) + members.size() * 50));
     data << uint32(members.size());
     data << MOTD;
     data << GINFO;
@@ -791,7 +829,7 @@ void Guild::Roster(WorldSession* session /*= nullptr*/)
             data << uint8(pl->getGender());                                     // new 2.4.0
             data << uint32(pl->GetZoneId());
             data << itr->second.Pnote;
-            data << ((session && HasRankRight(session->GetPlayer()->GetRank(), GR_RIGHT_VIEWOFFNOTE)) ? itr->second.OFFnote : "");
+            data << (officerNotes ? itr->second.OFFnote : "");
         }
         else
         {
@@ -805,14 +843,9 @@ void Guild::Roster(WorldSession* session /*= nullptr*/)
             data << uint32(itr->second.ZoneId);
             data << float(float(time(nullptr) - itr->second.LogoutTime) / DAY);
             data << itr->second.Pnote;
-            data << ((session && HasRankRight(session->GetPlayer()->GetRank(), GR_RIGHT_VIEWOFFNOTE)) ? itr->second.OFFnote : "");
+            data << (officerNotes ? itr->second.OFFnote : "");
         }
     }
-    if (session)
-        session->SendPacket(data);
-    else
-        BroadcastPacket(data);
-    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
 }
 
 void Guild::Query(WorldSession* session)
@@ -979,15 +1012,30 @@ void Guild::DisplayGuildBankContent(WorldSession* session, uint8 TabId)
     data << uint8(0);                                       // Tell client that there's no tab info in this packet
 
     data << uint8(GUILD_BANK_MAX_SLOTS);
-
-    for (int i = 0; i < GUILD_BANK_MAX_SLOTS; ++i)
-        AppendDisplayGuildBankSlot(data, tab, i);
+    data.append(GetBankTabSlotsData(TabId));
 
     session->SendPacket(data);
 
     DEBUG_LOG("WORLD: Sent (SMSG_GUILD_BANK_LIST)");
 }
 
+ByteBuffer const& Guild::GetBankTabSlotsData(uint8 TabId)
+{
+    GuildBankTab& tab = m_TabList[TabId];
+
+    if (!tab.SlotsData.empty())
+    {
+        ++sGuildMgr.GetCacheStatistic().bankTabCached;
+        return tab.SlotsData;
+    }
+
+    for (int i = 0; i < GUILD_BANK_MAX_SLOTS; ++i)
+        AppendDisplayGuildBankSlot(tab.SlotsData, tab, i);
+
+    ++sGuildMgr.GetCacheStatistic().bankTabBuilds;
+    return tab.SlotsData;
+}
+
 void Guild::DisplayGuildBankMoneyUpdate(WorldSession* session)
 {
     WorldPacket data(SMSG_GUILD_BANK_LIST, 8 + 1 + 4 + 1 + 1);
@@ -1004,6 +1052,8 @@ void Guild::DisplayGuildBankMoneyUpdate(WorldSession* session)
 
 void Guild::DisplayGuildBankContentUpdate(uint8 TabId, int32 slot1, int32 slot2)
 {
+    InvalidateBankTab(TabId);
+
     GuildBankTab const& tab = m_TabList[TabId];
 
     WorldPacket data(SMSG_GUILD_BANK_LIST, 1200);
@@ -1051,6 +1101,8 @@ void Guild::DisplayGuildBankContentUpdate(uint8 TabId, int32 slot1, int32 slot2)
 
 void Guild::DisplayGuildBankContentUpdate(uint8 TabId, GuildItemPosCountVec const& slots)
 {
+    InvalidateBankTab(TabId);
+
     GuildBankTab const& tab = m_TabList[TabId];
 
     WorldPacket data(SMSG_GUILD_BANK_LIST, 1200);
@@ -1643,7 +1695,7 @@ bool Guild::AddGBankItemToDB(uint32 GuildId, uint32 BankTab, uint32 BankTabSlot,
     return true;
 }
 
-void Guild::AppendDisplayGuildBankSlot(WorldPacket& data, GuildBankTab const& tab, int slot) const
+void Guild::AppendDisplayGuildBankSlot(ByteBuffer& data, GuildBankTab const& tab, int slot) const
 {
     Item* item = tab.Slots[slot];
     uint32 entry = item ? item->GetEntry() : 0;
@@ -1713,6 +1765,8 @@ Item* Guild::_StoreItem(uint8 tab, uint8 slot, Item* pItem, uint32 count, bool c
 
     DEBUG_LOG("GUILD STORAGE: StoreItem tab = %u, slot = %u, item = %u, count = %u", tab, slot, pItem->GetEntry(), count);
 
+    InvalidateBankTab(tab);
+
     Item* pItem2 = m_TabList[tab].Slots[slot];
 
     if (!pItem2)
@@ -1751,6 +1805,7 @@ Item* Guild::_StoreItem(uint8 tab, uint8 slot, Item* pItem, uint32 count, bool c
 
 void Guild::RemoveItem(uint8 tab, uint8 slot)
 {
+    InvalidateBankTab(tab);
     m_TabList[tab].Slots[slot] = nullptr;
     CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE guildid='%u' AND TabId='%u' AND SlotId='%u'",
                                GetId(), uint32(tab), uint32(slot));
@@ -2372,6 +2427,9 @@ ObjectGuid Guild::GetGuildInviter(ObjectGuid playerGuid) const
 
 void Guild::BroadcastEvent(GuildEvents event, ObjectGuid guid, char const* str1 /*=nullptr*/, char const* str2 /*=nullptr*/, char const* str3 /*=nullptr*/)
 {
+    // all guild events change roster content (members, ranks, online state, motd)
+    InvalidateRoster();
+
     uint8 strCount = !str1 ? 0 : (!str2 ? 1 : (!str3 ? 2 : 3));
 
     WorldPacket data(SMSG_GUILD_EVENT, 1 + 1 + 1 * strCount + (!guid ? 0 : 8));
@@ -22,10 +22,13 @@
 #define WITHDRAW_MONEY_UNLIMITED    0xFFFFFFFF
 #define WITHDRAW_SLOT_UNLIMITED     0xFFFFFFFF
 
+#define GUILD_ROSTER_CACHE_TIME     5                       // seconds, cached roster not track online members level/zone changes
+
 #include "Common.h"
 #include "Entities/Item.h"
 #include "Globals/ObjectAccessor.h"
 #include "Globals/SharedDefines.h"
+#include "Server/WorldPacket.h"
 #include "Util/UniqueTrackablePtr.h"
 
 class Item;
@@ -236,6 +239,8 @@ struct GuildBankTab
     std::string Name;
     std::string Icon;
     std::string Text;
+
+    ByteBuffer SlotsData;                                   // serialized slots for SMSG_GUILD_BANK_LIST, empty if need rebuild
 };
 
 struct GuildItemPosCount
@@ -395,6 +400,7 @@ class Guild
         }
 
         void Roster(WorldSession* session = nullptr);          // nullptr = broadcast
+        void InvalidateRoster() { m_rosterCacheTime[0] = m_rosterCacheTime[1] = 0; }
         void Query(WorldSession* session);
 
         // Guild EventLog
@@ -487,6 +493,10 @@ class Guild
 
         MaNGOS::unique_weak_ptr<Guild> m_weakRef;
 
+        // serialized roster, [0] without officer notes, [1] with officer notes
+        WorldPacket m_rosterCache[2];
+        time_t m_rosterCacheTime[2];                        // 0 - need rebuild
+
     private:
         void UpdateAccountsNumber() { m_accountsNumber = 0;}// mark for lazy calculation at request in GetAccountsNumber
 
@@ -499,7 +509,11 @@ class Guild
         void   DisplayGuildBankContentUpdate(uint8 TabId, GuildItemPosCountVec const& slots);
 
         // internal common parts for CanStore/StoreItem functions
-        void AppendDisplayGuildBankSlot(WorldPacket& data, GuildBankTab const& tab, int32 slot) const;
+        void AppendDisplayGuildBankSlot(ByteBuffer& data, GuildBankTab const& tab, int32 slot) const;
+        void BuildRoster(WorldPacket& data, bool officerNotes) const;
+        WorldPacket const& GetRosterPacket(bool officerNotes);
+        ByteBuffer const& GetBankTabSlotsData(uint8 TabId);
+        void InvalidateBankTab(uint8 TabId) { m_TabList[TabId].SlotsData.clear(); }
         InventoryResult _CanStoreItem_InSpecificSlot(uint8 tab, uint8 slot, GuildItemPosCountVec& dest, uint32& count, bool swap, Item* pSrcItem) const;
         InventoryResult _CanStoreItem_InTab(uint8 tab, GuildItemPosCountVec& dest, uint32& count, bool merge, Item* pSrcItem, uint8 skip_slot) const;
         Item* _StoreItem(uint8 tab, uint8 slot, Item* pItem, uint32 count, bool clone);
@@ -548,6 +548,7 @@ void WorldSession::HandleGuildSetPublicNoteOpcode(WorldPacket& recvPacket)
 
     slot->SetPNOTE(PNOTE);
 
+    guild->InvalidateRoster();
     guild->Roster(this);
 }
 
@@ -585,6 +586,7 @@ void WorldSession::HandleGuildSetOfficerNoteOpcode(WorldPacket& recvPacket)
 
     slot->SetOFFNOTE(OFFNOTE);
 
+    guild->InvalidateRoster();
     guild->Roster(this);
 }
 
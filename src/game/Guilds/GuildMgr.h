@@ -25,6 +25,17 @@
 class Guild;
 class ObjectGuid;
 
+/// Counters of guild packets served from cache and rebuilt
+struct GuildCacheStatistic
+{
+    GuildCacheStatistic() : rosterBuilds(0), rosterCached(0), bankTabBuilds(0), bankTabCached(0) {}
+
+    uint32 rosterBuilds;
+    uint32 rosterCached;
+    uint32 bankTabBuilds;
+    uint32 bankTabCached;
+};
+
 class GuildMgr
 {
         typedef std::unordered_map<uint32, MaNGOS::unique_trackable_ptr<Guild>> GuildMap;
@@ -43,6 +54,11 @@ class GuildMgr
         std::string GetGuildNameById(uint32 guildId) const;
 
         void LoadGuilds();
+
+        GuildCacheStatistic& GetCacheStatistic() { return m_cacheStatistic; }
+
+    private:
+        GuildCacheStatistic m_cacheStatistic;
 };
 
 #define sGuildMgr MaNGOS::Singleton<GuildMgr>::Instance()
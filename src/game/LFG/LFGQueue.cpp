@@ -25,11 +25,46 @@ void LFGQueue::Update()
     while (!World::IsStopped())
     {
         GetMessager().Execute(this);
+        m_statQueued = uint32(m_queuedPlayers.size());
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // everything here is driven by messages - sleep until one arrives, waking once per second to notice world shutdown
+        GetMessager().WaitForMessages(std::chrono::milliseconds(1000));
     };
 }
 
+void LFGQueue::AddToMatchBuckets(ObjectGuid guid, LFGPlayerQueueInfo const& info)
+{
+    if (info.autoFill && info.more.isAuto())
+        m_autoFillBuckets[MakeMatchKey(info.more.entry, info.more.type)].insert(guid);
+
+    if (info.autoJoin)
+        for (auto& slot : info.group)
+            if (slot.isAuto())
+                m_autoJoinBuckets[MakeMatchKey(slot.entry, slot.type)].insert(guid);
+}
+
+void LFGQueue::RemoveFromMatchBuckets(ObjectGuid guid, LFGPlayerQueueInfo const& info)
+{
+    auto removeFrom = [guid](MatchBucketMap& buckets, uint32 key)
+    {
+        auto itr = buckets.find(key);
+        if (itr == buckets.end())
+            return;
+
+        itr->second.erase(guid);
+        if (itr->second.empty())
+            buckets.erase(itr);
+    };
+
+    if (info.autoFill && info.more.isAuto())
+        removeFrom(m_autoFillBuckets, MakeMatchKey(info.more.entry, info.more.type));
+
+    if (info.autoJoin)
+        for (auto& slot : info.group)
+            if (slot.isAuto())
+                removeFrom(m_autoJoinBuckets, MakeMatchKey(slot.entry, slot.type));
+}
+
 void LFGQueue::SetComment(ObjectGuid playerGuid, std::string const& comment)
 {
     auto itr = m_queuedPlayers.find(playerGuid);
@@ -45,7 +80,9 @@ void LFGQueue::SetAutoFill(ObjectGuid playerGuid, bool state)
     if (itr == m_queuedPlayers.end())
         return;
 
+    RemoveFromMatchBuckets(playerGuid, itr->second);
     itr->second.autoFill = state;
+    AddToMatchBuckets(playerGuid, itr->second);
     TryFill(playerGuid, false);
 }
 
@@ -55,7 +92,9 @@ void LFGQueue::SetAutoJoin(ObjectGuid playerGuid, bool state)
     if (itr == m_queuedPlayers.end())
         return;
 
+    RemoveFromMatchBuckets(playerGuid, itr->second);
     itr->second.autoJoin = state;
+    AddToMatchBuckets(playerGuid, itr->second);
     TryJoin(playerGuid, false);
 }
 
@@ -79,7 +118,8 @@ void LFGQueue::StartLookingForMore(ObjectGuid playerGuid, LFGPlayerQueueInfo inf
         return;
     }
 
-    m_queuedPlayers.emplace(info.leaderGuid, info);
+    info.joinTime = WorldTimer::getMSTime();
+    AddToMatchBuckets(info.leaderGuid, m_queuedPlayers.emplace(info.leaderGuid, info).first->second);
 
     sWorld.GetMessager().AddMessage([playerGuid](World* /*world*/)
     {
@@ -102,6 +142,7 @@ void LFGQueue::StopLookingForMore(ObjectGuid playerGuid)
     if (itr == m_queuedPlayers.end())
         return;
 
+    RemoveFromMatchBuckets(playerGuid, itr->second);
     m_queuedPlayers.erase(itr);
 
     sWorld.GetMessager().AddMessage([playerGuid](World* /*world*/)
@@ -130,7 +171,8 @@ void LFGQueue::StartLookingForGroup(LFGPlayerQueueInfo info, ObjectGuid invokerP
         return;
     }
 
-    m_queuedPlayers.emplace(info.leaderGuid, info);
+    info.joinTime = WorldTimer::getMSTime();
+    AddToMatchBuckets(info.leaderGuid, m_queuedPlayers.emplace(info.leaderGuid, info).first->second);
 
     sWorld.GetMessager().AddMessage([invokerPlayer](World* /*world*/)
     {
@@ -151,6 +193,7 @@ void LFGQueue::StopLookingForGroup(ObjectGuid leaderGuid, ObjectGuid playerGuid)
     bool success = false;
     if (itr != m_queuedPlayers.end())
     {
+        RemoveFromMatchBuckets(leaderGuid, itr->second);
         m_queuedPlayers.erase(itr);
     }
 
@@ -170,6 +213,7 @@ void LFGQueue::SetLfgSlot(ObjectGuid leaderGuid, uint32 slot, uint16 entry, uint
         return;
 
     auto& info = itr->second;
+    RemoveFromMatchBuckets(leaderGuid, info);
     info.group[slot].set(entry, type);
 
     bool found = false;
@@ -184,6 +228,8 @@ void LFGQueue::SetLfgSlot(ObjectGuid leaderGuid, uint32 slot, uint16 entry, uint
 
     if (!found) // last slot cleared
         m_queuedPlayers.erase(itr);
+    else
+        AddToMatchBuckets(leaderGuid, info);
 
     GroupUpdateUI(leaderGuid, false);
 
@@ -204,11 +250,14 @@ void LFGQueue::SetLfmData(ObjectGuid leaderGuid, uint16 entry, uint16 type)
         return;
 
     auto& info = itr->second;
+    RemoveFromMatchBuckets(leaderGuid, info);
     info.more.set(entry, type);
 
     bool found = !info.more.empty();
     if (!found) // last slot cleared
         m_queuedPlayers.erase(itr);
+    else
+        AddToMatchBuckets(leaderGuid, info);
 
     GroupUpdateUI(leaderGuid, false);
 
@@ -232,17 +281,24 @@ void LFGQueue::TryJoin(ObjectGuid playerGuid, bool initial)
 
     bool attempted = false;
 
-    for (auto& queueData : m_queuedPlayers)
+    // only autofill leaders looking for more for one of our automatic slots can fit
+    std::set<ObjectGuid> candidates;
+    for (auto& slot : info.group)
     {
-        if (!queueData.second.autoFill)
+        if (!slot.isAuto())
             continue;
 
-        // skip not fitting slots
-        if (!info.isLFG(queueData.second, true))
-            continue;
+        auto bucket = m_autoFillBuckets.find(MakeMatchKey(slot.entry, slot.type));
+        if (bucket != m_autoFillBuckets.end())
+            candidates.insert(bucket->second.begin(), bucket->second.end());
+    }
+
+    for (ObjectGuid leaderGuid : candidates)
+    {
+        auto& leaderInfo = m_queuedPlayers.at(leaderGuid);
 
         // stop at join success
-        if (AddMember(queueData.second, info, queueData.second.more.entry))
+        if (AddMember(leaderInfo, info, leaderInfo.more.entry))
             break;
         else if (info.members.empty())
             attempted = true;
@@ -268,20 +324,18 @@ void LFGQueue::TryFill(ObjectGuid leaderGuid, bool initial)
 
     bool attempted = false;
 
-    for (auto& queueData : m_queuedPlayers)
+    // only autojoin players with an automatic slot for our dungeon can fit
+    auto bucket = m_autoJoinBuckets.find(MakeMatchKey(info.more.entry, info.more.type));
+    if (bucket != m_autoJoinBuckets.end())
     {
-        if (!queueData.second.autoJoin)
-            continue;
-
-        // skip not fitting slots
-        if (!queueData.second.isLFG(info, true))
-            continue;
-
-        // stop at false result (full?)
-        if (!AddMember(info, queueData.second, info.more.entry))
+        for (ObjectGuid playerGuid : bucket->second)
         {
-            attempted = true;
-            break;
+            // stop at false result (full?)
+            if (!AddMember(info, m_queuedPlayers.at(playerGuid), info.more.entry))
+            {
+                attempted = true;
+                break;
+            }
         }
     }
 
@@ -457,7 +511,12 @@ void LFGQueue::PendingJoinSuccess(ObjectGuid leaderGuid, ObjectGuid playerGuid,
         leaderItr->second.pendingMembers.erase(std::remove(leaderItr->second.pendingMembers.begin(), leaderItr->second.pendingMembers.end(), playerGuid), leaderItr->second.pendingMembers.end());
         if (playerItr != m_queuedPlayers.end())
         {
+            // time from joining the queue to being matched into the group
+            ++m_statMatched;
+            m_statMatchWaitTime += WorldTimer::getMSTimeDiff(playerItr->second.joinTime, WorldTimer::getMSTime());
+
             leaderItr->second.members.emplace_back(playerGuid, playerItr->second.level);
+            RemoveFromMatchBuckets(playerGuid, playerItr->second);
             m_queuedPlayers.erase(playerItr);
             erasedPlayer = true;
         }
@@ -468,7 +527,10 @@ void LFGQueue::PendingJoinSuccess(ObjectGuid leaderGuid, ObjectGuid playerGuid,
     }
 
     if (full && leaderItr != m_queuedPlayers.end())
+    {
+        RemoveFromMatchBuckets(leaderGuid, leaderItr->second);
         m_queuedPlayers.erase(leaderItr);
+    }
 
     GroupUpdate(leaderGuid, playerGuid, full);
 
@@ -23,6 +23,8 @@
 #include "Entities/ObjectGuid.h"
 #include "Globals/ObjectMgr.h"
 
+#include <atomic>
+
 struct LFGGroupQueueInfo
 {
     ObjectGuid partyMember;
@@ -87,6 +89,7 @@ struct LFGPlayerQueueInfo
     bool full = false;
     uint32 level = 0;
     uint32 zoneId = 0;
+    uint32 joinTime = 0;                                    // queue thread time at which the entry was queued
     bool status = false;
     ObjectGuid leaderGuid;
 
@@ -145,10 +148,29 @@ class LFGQueue
 
         Messager<LFGQueue>& GetMessager() { return m_messager; }
 
+        // matching statistics, updated by the queue thread and read by .lfg stats
+        uint32 GetQueuedCount() const { return m_statQueued; }
+        uint64 GetMatchedCount() const { return m_statMatched; }
+        uint64 GetMatchWaitTime() const { return m_statMatchWaitTime; }
+
     private:
         typedef std::map<ObjectGuid, LFGPlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_queuedPlayers;
 
+        // automatic join/fill candidates per dungeon, so matching only visits entries queued for the same dungeon
+        typedef std::map<uint32, std::set<ObjectGuid>> MatchBucketMap;
+        MatchBucketMap m_autoFillBuckets;                   // autofill leaders, by their LFM slot
+        MatchBucketMap m_autoJoinBuckets;                   // autojoin players, by each of their automatic LFG slots
+
+        static uint32 MakeMatchKey(uint16 entry, uint16 type) { return uint32(entry) | (uint32(type) << 16); }
+        // must be called before and after every change of a queued entry's slots or auto flags
+        void AddToMatchBuckets(ObjectGuid guid, LFGPlayerQueueInfo const& info);
+        void RemoveFromMatchBuckets(ObjectGuid guid, LFGPlayerQueueInfo const& info);
+
+        std::atomic<uint32> m_statQueued{0};
+        std::atomic<uint64> m_statMatched{0};
+        std::atomic<uint64> m_statMatchWaitTime{0};
+
         Messager<LFGQueue> m_messager;
 };
 
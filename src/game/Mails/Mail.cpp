@@ -293,20 +293,7 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
     uint32 mailId = sObjectMgr.GenerateMailID();
 
     time_t deliver_time = time(nullptr) + deliver_delay;
-
-    // expire time if COD 3 days, if no COD 30 days, if auction sale pending 1 hour
-    uint32 expire_delay;
-    // auction mail without any items and money (auction sale note) pending 1 hour
-    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
-        expire_delay = HOUR;
-    // mail from battlemaster (rewardmarks) should last only one day
-    else if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
-        expire_delay = DAY;
-    // default case: expire time if COD 3 days, if no COD 30 days
-    else
-        expire_delay = (m_COD > 0) ? 3 * DAY : 30 * DAY;
-
-    time_t expire_time = deliver_time + expire_delay;
+    time_t expire_time = deliver_time + GetExpireDelay(sender);
 
     // Add to DB
     std::string safe_subject = GetSubject();
@@ -365,6 +352,72 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         deleteIncludedItems();
 }
 
+/**
+ * Prepares a mail to an offline receiver as rows of multi-row INSERT statements.
+ * Used by the mass mailer, the caller is responsible for executing the statements.
+ * As in SendMailTo, the included items are deleted if the receiver does not exist (anymore).
+ *
+ * @param receiver_guid        The GUID of the (offline) receiver.
+ * @param sender               The MailSender from which this mail is originated.
+ * @param checked              The mask used to specify the mail.
+ * @param mailRows             Stream that receives the row for mail table.
+ * @param itemRows             Stream that receives the rows for mail_items table.
+ * @return                     false if the receiver does not exist and nothing was appended.
+ */
+bool MailDraft::AppendMailRows(ObjectGuid receiver_guid, MailSender const& sender, MailCheckMask checked, std::ostringstream& mailRows, std::ostringstream& itemRows)
+{
+    // the receivers are selected when the task is added, the character can be deleted since
+    if (!sObjectMgr.GetPlayerAccountIdByGUID(receiver_guid))
+    {
+        deleteIncludedItems(true);
+        return false;
+    }
+
+    uint32 mailId = sObjectMgr.GenerateMailID();
+
+    time_t deliver_time = time(nullptr);
+    time_t expire_time = deliver_time + GetExpireDelay(sender);
+
+    std::string safe_subject = GetSubject();
+    CharacterDatabase.escape_string(safe_subject);
+
+    if (mailRows.tellp() > 0)
+        mailRows << ",";
+    mailRows << "('" << mailId << "', '" << uint32(sender.GetMailMessageType()) << "', '" << uint32(sender.GetStationery()) << "', '" << GetMailTemplateId()
+             << "', '" << sender.GetSenderId() << "', '" << receiver_guid.GetCounter() << "', '" << safe_subject << "', '" << GetBodyId()
+             << "', '" << (m_items.empty() ? 0 : 1) << "', '" << uint64(expire_time) << "', '" << uint64(deliver_time)
+             << "', '" << m_money << "', '" << m_COD << "', '" << uint32(checked) << "')";
+
+    for (MailItemMap::const_iterator mailItemIter = m_items.begin(); mailItemIter != m_items.end(); ++mailItemIter)
+    {
+        Item* item = mailItemIter->second;
+        if (itemRows.tellp() > 0)
+            itemRows << ",";
+        itemRows << "('" << mailId << "', '" << item->GetGUIDLow() << "', '" << item->GetEntry() << "', '" << receiver_guid.GetCounter() << "')";
+    }
+
+    // items already saved in DB, will be loaded at receiver login
+    deleteIncludedItems();
+    return true;
+}
+
+/**
+ * Returns the time after delivery at which the mail expires.
+ *
+ * @param sender               The MailSender from which this mail is originated.
+ */
+uint32 MailDraft::GetExpireDelay(MailSender const& sender) const
+{
+    // auction mail without any items and money (auction sale note) pending 1 hour
+    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
+        return HOUR;
+    // mail from battlemaster (rewardmarks) should last only one day
+    if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
+        return DAY;
+    // default case: expire time if COD 3 days, if no COD 30 days
+    return (m_COD > 0) ? 3 * DAY : 30 * DAY;
+}
+
 /**
  * Generate items from template at mails loading (this happens when mail with mail template items send in time when receiver has been offline)
  *
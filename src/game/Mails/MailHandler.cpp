@@ -28,6 +28,8 @@
 #include "Mails/Mail.h"
 #include "Tools/Language.h"
 #include "Log/Log.h"
+#include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Entities/ObjectGuid.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/Item.h"
@@ -392,7 +394,7 @@ void WorldSession::HandleMailReturnToSender(WorldPacket& recv_data)
 
     Player* pl = _player;
     Mail* m = pl->GetMail(mailId);
-    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > time(nullptr))
+    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > time(nullptr) || !pl->HasMailedItemsLoaded(m))
     {
         pl->SendMailResult(mailId, MAIL_RETURNED_TO_SENDER, MAIL_ERR_INTERNAL_ERROR);
         return;
@@ -465,7 +467,13 @@ void WorldSession::HandleMailTakeItem(WorldPacket& recv_data)
         return;
     }
 
+    // item instance is loaded at mail list request
     Item* it = pl->GetMItem(itemId);
+    if (!it)
+    {
+        pl->SendMailResult(mailId, MAIL_ITEM_TAKEN, MAIL_ERR_INTERNAL_ERROR);
+        return;
+    }
 
     ItemPosCountVec dest;
     InventoryResult msg = _player->CanStoreItem(NULL_BAG, NULL_SLOT, dest, it, false);
@@ -580,6 +588,78 @@ void WorldSession::HandleGetMailList(WorldPacket& recv_data)
     if (!CheckMailBox(mailboxGuid))
         return;
 
+    // list will be sent at result of already requested items
+    if (_player->m_mailItemsLoading)
+        return;
+
+    // item instances are loaded only for mails visible in client inbox page
+    std::ostringstream mailIds;
+    uint32 mailsCount = 0;
+    time_t cur_time = time(nullptr);
+
+    for (PlayerMails::iterator itr = _player->GetMailBegin(); itr != _player->GetMailEnd() && mailsCount < MAX_INBOX_CLIENT_UI_CAPACITY; ++itr)
+    {
+        if ((*itr)->state == MAIL_STATE_DELETED || cur_time < (*itr)->deliver_time)
+            continue;
+
+        ++mailsCount;
+
+        if (_player->HasMailedItemsLoaded(*itr))
+            continue;
+
+        if (mailIds.tellp() > 0)
+            mailIds << ",";
+        mailIds << (*itr)->messageID;
+    }
+
+    if (mailIds.tellp() == 0)
+    {
+        SendMailList();
+        return;
+    }
+
+    static char const* const mailedItemsQuery =
+        "SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template "
+        "FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u' AND mail_id IN (%s)";
+
+    _player->m_mailItemsLoading = true;
+
+    if (!CharacterDatabase.AsyncPQuery(&WorldSession::HandleGetMailListCallBack, GetAccountId(), mailboxGuid, mailedItemsQuery, _player->GetGUIDLow(), mailIds.str().c_str()))
+    {
+        // query could not be queued, so no callback will clear the flag and send the list
+        _player->m_mailItemsLoading = false;
+
+        auto queryResult = CharacterDatabase.PQuery(mailedItemsQuery, _player->GetGUIDLow(), mailIds.str().c_str());
+        _player->LoadMailedItems(queryResult.get());
+        SendMailList();
+    }
+}
+
+void WorldSession::HandleGetMailListCallBack(QueryResult* result, uint32 accountId, ObjectGuid mailboxGuid)
+{
+    WorldSession* session = sWorld.FindSession(accountId);
+    Player* player = session ? session->GetPlayer() : nullptr;
+    if (!player)
+    {
+        delete result;
+        return;
+    }
+
+    player->LoadMailedItems(result);
+    player->m_mailItemsLoading = false;
+    delete result;
+
+    // player can leave mailbox while items loading
+    if (session->CheckMailBox(mailboxGuid))
+        session->SendMailList();
+}
+
+/**
+ * Sends the list of all available mails in the players mailbox to the client.
+ * Item instances of listed mails must be loaded already.
+ */
+void WorldSession::SendMailList()
+{
     uint32 mailsCount = 0;                                  // send to client mails amount
 
     WorldPacket data(SMSG_MAIL_LIST_RESULT, (200));         // guess size
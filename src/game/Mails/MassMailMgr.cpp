@@ -35,6 +35,8 @@
 
 INSTANTIATE_SINGLETON_1(MassMailMgr);
 
+#define MASS_MAIL_INSERT_BATCH_SIZE 500                     // rows per multi-row insert, keep statement size reasonable
+
 void MassMailMgr::AddMassMailTask(MailDraft* mailProto, const MailSender& sender, uint32 raceMask)
 {
     if (RACEMASK_ALL_PLAYABLE & ~raceMask)                  // have races not included in mask
@@ -78,6 +80,9 @@ void MassMailMgr::Update(bool sendall /*= false*/)
 
     uint32 maxcount = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK);
 
+    // mails to offline receivers collected into multi-row inserts
+    MassMailBatch batch;
+
     do
     {
         MassMail& task = m_massMails.front();
@@ -94,7 +99,10 @@ void MassMailMgr::Update(bool sendall /*= false*/)
             if (task.m_receivers.empty())
             {
                 // prevent mail return
-                task.m_protoMail->SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+                if (receiver)
+                    task.m_protoMail->SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+                else
+                    batch.Append(*task.m_protoMail, receiver_guid, task.m_sender);
 
                 if (!sendall)
                     --maxcount;
@@ -106,7 +114,10 @@ void MassMailMgr::Update(bool sendall /*= false*/)
             draft.CloneFrom(*task.m_protoMail);
 
             // prevent mail return
-            draft.SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+            if (receiver)
+                draft.SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+            else
+                batch.Append(draft, receiver_guid, task.m_sender);
 
             if (!sendall)
                 --maxcount;
@@ -116,6 +127,33 @@ void MassMailMgr::Update(bool sendall /*= false*/)
             m_massMails.pop_front();
     }
     while (!m_massMails.empty() && (sendall || maxcount > 0));
+
+    batch.Flush();
+}
+
+void MassMailMgr::MassMailBatch::Append(MailDraft& draft, ObjectGuid receiver_guid, MailSender const& sender)
+{
+    if (!draft.AppendMailRows(receiver_guid, sender, MAIL_CHECK_MASK_RETURNED, m_mailRows, m_itemRows))
+        return;
+
+    if (++m_count >= MASS_MAIL_INSERT_BATCH_SIZE)
+        Flush();
+}
+
+void MassMailMgr::MassMailBatch::Flush()
+{
+    if (!m_count)
+        return;
+
+    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.Execute(("INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,itemTextId,has_items,expire_time,deliver_time,money,cod,checked) VALUES " + m_mailRows.str()).c_str());
+    if (m_itemRows.tellp() > 0)
+        CharacterDatabase.Execute(("INSERT INTO mail_items (mail_id,item_guid,item_template,receiver) VALUES " + m_itemRows.str()).c_str());
+    CharacterDatabase.CommitTransaction();
+
+    m_mailRows.str("");
+    m_itemRows.str("");
+    m_count = 0;
 }
 
 void MassMailMgr::GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) const
@@ -112,6 +112,21 @@ class MassMailMgr
 
         typedef std::list<MassMail> MassMailList;
 
+        /// Collects mails to offline receivers and stores them by multi-row inserts
+        class MassMailBatch
+        {
+            public:
+                MassMailBatch() : m_count(0) {}
+
+                void Append(MailDraft& draft, ObjectGuid receiver_guid, MailSender const& sender);
+                void Flush();
+
+            private:
+                std::ostringstream m_mailRows;
+                std::ostringstream m_itemRows;
+                uint32 m_count;
+        };
+
         /// List of current queued mass mail tasks
         MassMailList m_massMails;
 };
@@ -28,6 +28,7 @@
 #include "World/World.h"
 #include "Policies/Singleton.h"
 #include "Util/Util.h"
+#include "Util/MemoryTracker.h"
 
 #include <mutex>
 
@@ -67,6 +68,7 @@ GridMap::GridMap(): m_gridIntHeightMultiplier(0)
     m_liquidEntry = nullptr;
     m_liquid_map  = nullptr;
     m_fullyLoaded = false;
+    m_dataSize = 0;
 }
 
 GridMap::~GridMap()
@@ -150,6 +152,21 @@ void GridMap::unloadData()
     m_liquidFlags = nullptr;
     m_liquid_map  = nullptr;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
+
+    if (m_dataSize)
+    {
+        MemoryTracker::Free(MEMORY_TAG_TERRAIN, m_dataSize);
+        m_dataSize = 0;
+    }
+}
+
+template<typename T>
+T* GridMap::allocateData(uint32 count)
+{
+    // all arrays of a grid are freed together in unloadData(), so they count as one allocation
+    MemoryTracker::Allocate(MEMORY_TAG_TERRAIN, sizeof(T) * count, m_dataSize ? 0 : 1);
+    m_dataSize += sizeof(T) * count;
+    return new T[count];
 }
 
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
@@ -163,7 +180,7 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
+        m_area_map = allocateData<uint16>(16 * 16);
         fread(m_area_map, sizeof(uint16), 16 * 16, in);
     }
 
@@ -183,8 +200,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
+            m_uint16_V9 = allocateData<uint16>(129 * 129);
+            m_uint16_V8 = allocateData<uint16>(128 * 128);
             fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
             fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
@@ -192,8 +209,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
+            m_uint8_V9 = allocateData<uint8>(129 * 129);
+            m_uint8_V8 = allocateData<uint8>(128 * 128);
             fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
             fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
@@ -201,8 +218,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
+            m_V9 = allocateData<float>(129 * 129);
+            m_V8 = allocateData<float>(128 * 128);
             fread(m_V9, sizeof(float), 129 * 129, in);
             fread(m_V8, sizeof(float), 128 * 128, in);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
@@ -242,16 +259,16 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
+        m_liquidEntry = allocateData<uint16>(16 * 16);
         fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
 
-        m_liquidFlags = new uint8[16 * 16];
+        m_liquidFlags = allocateData<uint8>(16 * 16);
         fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
+        m_liquid_map = allocateData<float>(m_liquid_width * m_liquid_height);
         fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
     }
 
@@ -83,6 +83,11 @@ class GridMap
         // For fast check
         bool m_fullyLoaded;
 
+        // bytes of the arrays above, accounted to the terrain memory tag
+        uint32 m_dataSize;
+
+        template<typename T>
+        T* allocateData(uint32 count);
         bool loadAreaData(FILE* in, uint32 offset, uint32 size);
         bool loadHeightData(FILE* in, uint32 offset, uint32 size);
         bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
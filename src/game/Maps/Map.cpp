@@ -40,9 +40,10 @@
 #include "Weather/Weather.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "BattleGround/BattleGroundMgr.h"
+#include "Util/Tracer.h"
 
 #ifdef BUILD_METRICS
- #include "Metric/Metric.h"
+ #include "Metric/MetricRegistry.h"
 #endif
 
 #ifdef ENABLE_PLAYERBOTS
@@ -51,6 +52,24 @@
 
 #include <time.h>
 
+#ifdef BUILD_METRICS
+// registered once per map, so updates never have to build tags
+struct MapMetrics
+{
+    explicit MapMetrics(metric::tag_set const& tags) :
+        update("map.update", tags, metric::histogram::exponential_bounds(100, 2, 16)),
+        sessionUpdate("map.update.session", tags, metric::histogram::exponential_bounds(100, 2, 16)),
+        updatedObjects("map.update.objects", tags),
+        updatedSessions("map.update.sessions", tags)
+    {}
+
+    metric::histogram update;                               // microseconds
+    metric::histogram sessionUpdate;                        // microseconds
+    metric::gauge updatedObjects;                           // objects updated by the last tick
+    metric::gauge updatedSessions;                          // sessions updated by the last tick
+};
+#endif
+
 Map::~Map()
 {
     UnloadAll(true);
@@ -170,6 +189,9 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_activeZonesTimer(0), hasRealPlayers(false),
 #endif
       m_variableManager(this), m_defaultLight(GetDefaultMapLight(id))
+#ifdef BUILD_METRICS
+      , m_metrics(std::make_unique<MapMetrics>(metric::tag_set{ { "map_id", std::to_string(id) }, { "instance_id", std::to_string(InstanceId) } }))
+#endif
 {
     m_weatherSystem = new WeatherSystem(this);
 }
@@ -215,6 +237,11 @@ void Map::Initialize(bool loadInstanceData /*= true*/)
             MMAP::MMapFactory::createOrGetMMapManager()->loadAllMapTiles(sWorld.GetDataPath(), GetId());
     }
 
+    LoadActiveObjects();
+}
+
+void Map::LoadActiveObjects()
+{
     sObjectMgr.LoadActiveEntities(this);
 
     LoadTransports();
@@ -388,6 +415,7 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         // active object A(loaded with loader.LoadN call and added to the  map)
         // summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        TraceSpan span("map", "LoadGrid", "x", cell.GridX(), "y", cell.GridY());
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
 
@@ -687,11 +715,9 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
 
 void Map::Update(const uint32& t_diff)
 {
+    TraceSpan updateSpan("map", "Map::Update", "map", GetId(), "instance", GetInstanceId());
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::milliseconds> meas("map.update", {
-        { "map_id", std::to_string(i_id) },
-        { "instance_id", std::to_string(i_InstanceId) }
-});
+    metric::timer<std::chrono::microseconds> meas(m_metrics->update);
 #endif
 
     m_curTime = time(nullptr);
@@ -727,12 +753,10 @@ void Map::Update(const uint32& t_diff)
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     {
+        TraceSpan span("map", "Sessions");
 #ifdef BUILD_METRICS
         uint32 updatedSessions = 0;
-        metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
-            { "map_id", std::to_string(i_id) },
-            { "instance_id", std::to_string(i_InstanceId) },
-            });
+        metric::timer<std::chrono::microseconds> sessions_meas(m_metrics->sessionUpdate);
 #endif
 
         for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -749,7 +773,7 @@ void Map::Update(const uint32& t_diff)
 #endif
         }
 #ifdef BUILD_METRICS
-        sessions_meas.add_field("count", std::to_string(static_cast<int32>(updatedSessions)));
+        m_metrics->updatedSessions.set(updatedSessions);
 #endif
     }
 
@@ -815,6 +839,7 @@ void Map::Update(const uint32& t_diff)
 #endif
 
     /// update players at tick
+    TraceSpan playersSpan("map", "Players", "players", m_mapRefManager.getSize());
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* plr = m_mapRefIter->getSource();
@@ -876,6 +901,8 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    playersSpan.Stop();
+
 #ifdef ENABLE_PLAYERBOTS
     // Log the active zones and characters
     if (IsContinent() && HasRealPlayers() && HasActiveZones() && m_activeZonesTimer == 0U)
@@ -885,6 +912,7 @@ void Map::Update(const uint32& t_diff)
     }
 #endif
 
+    TraceSpan objectsSpan("map", "Objects");
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->getSource();
@@ -993,17 +1021,22 @@ void Map::Update(const uint32& t_diff)
         ++count;
     }
 
+    objectsSpan.Stop();
 #ifdef BUILD_METRICS
-    meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    m_metrics->updatedObjects.set(int64(count));
 #endif
 
     // Send world objects and item update field changes
-    SendObjectUpdates();
+    {
+        TraceSpan span("map", "SendObjectUpdates");
+        SendObjectUpdates();
+    }
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        TraceSpan span("map", "GridStates");
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -1016,7 +1049,10 @@ void Map::Update(const uint32& t_diff)
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
+    {
+        TraceSpan span("map", "ScriptsProcess");
         ScriptsProcess();
+    }
 
     if (i_data)
         i_data->Update(t_diff);
@@ -2135,7 +2171,7 @@ DungeonPersistentState* DungeonMap::GetPersistanceState() const
 /* ******* Battleground Instance Maps ******* */
 
 BattleGroundMap::BattleGroundMap(uint32 id, time_t expiry, uint32 InstanceId, uint8 spawnMode)
-    : Map(id, expiry, InstanceId, spawnMode)
+    : Map(id, expiry, InstanceId, spawnMode), m_bg(nullptr)
 {
 }
 
@@ -2148,6 +2184,15 @@ void BattleGroundMap::Initialize(bool)
     Map::Initialize(false);
 }
 
+void BattleGroundMap::LoadActiveObjects()
+{
+    // spawns notify the battleground on creation, pooled maps load them once they are bound to one
+    if (!m_bg)
+        return;
+
+    Map::LoadActiveObjects();
+}
+
 void BattleGroundMap::Update(const uint32& diff)
 {
     Map::Update(diff);
@@ -63,6 +63,9 @@ class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
 class Transport;
+#ifdef BUILD_METRICS
+struct MapMetrics;
+#endif
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -148,6 +151,8 @@ class Map : public GridRefManager<NGridType>
         }
 
         virtual void Initialize(bool loadInstanceData = true);
+        /// Force loaded grids of active entities and the map's transports, last step of Initialize
+        virtual void LoadActiveObjects();
 
         virtual bool Add(Player*);
         virtual void Remove(Player*, bool);
@@ -571,6 +576,10 @@ class Map : public GridRefManager<NGridType>
         ZoneDynamicInfoMap m_zoneDynamicInfo;
         ZoneDynamicInfoMap m_areaDynamicInfo;
         uint32 m_defaultLight;
+
+#ifdef BUILD_METRICS
+        std::unique_ptr<MapMetrics> m_metrics;
+#endif
 };
 
 class WorldMap : public Map
@@ -622,6 +631,7 @@ class BattleGroundMap : public Map
         ~BattleGroundMap();
 
         virtual void Initialize(bool) override;
+        void LoadActiveObjects() override;
         void Update(const uint32&) override;
         bool Add(Player*) override;
         void Remove(Player*, bool) override;
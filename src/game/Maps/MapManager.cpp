@@ -28,14 +28,37 @@
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
 #include "BattleGround/BattleGroundMgr.h"
+#include <chrono>
 #include <future>
 
+// a reserved map whose battleground was not created by then (invite aborted, queue changed) is unloaded
+#define BG_MAP_RESERVATION_TIMEOUT std::chrono::seconds(60)
+
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 
+// holds the manager lock and accounts how long it was held
+class MapManager::TimedGuard
+{
+    public:
+        explicit TimedGuard(MapManager& mgr) : m_guard(mgr), m_mgr(mgr), m_start(std::chrono::steady_clock::now()) {}
+        ~TimedGuard()
+        {
+            m_mgr.AddLockHoldTime(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+    private:
+        Guard m_guard;
+        MapManager& m_mgr;
+        std::chrono::steady_clock::time_point m_start;
+};
+
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)),
+      m_bgMapPoolHits(0), m_bgMapPoolMisses(0), m_bgMapCreateCount(0), m_bgMapCreateTime(0),
+      m_instanceCreateCount(0), m_instanceCreateTime(0),
+      m_lockHoldCount(0), m_lockHoldTime(0), m_lockHoldMaxTime(0)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
@@ -112,8 +135,6 @@ void MapManager::CreateContinents()
 /// @param id - MapId of the to be created map. @param obj WorldObject for which the map is to be created. Must be player for Instancable maps.
 Map* MapManager::CreateMap(uint32 id, const WorldObject* obj)
 {
-    Guard _guard(*this);
-
     Map* m = nullptr;
 
     const MapEntry* entry = sMapStore.LookupEntry(id);
@@ -123,11 +144,13 @@ Map* MapManager::CreateMap(uint32 id, const WorldObject* obj)
     if (entry->Instanceable())
     {
         MANGOS_ASSERT(obj && obj->GetTypeId() == TYPEID_PLAYER);
-        // create DungeonMap object
+        // create DungeonMap object, takes the lock only to register the map
         m = CreateInstance(id, (Player*)obj);
     }
     else
     {
+        TimedGuard _guard(*this);
+
         uint32 instanceId = 0;
         // create regular non-instanceable map
         m = FindMap(id);
@@ -152,7 +175,6 @@ Map* MapManager::CreateBgMap(uint32 mapid, uint32 instanceId, BattleGround* bg)
 {
     sTerrainMgr.LoadTerrain(mapid);
 
-    Guard _guard(*this);
     return CreateBattleGroundMap(mapid, instanceId, bg);
 }
 
@@ -176,18 +198,19 @@ Map* MapManager::FindMap(uint32 mapid, uint32 instanceId) const
 
 void MapManager::DeleteInstance(uint32 mapid, uint32 instanceId)
 {
-    Guard _guard(*this);
-
-    MapMapType::iterator iter = i_maps.find(MapID(mapid, instanceId));
-    if (iter != i_maps.end())
+    MapMapType::node_type node;
     {
-        if (iter->second->Instanceable())
-        {
-            auto node = i_maps.extract(iter);
+        TimedGuard _guard(*this);
 
-            node.mapped()->UnloadAll(true);
-        }
+        MapMapType::iterator iter = i_maps.find(MapID(mapid, instanceId));
+        if (iter == i_maps.end() || !iter->second->Instanceable())
+            return;
+
+        node = i_maps.extract(iter);
     }
+
+    // the map is no longer reachable, unload it without blocking other users of the manager
+    node.mapped()->UnloadAll(true);
 }
 
 void MapManager::Update(uint32 diff)
@@ -196,6 +219,8 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    FillBgMapPool();
+
     for (auto& map : i_maps)
     {
         if (m_updater.activated())
@@ -250,6 +275,8 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    UnloadBgMapPool();
+
     for (auto& i_map : i_maps)
         i_map.second->UnloadAll(true);
 
@@ -299,13 +326,21 @@ uint32 MapManager::GetNumPlayersInInstances()
     return ret;
 }
 
+void MapManager::AddLockHoldTime(uint64 holdTime)
+{
+    ++m_lockHoldCount;
+    m_lockHoldTime += holdTime;
+
+    uint64 maxTime = m_lockHoldMaxTime;
+    while (holdTime > maxTime && !m_lockHoldMaxTime.compare_exchange_weak(maxTime, holdTime)) {}
+}
+
 ///// returns a new or existing Instance
 ///// in case of battlegrounds it will only return an existing map, those maps are created by bg-system
 Map* MapManager::CreateInstance(uint32 id, Player* player)
 {
-    Map* map = nullptr;
-    Map* pNewMap = nullptr;
     uint32 NewInstanceId = 0;                               // instanceId of the resulting map
+    Difficulty diff = DUNGEON_DIFFICULTY_NORMAL;
     const MapEntry* entry = sMapStore.LookupEntry(id);
 
     if (entry->IsBattleGroundOrArena())
@@ -313,38 +348,43 @@ Map* MapManager::CreateInstance(uint32 id, Player* player)
         // find existing bg map for player
         NewInstanceId = player->GetBattleGroundId();
         MANGOS_ASSERT(NewInstanceId);
-        map = FindMap(id, NewInstanceId);
+        Map* map = FindMap(id, NewInstanceId);
         MANGOS_ASSERT(map);
+        return map;
     }
-    else if (DungeonPersistentState* pSave = player->GetBoundInstanceSaveForSelfOrGroup(id))
+
+    DungeonPersistentState* pSave = player->GetBoundInstanceSaveForSelfOrGroup(id);
+    if (pSave)
     {
         // solo/perm/group
         NewInstanceId = pSave->GetInstanceId();
-        map = FindMap(id, NewInstanceId);
-        // it is possible that the save exists but the map doesn't
-        if (!map)
-            pNewMap = CreateDungeonMap(id, NewInstanceId, pSave->GetDifficulty(), pSave);
+        diff = pSave->GetDifficulty();
     }
     else
     {
         // if no instanceId via group members or instance saves is found
         // the instance will be created for the first time
         NewInstanceId = GenerateInstanceId();
-
-        Difficulty diff = player->GetGroup() ? player->GetGroup()->GetDifficulty() : player->GetDifficulty();
-        pNewMap = CreateDungeonMap(id, NewInstanceId, diff);
+        diff = player->GetGroup() ? player->GetGroup()->GetDifficulty() : player->GetDifficulty();
     }
 
-    // add a new map object into the registry
-    if (pNewMap)
-    {
-        MaNGOS::unique_trackable_ptr<Map>& ptr = i_maps[MapID(id, NewInstanceId)];
-        ptr.reset(pNewMap);
-        pNewMap->SetWeakPtr(ptr);
-        map = pNewMap;
-    }
+    // it is possible that the save exists but the map doesn't
+    if (Map* map = FindMap(id, NewInstanceId))
+        return map;
 
-    return map;
+    // preparation phase, the map loads its instance data and spawns without holding the manager lock
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    DungeonMap* pNewMap = CreateDungeonMap(id, NewInstanceId, diff, pSave);
+    ++m_instanceCreateCount;
+    m_instanceCreateTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // commit phase, add the new map object into the registry
+    TimedGuard _guard(*this);
+    MaNGOS::unique_trackable_ptr<Map>& ptr = i_maps[MapID(id, NewInstanceId)];
+    ptr.reset(pNewMap);
+    pNewMap->SetWeakPtr(ptr);
+
+    return pNewMap;
 }
 
 DungeonMap* MapManager::CreateDungeonMap(uint32 id, uint32 InstanceId, Difficulty difficulty, DungeonPersistentState* save)
@@ -381,26 +421,174 @@ BattleGroundMap* MapManager::CreateBattleGroundMap(uint32 id, uint32 InstanceId,
 {
     DEBUG_LOG("MapInstanced::CreateBattleGroundMap: instance:%d for map:%d and bgType:%d created.", InstanceId, id, bg->GetTypeId());
 
-    uint8 spawnMode = uint8(DUNGEON_DIFFICULTY_NORMAL);
-    if (bg->GetTypeId() == BATTLEGROUND_AV && sBattleGroundMgr.GetMinLevelForBattleGroundBracketId(bg->GetBracketId(), bg->GetTypeId()) >= 61)
-        spawnMode = uint8(DUNGEON_DIFFICULTY_HEROIC);        
+    BattleGroundMap* map = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+        auto itr = m_reservedBgMaps.find(InstanceId);
+        if (itr != m_reservedBgMaps.end())
+        {
+            map = itr->second.map;
+            m_reservedBgMaps.erase(itr);
+        }
+    }
+
+    if (map)
+    {
+        map->SetBG(bg);
+        bg->SetBgMap(map);
+
+        // skipped while the pooled map had no battleground to notify of its spawns
+        map->LoadActiveObjects();
+    }
+    else
+        map = InitializeBattleGroundMap(id, InstanceId, sBattleGroundMgr.GetBattleGroundSpawnMode(bg->GetTypeId(), bg->GetBracketId()), bg);
 
-    BattleGroundMap* map = new BattleGroundMap(id, i_gridCleanUpDelay, InstanceId, spawnMode);
     MANGOS_ASSERT(map->IsBattleGroundOrArena());
-    map->SetBG(bg);
-    bg->SetBgMap(map);
 
     // add map into map container
+    TimedGuard _guard(*this);
     MaNGOS::unique_trackable_ptr<Map>& ptr = i_maps[MapID(id, InstanceId)];
     ptr.reset(map);
     map->SetWeakPtr(ptr);
 
+    return map;
+}
+
+BattleGroundMap* MapManager::InitializeBattleGroundMap(uint32 id, uint32 InstanceId, uint8 spawnMode, BattleGround* bg)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    BattleGroundMap* map = new BattleGroundMap(id, i_gridCleanUpDelay, InstanceId, spawnMode);
+
+    // without a battleground (pooled map) active entities and transports are left for CreateBattleGroundMap
+    if (bg)
+    {
+        map->SetBG(bg);
+        bg->SetBgMap(map);
+    }
+
     // BGs/Arenas not have saved instance data
     map->Initialize(false);
 
+    ++m_bgMapCreateCount;
+    m_bgMapCreateTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
     return map;
 }
 
+uint32 MapManager::ReserveBattleGroundInstanceId(uint32 mapid, uint8 spawnMode)
+{
+    if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_MAP_POOL_SIZE))
+    {
+        std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+
+        // a miss still registers the map so the pool starts keeping it ready
+        std::deque<BattleGroundMap*>& pool = m_bgMapPool[BgMapPoolKey(mapid, spawnMode)];
+        if (!pool.empty())
+        {
+            BattleGroundMap* map = pool.front();
+            pool.pop_front();
+            m_reservedBgMaps[map->GetInstanceId()] = { map, std::chrono::steady_clock::now() };
+            ++m_bgMapPoolHits;
+            return map->GetInstanceId();
+        }
+
+        ++m_bgMapPoolMisses;
+    }
+
+    return GenerateInstanceId();
+}
+
+uint32 MapManager::GetBgMapPoolSize()
+{
+    std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+
+    uint32 size = 0;
+    for (auto const& pool : m_bgMapPool)
+        size += pool.second.size();
+    return size;
+}
+
+void MapManager::ExpireReservedBgMaps()
+{
+    std::vector<BattleGroundMap*> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (auto itr = m_reservedBgMaps.begin(); itr != m_reservedBgMaps.end();)
+        {
+            if (now - itr->second.reservedAt < BG_MAP_RESERVATION_TIMEOUT)
+            {
+                ++itr;
+                continue;
+            }
+
+            // not put back into the pool, a late CreateBattleGroundMap for this instance id must not find it reserved again
+            expired.push_back(itr->second.map);
+            itr = m_reservedBgMaps.erase(itr);
+        }
+    }
+
+    for (BattleGroundMap* map : expired)
+    {
+        sLog.outDetail("MapManager: unloading reserved battleground map %u instance %u, its battleground was never created", map->GetId(), map->GetInstanceId());
+        map->UnloadAll(true);
+        delete map;
+    }
+}
+
+void MapManager::FillBgMapPool()
+{
+    ExpireReservedBgMaps();
+
+    uint32 poolSize = sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_MAP_POOL_SIZE);
+    if (!poolSize)
+        return;
+
+    // at most one map per tick, so filling the pool never becomes the spike it is there to avoid
+    BgMapPoolKey key;
+    {
+        std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+        auto itr = m_bgMapPool.begin();
+        for (; itr != m_bgMapPool.end(); ++itr)
+            if (itr->second.size() < poolSize)
+                break;
+
+        if (itr == m_bgMapPool.end())
+            return;
+
+        key = itr->first;
+    }
+
+    sTerrainMgr.LoadTerrain(key.first);
+    BattleGroundMap* map = InitializeBattleGroundMap(key.first, GenerateInstanceId(), key.second);
+
+    std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+    m_bgMapPool[key].push_back(map);
+}
+
+void MapManager::UnloadBgMapPool()
+{
+    std::lock_guard<std::mutex> lock(m_bgMapPoolLock);
+
+    for (auto& pool : m_bgMapPool)
+    {
+        for (BattleGroundMap* map : pool.second)
+        {
+            map->UnloadAll(true);
+            delete map;
+        }
+    }
+    m_bgMapPool.clear();
+
+    for (auto& reserved : m_reservedBgMaps)
+    {
+        reserved.second.map->UnloadAll(true);
+        delete reserved.second.map;
+    }
+    m_reservedBgMaps.clear();
+}
+
 void MapManager::DoForAllMapsWithMapId(uint32 mapId, std::function<void(Map*)> worker)
 {
     MapMapType::const_iterator start = i_maps.lower_bound(MapID(mapId, 0));
@@ -28,6 +28,8 @@
 #include "Maps/MapUpdater.h"
 #include "Util/UniqueTrackablePtr.h"
 
+#include <chrono>
+#include <deque>
 #include <functional>
 
 class Transport;
@@ -67,6 +69,21 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void CreateContinents();
         Map* CreateMap(uint32, const WorldObject* obj);
         Map* CreateBgMap(uint32 mapid, uint32 instanceId, BattleGround* bg);
+
+        // battleground map pool, maps are initialized ahead of demand and handed out on match pop
+        uint32 ReserveBattleGroundInstanceId(uint32 mapid, uint8 spawnMode);   // threadsafe
+        uint64 GetBgMapPoolHits() const { return m_bgMapPoolHits; }
+        uint64 GetBgMapPoolMisses() const { return m_bgMapPoolMisses; }
+        uint64 GetBgMapCreateCount() const { return m_bgMapCreateCount; }
+        uint64 GetBgMapCreateTime() const { return m_bgMapCreateTime; }
+        uint32 GetBgMapPoolSize();
+
+        // time spent holding the manager lock while maps are added or removed, lookups are not accounted
+        uint64 GetLockHoldCount() const { return m_lockHoldCount; }
+        uint64 GetLockHoldTime() const { return m_lockHoldTime; }          // microseconds
+        uint64 GetLockHoldMaxTime() const { return m_lockHoldMaxTime; }    // microseconds
+        uint64 GetInstanceCreateCount() const { return m_instanceCreateCount; }
+        uint64 GetInstanceCreateTime() const { return m_instanceCreateTime; }  // microseconds, spent outside the lock
         Map* FindMap(uint32 mapid, uint32 instanceId = 0) const;
 
         void UpdateGridState(grid_state_t state, Map& map, NGridType& ngrid, GridInfo& ginfo, const uint32& x, const uint32& y, const uint32& t_diff);
@@ -180,9 +197,16 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void InitStateMachine();
         void DeleteStateMachine();
 
+        class TimedGuard;
+        void AddLockHoldTime(uint64 holdTime);
+
         Map* CreateInstance(uint32 id, Player* player);
         DungeonMap* CreateDungeonMap(uint32 id, uint32 InstanceId, Difficulty difficulty, DungeonPersistentState* save = nullptr);
         BattleGroundMap* CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg);
+        BattleGroundMap* InitializeBattleGroundMap(uint32 id, uint32 InstanceId, uint8 spawnMode, BattleGround* bg = nullptr);
+        void FillBgMapPool();
+        void ExpireReservedBgMaps();
+        void UnloadBgMapPool();
 
         std::mutex m_lock;
         uint32 i_gridCleanUpDelay;
@@ -191,6 +215,28 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         std::atomic<uint32> i_MaxInstanceId;
         MapUpdater m_updater;
+
+        typedef std::pair<uint32, uint8> BgMapPoolKey;     // map id, spawn mode
+        std::mutex m_bgMapPoolLock;
+        std::map<BgMapPoolKey, std::deque<BattleGroundMap*>> m_bgMapPool;  // keys are added on first demand
+        struct ReservedBgMap
+        {
+            BattleGroundMap* map;
+            std::chrono::steady_clock::time_point reservedAt;
+        };
+        std::map<uint32, ReservedBgMap> m_reservedBgMaps;                 // by instance id, taken from the pool for a starting match
+        std::atomic<uint64> m_bgMapPoolHits;
+        std::atomic<uint64> m_bgMapPoolMisses;
+        std::atomic<uint64> m_bgMapCreateCount;
+        std::atomic<uint64> m_bgMapCreateTime;              // microseconds
+
+        // instances are prepared before the manager lock is taken, it is held only to register them
+        std::atomic<uint64> m_instanceCreateCount;
+        std::atomic<uint64> m_instanceCreateTime;
+
+        std::atomic<uint64> m_lockHoldCount;
+        std::atomic<uint64> m_lockHoldTime;
+        std::atomic<uint64> m_lockHoldMaxTime;
 };
 
 template<typename Do>
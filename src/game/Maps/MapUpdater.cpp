@@ -18,6 +18,7 @@
 
 #include "MapUpdater.h"
 #include "MapWorkers.h"
+#include "Util/Tracer.h"
 
 MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
 {
@@ -81,6 +82,8 @@ void MapUpdater::schedule_update(Worker* worker)
 
 void MapUpdater::WorkerThread()
 {
+    Tracer::SetThreadName("map worker");
+
     while (true)
     {
         Worker* request = nullptr;
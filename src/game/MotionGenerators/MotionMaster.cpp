@@ -38,7 +38,7 @@
 #include "Log/Log.h"
 
 #ifdef BUILD_METRICS
- #include "Metric/Metric.h"
+ #include "Metric/MetricRegistry.h"
 #endif
 
 #include <cassert>
@@ -47,6 +47,12 @@ namespace
 {
     // Minimum falling distance required to launch a FallMovement generator.
     constexpr float g_moveFallMinFallDistance = 0.5f;
+
+#ifdef BUILD_METRICS
+    // microseconds
+    metric::histogram g_motionMasterInitializeMetric("motionmaster.initialize", {}, metric::histogram::exponential_bounds(1, 2, 16));
+    metric::histogram g_motionMasterUpdateMetric("motionmaster.updatemotion", {}, metric::histogram::exponential_bounds(1, 2, 16));
+#endif
 }
 
 inline bool isStatic(MovementGenerator* mv)
@@ -57,13 +63,7 @@ inline bool isStatic(MovementGenerator* mv)
 void MotionMaster::Initialize()
 {
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("motionmaster.initialize", {
-        { "entry", std::to_string(m_owner->GetEntry()) },
-        { "guid", std::to_string(m_owner->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_owner->GetMapId()) },
-        { "instance_id", std::to_string(m_owner->GetInstanceId()) }
-    }, 1000);
+    metric::timer<std::chrono::microseconds> meas(g_motionMasterInitializeMetric);
 #endif
     // stop current move
     m_owner->StopMoving();
@@ -115,13 +115,7 @@ void MotionMaster::UpdateMotion(uint32 diff)
     if (m_owner->hasUnitState(UNIT_STAT_CAN_NOT_MOVE))
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("motionmaster.updatemotion", {
-        { "entry", std::to_string(m_owner->GetEntry()) },
-        { "guid", std::to_string(m_owner->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_owner->GetMapId()) },
-        { "instance_id", std::to_string(m_owner->GetInstanceId()) }
-    }, 1000);
+    metric::timer<std::chrono::microseconds> meas(g_motionMasterUpdateMetric);
 #endif
 
     MANGOS_ASSERT(!empty());
@@ -20,24 +20,37 @@
 #define _MOVE_MAP_H
 
 #include "Common.h"
+#include "Util/MemoryTracker.h"
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
 class Unit;
 
 //  memory management
+//  every block carries its size in front so frees can be accounted to the mmap memory tag
+#define DT_ALLOC_HEADER_SIZE alignof(std::max_align_t)
+
 inline void* dtCustomAlloc(size_t size, dtAllocHint /*hint*/)
 {
-    return (void*)new unsigned char[size];
+    unsigned char* block = new unsigned char[size + DT_ALLOC_HEADER_SIZE];
+    *(size_t*)block = size;
+    MemoryTracker::Allocate(MEMORY_TAG_MMAP, size);
+    return (void*)(block + DT_ALLOC_HEADER_SIZE);
 }
 
 inline void dtCustomFree(void* ptr)
 {
-    delete[](unsigned char*)ptr;
+    if (!ptr)
+        return;
+
+    unsigned char* block = (unsigned char*)ptr - DT_ALLOC_HEADER_SIZE;
+    MemoryTracker::Free(MEMORY_TAG_MMAP, *(size_t*)block);
+    delete[] block;
 }
 
 //  move map related classes
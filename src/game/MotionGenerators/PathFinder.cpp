@@ -27,7 +27,13 @@
 #include <Detour/Include/DetourMath.h>
 
 #ifdef BUILD_METRICS
- #include "Metric/Metric.h"
+ #include "Metric/MetricRegistry.h"
+
+namespace
+{
+    // microseconds
+    metric::histogram g_pathFinderCalculateMetric("pathfinder.calculate", {}, metric::histogram::exponential_bounds(1, 2, 16));
+}
 #endif
 
 #include <limits>
@@ -133,13 +139,7 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
 #endif
 
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("pathfinder.calculate", {
-        { "entry", std::to_string(m_sourceUnit->GetEntry()) },
-        { "guid", std::to_string(m_sourceUnit->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_sourceUnit->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_sourceUnit->GetMapId()) },
-        { "instance_id", std::to_string(m_sourceUnit->GetInstanceId()) }
-    }, 1000);
+    metric::timer<std::chrono::microseconds> meas(g_pathFinderCalculateMetric);
 #endif
 
     //if (GenericTransport* transport = m_sourceUnit->GetTransport())
@@ -9003,7 +9003,11 @@ void PlayerbotAI::_HandleCommandMail(std::string& text, Player& fromPlayer)
         ch.SendSysMessage("Syntax: mail <inbox [Mailbox] | getcash [mailid].. | getitem [mailid].. | delete [mailid]..>");
         return;
     }
-    else if (ExtractCommand("inbox", text))
+
+    // bots have no mailbox list round-trip, mailed item instances are loaded on demand
+    m_bot->LoadAllMailedItems();
+
+    if (ExtractCommand("inbox", text))
     {
         uint32 mail_count = 0;
         extractGOinfo(text, m_lootTargets);
@@ -39,6 +39,8 @@
 #include "GMTickets/GMTicketMgr.h"
 #include "Loot/LootMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Util/Tracer.h"
+#include "Util/MemoryTracker.h"
 
 #include <mutex>
 #include <deque>
@@ -294,18 +296,28 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
         return;
     }
 
+    size_t size = sizeof(WorldPacket) + new_packet->size();
+    MemoryTracker::Allocate(MEMORY_TAG_SESSION_QUEUES, size);
+    QueuedPacket queued(new_packet.release(), QueuedPacketDeleter{ size });
+
     if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
     {
         std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
+        m_recvQueueMap.push_back(std::move(queued));
     }
     else
     {
         std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
+        m_recvQueue.push_back(std::move(queued));
     }
 }
 
+void QueuedPacketDeleter::operator()(WorldPacket* packet) const
+{
+    MemoryTracker::Free(MEMORY_TAG_SESSION_QUEUES, size);
+    delete packet;
+}
+
 void WorldSession::DeleteMovementPackets()
 {
     std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
@@ -372,7 +384,7 @@ bool WorldSession::Update(uint32 /*diff*/)
 {
     GetMessager().Execute(this);
 
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
+    PacketQueue recvQueueCopy;
     {
         std::lock_guard<std::mutex> guard(m_recvQueueLock);
         std::swap(recvQueueCopy, m_recvQueue);
@@ -514,7 +526,7 @@ bool WorldSession::Update(uint32 /*diff*/)
             else
             {
                 if (m_inQueue)
-                    SendAuthQueued();
+                    SendAuthQueued(sWorld.GetQueuedSessionPos(this));
                 else
                     SendAuthOk();
             }
@@ -592,7 +604,7 @@ void WorldSession::UpdateMap(uint32 diff)
             m_timeSyncTimer -= diff;
     }
 
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
+    PacketQueue recvQueueMapCopy;
     {
         std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
         std::swap(recvQueueMapCopy, m_recvQueueMap);
@@ -1236,6 +1248,8 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    TraceSpan span("opcode", opHandle.name, "opcode", packet.GetOpcode(), "account", GetAccountId());
+
     try
     {
         (this->*opHandle.handler)(packet);
@@ -1313,7 +1327,7 @@ void WorldSession::SendAuthOk() const
     SendPacket(packet, true);
 }
 
-void WorldSession::SendAuthQueued() const
+void WorldSession::SendAuthQueued(uint32 position) const
 {
     // The 1st SMSG_AUTH_RESPONSE needs to contain other info too.
     WorldPacket packet(SMSG_AUTH_RESPONSE, 1 + 4 + 1 + 4 + 1 + 4);
@@ -1322,7 +1336,7 @@ void WorldSession::SendAuthQueued() const
     packet << uint8(0);                                     // BillingPlanFlags
     packet << uint32(0);                                    // BillingTimeRested
     packet << uint8(GetExpansion());                        // 0 - normal, 1 - TBC, must be set in database manually for each account
-    packet << uint32(sWorld.GetQueuedSessionPos(this));     // position in queue
+    packet << uint32(position);                             // position in queue
     SendPacket(packet, true);
 }
 
@@ -165,6 +165,17 @@ struct CharacterNameQueryResponse
     DeclinedName        declined;               // pc's declined name definitions
 };
 
+// frees a received packet and the bytes it was accounted with when it entered a session queue
+struct QueuedPacketDeleter
+{
+    size_t size = 0;
+
+    void operator()(WorldPacket* packet) const;
+};
+
+typedef std::unique_ptr<WorldPacket, QueuedPacketDeleter> QueuedPacket;
+typedef std::deque<QueuedPacket> PacketQueue;
+
 enum AccountFlags
 {
     ACCOUNT_FLAG_SHOW_ANTICHEAT = 0x01,
@@ -232,6 +243,8 @@ class WorldSession
         // Request set offline, close socket and put session offline
         bool RequestNewSocket(WorldSocket* socket);
         bool IsOffline() const { return m_sessionState == WORLD_SESSION_STATE_OFFLINE; }
+        // for sessions not yet in the session list (waiting for admission), which Update does not see
+        bool IsSocketClosed() const { return !m_socket || m_socket->IsClosed(); }
         WorldSessionState GetState() const { return m_sessionState; }
 
         bool PlayerLoading() const { return m_playerLoading; }
@@ -340,6 +353,7 @@ class WorldSession
         bool CheckBanker(ObjectGuid guid) const;
         void SendShowBank(ObjectGuid guid) const;
         bool CheckMailBox(ObjectGuid guid) const;
+        void SendMailList();
         void SendTabardVendorActivate(ObjectGuid guid) const;
         void SendSpiritResurrect() const;
         void SendBindPoint(Creature* npc) const;
@@ -470,7 +484,7 @@ class WorldSession
 #endif
 
         void SendAuthOk() const;
-        void SendAuthQueued() const;
+        void SendAuthQueued(uint32 position) const;
         void SendKickReason(uint8 reason, std::string const& string) const;
 
         // opcodes handlers
@@ -688,6 +702,7 @@ class WorldSession
         void HandleAuctionPlaceBid(WorldPacket& recv_data);
 
         void HandleGetMailList(WorldPacket& recv_data);
+        static void HandleGetMailListCallBack(QueryResult* result, uint32 accountId, ObjectGuid mailboxGuid);
         void HandleSendMail(WorldPacket& recv_data);
         void HandleMailTakeMoney(WorldPacket& recv_data);
         void HandleMailTakeItem(WorldPacket& recv_data);
@@ -1001,8 +1016,8 @@ class WorldSession
         // Thread safety mechanisms
         std::mutex m_recvQueueLock;
         std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        PacketQueue m_recvQueue;
+        PacketQueue m_recvQueueMap;
 
         Messager<WorldSession> m_messager;
 
@@ -97,6 +97,12 @@ WorldSocket::WorldSocket(boost::asio::io_context& context) : AsyncSocket(context
 {
 }
 
+namespace
+{
+    typedef std::vector<char, BufferPoolAllocator<char>> PooledMessage;
+    typedef std::vector<uint8, BufferPoolAllocator<uint8>> PooledBuffer;
+}
+
 void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
 {
     if (IsClosed())
@@ -129,8 +135,8 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
 
     if (pct.size() > 0)
     {
-        // allocate array for full message
-        std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(header.headerSize() + pct.size());
+        // allocate array for full message, both it and its control block go back to the buffer pool once the write completes
+        std::shared_ptr<PooledMessage> fullMessage = std::allocate_shared<PooledMessage>(BufferPoolAllocator<PooledMessage>(), header.headerSize() + pct.size());
         std::memcpy(fullMessage->data(), header.data(), header.headerSize()); // copy header
         std::memcpy((fullMessage->data() + header.headerSize()), reinterpret_cast<const char*>(pct.contents()), pct.size()); // copy packet
         auto self(shared_from_this());
@@ -138,7 +144,7 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     }
     else
     {
-        std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>(header);
+        std::shared_ptr<ServerPktHeader> sharedHeader = std::allocate_shared<ServerPktHeader>(BufferPoolAllocator<ServerPktHeader>(), header);
         auto self(shared_from_this());
         Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
     }
@@ -183,7 +189,7 @@ bool WorldSocket::ProcessIncomingData()
         const Opcodes opcode = static_cast<Opcodes>(header->cmd);
 
         size_t packetSize = header->size - 4;
-        std::shared_ptr<std::vector<uint8>> packetBuffer = std::make_shared<std::vector<uint8>>(packetSize);
+        std::shared_ptr<PooledBuffer> packetBuffer = std::allocate_shared<PooledBuffer>(BufferPoolAllocator<PooledBuffer>(), packetSize);
 
         self->Read(reinterpret_cast<char*>(packetBuffer->data()), packetBuffer->size(), [self, packetBuffer, opcode = opcode](const boost::system::error_code& error, std::size_t /*read*/) -> void
         {
@@ -194,7 +200,7 @@ bool WorldSocket::ProcessIncomingData()
             }
 
             std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(opcode, packetBuffer->size());
-            pct->append(*packetBuffer.get());
+            pct->append(packetBuffer->data(), packetBuffer->size());
             if (sPacketLog->CanLogPacket() && self->IsLoggingPackets())
                 sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, self->GetRemoteIpAddress(), self->GetRemotePort());
 
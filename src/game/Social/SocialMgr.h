@@ -22,6 +22,9 @@
 #include "Database/DatabaseEnv.h"
 #include "Entities/ObjectGuid.h"
 
+#include <set>
+#include <unordered_map>
+
 class SocialMgr;
 class PlayerSocial;
 class Player;
@@ -72,6 +75,8 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+// friend low guid -> low guids of loaded players having him in their friend list
+typedef std::unordered_map<uint32, std::set<uint32> > FriendListerMap;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -132,11 +137,12 @@ class PlayerSocial
 
 class SocialMgr
 {
+        friend class PlayerSocial;
     public:
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
 
         void GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const;
         // Packet management
@@ -146,7 +152,13 @@ class SocialMgr
         // Loading
         PlayerSocial* LoadFromDB(std::unique_ptr<QueryResult> queryResult, ObjectGuid guid);
     private:
+        // reverse index maintenance, kept in sync with the SOCIAL_FLAG_FRIEND entries of m_socialMap
+        void AddFriendLister(uint32 friendGuid, uint32 listerGuid);
+        void RemoveFriendLister(uint32 friendGuid, uint32 listerGuid);
+        void RemoveFriendListers(PlayerSocial const& social);
+
         SocialMap m_socialMap;
+        FriendListerMap m_friendListers;
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -380,6 +380,8 @@ void SpellLog::SendToSet()
 // Spell class
 // ***********
 
+SlabAllocator Spell::s_slab("spell", sizeof(Spell), MEMORY_TAG_SPELLS);
+
 Spell::Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags, ObjectGuid originalCasterGUID, SpellEntry const* triggeredBy) :
     m_partialApplicationMask(0), m_spellScript(SpellScriptMgr::GetSpellScript(info->Id)), m_auraScript(SpellScriptMgr::GetAuraScript(info->Id)),
     m_effectSkipMask(0),
@@ -29,6 +29,7 @@
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
 #include "Util/UniqueTrackablePtr.h"
+#include "Util/SlabAllocator.h"
 
 class WorldSession;
 class WorldPacket;
@@ -475,6 +476,10 @@ class Spell
         Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags, ObjectGuid originalCasterGUID = ObjectGuid(), SpellEntry const* triggeredBy = nullptr);
         virtual ~Spell();
 
+        // created and destroyed with every cast, so they come from their own slab
+        static void* operator new(size_t size) { return s_slab.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { s_slab.Free(ptr, size); }
+
         SpellCastResult SpellStart(SpellCastTargets const* targets, Aura* triggeredByAura = nullptr);
 
         void cancel();
@@ -1008,6 +1013,8 @@ class Spell
         SpellEvent* m_spellEvent;
 
     private:
+        static SlabAllocator s_slab;
+
         // needed to store all log for this spell
         SpellLog m_spellLog;
 
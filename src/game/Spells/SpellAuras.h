@@ -23,6 +23,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Spells/Scripts/SpellScript.h"
 #include "Util/UniqueTrackablePtr.h"
+#include "Util/SlabAllocator.h"
 
 /**
  * Used to modify what an Aura does to a player/npc.
@@ -96,6 +97,10 @@ class SpellAuraHolder
     public:
         SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy);
         ~SpellAuraHolder();
+
+        // created and destroyed with every aura application, so they come from their own slab
+        static void* operator new(size_t size) { return s_slab.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { s_slab.Free(ptr, size); }
         Aura* m_auras[MAX_EFFECT_INDEX];
 
         void AddAura(Aura* aura, SpellEffectIndex index);
@@ -219,6 +224,8 @@ class SpellAuraHolder
         // helpers
         void PresetAuraStacks(uint32 stacks) { m_stackAmount = stacks; } // use only in OnHolderInit
     private:
+        static SlabAllocator s_slab;
+
         void UpdateAuraApplication();                       // called at charges or stack changes
         void ClearExtraAuraInfo(Unit* caster);
         void UpdateHeartbeatResist(uint32 diff);
@@ -444,6 +451,10 @@ class Aura
 
         virtual ~Aura();
 
+        // created and destroyed with every aura application, so they come from their own slab sized for the largest subclass
+        static void* operator new(size_t size) { return s_slab.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { s_slab.Free(ptr, size); }
+
         void SetModifier(AuraType type, int32 amount, uint32 periodicTime, int32 miscValue);
         Modifier*       GetModifier()       { return &m_modifier; }
         Modifier const* GetModifier() const { return &m_modifier; }
@@ -600,6 +611,8 @@ class Aura
         struct NoopAuraDeleter { void operator()(Aura*) const { /*noop - not managed*/ } };
         MaNGOS::unique_trackable_ptr<Aura> m_scriptRef;
     private:
+        static SlabAllocator s_slab;
+
         void ReapplyAffectedPassiveAuras(Unit* target, bool owner_mode);
 };
 
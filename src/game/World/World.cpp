@@ -60,6 +60,9 @@
 #include "MotionGenerators/WaypointManager.h"
 #include "GMTickets/GMTicketMgr.h"
 #include "Util/Util.h"
+#include "Util/Tracer.h"
+#include "Util/MemoryTracker.h"
+#include "Util/SlabAllocator.h"
 #include "Tools/CharacterDatabaseCleaner.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Weather/Weather.h"
@@ -75,6 +78,7 @@
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
+ #include "Network/AsyncSocket.hpp"
 #endif
 
 #ifdef ENABLE_PLAYERBOTS
@@ -114,6 +118,62 @@ uint32 World::m_maxDiff = 0;
 std::list<uint32> World::m_histDiff;
 #endif
 
+#ifdef BUILD_METRICS
+namespace
+{
+    // world update phases in microseconds
+    metric::histogram g_worldUpdateMetric("world.update", { { "phase", "total" } }, metric::histogram::exponential_bounds(100, 2, 16));
+    metric::histogram g_worldPreSessionMetric("world.update", { { "phase", "presession" } }, metric::histogram::exponential_bounds(100, 2, 16));
+    metric::histogram g_worldPreMapMetric("world.update", { { "phase", "premap" } }, metric::histogram::exponential_bounds(100, 2, 16));
+    metric::histogram g_worldMapMetric("world.update", { { "phase", "map" } }, metric::histogram::exponential_bounds(100, 2, 16));
+    metric::histogram g_worldSingletonsMetric("world.update", { { "phase", "singletons" } }, metric::histogram::exponential_bounds(100, 2, 16));
+    metric::histogram g_worldCleanupMetric("world.update", { { "phase", "cleanup" } }, metric::histogram::exponential_bounds(100, 2, 16));
+
+    metric::gauge g_worldLatencyMetric("world.metrics.latency");
+
+    metric::gauge g_mapsMetric("world.maps", { { "type", "total" } });
+    metric::gauge g_instancesMetric("world.maps", { { "type", "instance" } });
+    metric::gauge g_instancePlayersMetric("world.maps.instance.players");
+    metric::gauge g_bgMapPoolMetric("world.maps.bgpool.size");
+    metric::counter g_bgMapPoolHitsMetric("world.maps.bgpool.hits");
+    metric::counter g_bgMapPoolMissesMetric("world.maps.bgpool.misses");
+
+    metric::gauge g_worldDatabaseQueueMetric("database.queue", { { "database", "world" } });
+    metric::gauge g_characterDatabaseQueueMetric("database.queue", { { "database", "character" } });
+    metric::gauge g_loginDatabaseQueueMetric("database.queue", { { "database", "login" } });
+
+    metric::counter g_socketReceivedMetric("network.bytes.received");
+    metric::counter g_socketSentMetric("network.bytes.sent");
+    metric::counter g_bufferRequestsMetric("network.buffers.requests");
+    metric::counter g_bufferHeapAllocationsMetric("network.buffers.heap_allocations");
+
+    // registered on first use, only touched by the world thread
+    std::array<std::unique_ptr<metric::counter>, NUM_MSG_TYPES> g_opcodeMetrics;
+
+    // registered on first use, one series per memory accounting tag
+    std::array<std::unique_ptr<metric::gauge>, MAX_MEMORY_TAGS> g_memoryMetrics;
+    metric::gauge g_residentMemoryMetric("memory.resident");
+
+    // registered on first use, one series per slab allocator
+    std::array<std::unique_ptr<metric::gauge>, MAX_SLAB_ALLOCATORS> g_slabMetrics;
+
+    metric::gauge& PlayerMetric(char const* type)
+    {
+        static std::map<std::string, std::unique_ptr<metric::gauge>> gauges;
+        std::unique_ptr<metric::gauge>& target = gauges[type];
+        if (!target)
+            target = std::make_unique<metric::gauge>("world.metrics.players", metric::tag_set{ { "type", type } });
+
+        return *target;
+    }
+
+    uint64 ElapsedMicroseconds(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return uint64(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+    }
+}
+#endif
+
 /// World constructor
 World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0), m_NextWeeklyQuestReset(0), m_NextMonthlyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
 {
@@ -125,6 +185,8 @@ World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0),
     m_startTime = m_gameTime;
     m_maxActiveSessionCount = 0;
     m_maxQueuedSessionCount = 0;
+    m_admissionQueueSize = 0;
+    m_admissionStatusTimer.SetInterval(5 * IN_MILLISECONDS);
 
     m_defaultDbcLocale = DEFAULT_LOCALE;
     m_availableDbcLocaleMask = 0;
@@ -157,6 +219,10 @@ World::~World()
     for (auto const session : m_sessionAddQueue)
         delete session;
 
+    for (auto const& queue : m_admissionQueue)
+        for (auto const session : queue.second)
+            delete session;
+
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
@@ -219,6 +285,8 @@ World::AddSession_(WorldSession* s)
     if (FindSession(s->GetAccountId()))
     {
         sLog.outError("Trying to add an already existing session");
+        s->KickPlayer();
+        delete s;                                           // session not added yet in session list
         return;
     }
 
@@ -517,6 +585,10 @@ void World::LoadConfigSettings(bool reload)
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
         setConfig(CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT);
 
+    setConfig(CONFIG_UINT32_LOGIN_ADMISSION_RATE, "PlayerLimit.AdmissionRate", 0);
+    setConfig(CONFIG_UINT32_LOGIN_ADMISSION_BURST, "PlayerLimit.AdmissionBurst", 50);
+    m_sessionAdmission.SetRate(getConfig(CONFIG_UINT32_LOGIN_ADMISSION_RATE), getConfig(CONFIG_UINT32_LOGIN_ADMISSION_BURST));
+
     if (configNoReload(reload, CONFIG_UINT32_GAME_TYPE, "GameType", 0))
         setConfig(CONFIG_UINT32_GAME_TYPE, "GameType", 0);
 
@@ -727,6 +799,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE,              "Battleground.InvitationType", 0);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,       "BattleGround.PrematureFinishTimer", 5 * MINUTE * IN_MILLISECONDS);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH, "BattleGround.PremadeGroupWaitForMatch", 30 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_BATTLEGROUND_MAP_POOL_SIZE,                "BattleGround.MapPoolSize", 0);
     setConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,               "Arena.MaxRatingDifference", 150);
     setConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,                "Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
     setConfig(CONFIG_BOOL_ARENA_AUTO_DISTRIBUTE_POINTS,                "Arena.AutoDistributePoints", false);
@@ -895,6 +968,9 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Initialize span recording
+    sTracer.Initialize();
+
     ///- Check the existence of the map files for all races start areas.
     if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||                     // Dwarf/ Gnome
             !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||                // Human
@@ -1483,6 +1559,8 @@ void World::SetInitialWorldSettings()
     sLog.outString();
 
 #ifdef BUILD_METRICS
+    // start the configured exporters
+    metric::metric::instance();
     // update metrics output every second
     m_timers[WUPDATE_METRICS].SetInterval(1 * IN_MILLISECONDS);
 #endif // BUILD_METRICS
@@ -1560,6 +1638,10 @@ void World::Update(uint32 diff)
     m_currentMSTime = WorldTimer::getMSTime();
     m_currentTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     m_currentDiff = diff;
+    TraceSpan updateSpan("world", "World::Update", "diff", diff);
+#ifdef BUILD_METRICS
+    auto updateStartTime = std::chrono::steady_clock::now();
+#endif
 
 #ifdef ENABLE_PLAYERBOTS
     m_currentDiffSum += diff;
@@ -1658,9 +1740,12 @@ void World::Update(uint32 diff)
 
     /// <li> Handle session updates
 #ifdef BUILD_METRICS
-    auto preSessionTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+    auto preSessionTime = std::chrono::steady_clock::now();
 #endif
-    UpdateSessions(diff);
+    {
+        TraceSpan span("world", "UpdateSessions", "sessions", int64(m_sessions.size()));
+        UpdateSessions(diff);
+    }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -1675,17 +1760,23 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
 #ifdef BUILD_METRICS
-    auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+    auto preMapTime = std::chrono::steady_clock::now();
 #endif
-    sMapMgr.Update(diff);
+    {
+        TraceSpan span("world", "MapManager::Update");
+        sMapMgr.Update(diff);
+    }
 #ifdef BUILD_METRICS
-    auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+    auto postMapTime = std::chrono::steady_clock::now();
 #endif
-    sBattleGroundMgr.Update(diff);
-    sOutdoorPvPMgr.Update(diff);
-    sWorldState.Update(diff);
+    {
+        TraceSpan span("world", "Singletons");
+        sBattleGroundMgr.Update(diff);
+        sOutdoorPvPMgr.Update(diff);
+        sWorldState.Update(diff);
+    }
 #ifdef BUILD_METRICS
-    auto postSingletonTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+    auto postSingletonTime = std::chrono::steady_clock::now();
 #endif
     ///- Update groups with offline leaders
     if (m_timers[WUPDATE_GROUPS].Passed())
@@ -1706,7 +1797,10 @@ void World::Update(uint32 diff)
     }
 
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        TraceSpan span("world", "UpdateResultQueue");
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -1730,6 +1824,7 @@ void World::Update(uint32 diff)
     {
         m_timers[WUPDATE_METRICS].Reset();
         GeneratePacketMetrics();
+        GenerateServerMetrics();
     }
 #endif
 
@@ -1741,26 +1836,24 @@ void World::Update(uint32 diff)
     sMapPersistentStateMgr.Update();
 
     // And last, but not least handle the issued cli commands
-    ProcessCliCommands();
+    {
+        TraceSpan span("world", "ProcessCliCommands");
+        ProcessCliCommands();
+    }
 
     // cleanup unused GridMap objects as well as VMaps
-    sTerrainMgr.Update(diff);
+    {
+        TraceSpan span("world", "TerrainManager::Update");
+        sTerrainMgr.Update(diff);
+    }
 #ifdef BUILD_METRICS
-    auto updateEndTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
-    long long total = (updateEndTime - m_currentTime).count();
-    long long presession = (preSessionTime - m_currentTime).count();
-    long long premap = (preMapTime - preSessionTime).count();
-    long long map = (postMapTime - preMapTime).count();
-    long long singletons = (postSingletonTime - postMapTime).count();
-    long long cleanup = (updateEndTime - postSingletonTime).count();
-
-    metric::measurement meas("world.update");
-    meas.add_field("total", std::to_string(total));
-    meas.add_field("presession", std::to_string(presession));
-    meas.add_field("premap", std::to_string(premap));
-    meas.add_field("map", std::to_string(map));
-    meas.add_field("singletons", std::to_string(singletons));
-    meas.add_field("cleanup", std::to_string(cleanup));
+    auto updateEndTime = std::chrono::steady_clock::now();
+    g_worldUpdateMetric.observe(ElapsedMicroseconds(updateStartTime, updateEndTime));
+    g_worldPreSessionMetric.observe(ElapsedMicroseconds(updateStartTime, preSessionTime));
+    g_worldPreMapMetric.observe(ElapsedMicroseconds(preSessionTime, preMapTime));
+    g_worldMapMetric.observe(ElapsedMicroseconds(preMapTime, postMapTime));
+    g_worldSingletonsMetric.observe(ElapsedMicroseconds(postMapTime, postSingletonTime));
+    g_worldCleanupMetric.observe(ElapsedMicroseconds(postSingletonTime, updateEndTime));
 #endif
 }
 
@@ -1969,6 +2062,19 @@ void World::KickAll(bool save)
 {
     m_QueuedSessions.clear();                               // prevent send queue update packet and login queued sessions
 
+    // sessions waiting for admission are not in the session list yet
+    for (auto const& queue : m_admissionQueue)
+    {
+        for (auto const session : queue.second)
+        {
+            session->KickPlayer();
+            delete session;
+        }
+    }
+    m_admissionQueue.clear();
+    m_admissionOrder.clear();
+    m_admissionQueueSize = 0;
+
     // session not removed at kick and will removed in next update tick
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         itr->second->KickPlayer(save, true);
@@ -2201,7 +2307,15 @@ void World::UpdateSessions(uint32 diff)
         }
 
         for (auto const& session : sessionQueueCopy)
-            AddSession_(session);
+        {
+            // staff skips admission, as it skips the player limit queue
+            if (session->GetSecurity() > SEC_PLAYER || (m_admissionOrder.empty() && m_sessionAdmission.TryConsume()))
+                AddSession_(session);
+            else
+                QueueForAdmission(session);
+        }
+
+        AdmitQueuedSessions(diff);
     }
 
     ///- Then send an update signal to remaining ones
@@ -2221,6 +2335,125 @@ void World::UpdateSessions(uint32 diff)
     }
 }
 
+void World::QueueForAdmission(WorldSession* s)
+{
+    // a reconnecting client takes over the place of its earlier, still waiting session
+    for (auto& queue : m_admissionQueue)
+    {
+        for (auto& session : queue.second)
+        {
+            if (session->GetAccountId() != s->GetAccountId())
+                continue;
+
+            session->KickPlayer();
+            delete session;
+            session = s;
+
+            s->SendAuthQueued(m_admissionQueueSize + GetQueuedSessionCount());
+            DETAIL_LOG("LoginQueue: Account id %u reconnected while waiting for admission.", s->GetAccountId());
+            return;
+        }
+    }
+
+    std::deque<WorldSession*>& queue = m_admissionQueue[s->GetRemoteAddress()];
+    if (queue.empty())
+        m_admissionOrder.push_back(s->GetRemoteAddress());
+
+    queue.push_back(s);
+    ++m_admissionQueueSize;
+
+    // exact round robin position is sent with the next status update
+    uint32 position = m_admissionQueueSize + GetQueuedSessionCount();
+    s->SendAuthQueued(position);
+
+    DETAIL_LOG("LoginQueue: Account id %u waits for admission at position %u (about %u s).",
+               s->GetAccountId(), position, m_admissionQueueSize / std::max(m_sessionAdmission.GetRate(), uint32(1)));
+}
+
+// frees the waiting sessions whose client has disconnected, so they neither take an admission nor keep their place
+void World::RemoveClosedAdmissions()
+{
+    for (auto itr = m_admissionQueue.begin(); itr != m_admissionQueue.end();)
+    {
+        std::deque<WorldSession*>& queue = itr->second;
+        for (auto session = queue.begin(); session != queue.end();)
+        {
+            if ((*session)->IsSocketClosed())
+            {
+                delete *session;
+                session = queue.erase(session);
+                --m_admissionQueueSize;
+            }
+            else
+                ++session;
+        }
+
+        if (queue.empty())
+        {
+            m_admissionOrder.erase(std::find(m_admissionOrder.begin(), m_admissionOrder.end(), itr->first));
+            itr = m_admissionQueue.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
+void World::AdmitQueuedSessions(uint32 diff)
+{
+    RemoveClosedAdmissions();
+
+    // one session per address and round so a single host can not hold back everyone else
+    while (!m_admissionOrder.empty() && m_sessionAdmission.TryConsume())
+    {
+        std::string address = m_admissionOrder.front();
+        m_admissionOrder.pop_front();
+
+        auto itr = m_admissionQueue.find(address);
+        WorldSession* session = itr->second.front();
+        itr->second.pop_front();
+        --m_admissionQueueSize;
+
+        if (itr->second.empty())
+            m_admissionQueue.erase(itr);
+        else
+            m_admissionOrder.push_back(address);
+
+        AddSession_(session);
+    }
+
+    m_admissionStatusTimer.Update(diff);
+    if (m_admissionStatusTimer.Passed())
+    {
+        m_admissionStatusTimer.Reset();
+        SendAdmissionQueuePositions();
+    }
+}
+
+void World::SendAdmissionQueuePositions()
+{
+    if (m_admissionOrder.empty())
+        return;
+
+    // walk the queues in the order AdmitQueuedSessions will serve them
+    std::vector<std::deque<WorldSession*> const*> queues;
+    queues.reserve(m_admissionOrder.size());
+    for (auto const& address : m_admissionOrder)
+        queues.push_back(&m_admissionQueue[address]);
+
+    uint32 position = GetQueuedSessionCount();
+    for (size_t round = 0; !queues.empty(); ++round)
+    {
+        size_t remaining = 0;
+        for (auto const queue : queues)
+        {
+            (*queue)[round]->SendAuthWaitQue(++position);
+            if (queue->size() > round + 1)
+                queues[remaining++] = queue;
+        }
+        queues.resize(remaining);
+    }
+}
+
 // This handles the issued and queued CLI/RA commands
 void World::ProcessCliCommands()
 {
@@ -2749,48 +2982,87 @@ void World::GeneratePacketMetrics()
 {
     for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
     {
-        if (m_opcodeCounters[i] == 0)
+        uint32 count = m_opcodeCounters[i].exchange(0);
+        if (count == 0)
             continue;
 
-        metric::measurement meas("world.metrics.packets.received", { {"opcode", opcodeTable[i].name} });
-        meas.add_field("count", std::to_string(static_cast<uint32>(m_opcodeCounters[i])));
+        std::unique_ptr<metric::counter>& target = g_opcodeMetrics[i];
+        if (!target)
+            target = std::make_unique<metric::counter>("world.metrics.packets.received", metric::tag_set{ { "opcode", opcodeTable[i].name } });
 
-        // Reset counter
-        m_opcodeCounters[i] = 0;
+        target->add(count);
     }
 
-    metric::measurement meas_players("world.metrics.players");
-    meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
-    meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
-    meas_players.add_field("queued", std::to_string(GetQueuedSessionCount()));
+    PlayerMetric("online").set(GetActiveSessionCount());
+    PlayerMetric("unique").set(GetUniqueSessionCount());
+    PlayerMetric("queued").set(GetQueuedSessionCount());
     // team
-    meas_players.add_field("alliance", std::to_string(GetOnlineTeamPlayers(true)));
-    meas_players.add_field("horde", std::to_string(GetOnlineTeamPlayers(false)));
+    PlayerMetric("alliance").set(GetOnlineTeamPlayers(true));
+    PlayerMetric("horde").set(GetOnlineTeamPlayers(false));
     // race
-    meas_players.add_field("human", std::to_string(GetOnlineRacePlayers(RACE_HUMAN)));
-    meas_players.add_field("dwarf", std::to_string(GetOnlineRacePlayers(RACE_DWARF)));
-    meas_players.add_field("gnome", std::to_string(GetOnlineRacePlayers(RACE_GNOME)));
-    meas_players.add_field("nelf", std::to_string(GetOnlineRacePlayers(RACE_NIGHTELF)));
-    meas_players.add_field("draenei", std::to_string(GetOnlineRacePlayers(RACE_DRAENEI)));
-
-    meas_players.add_field("orc", std::to_string(GetOnlineRacePlayers(RACE_ORC)));
-    meas_players.add_field("undead", std::to_string(GetOnlineRacePlayers(RACE_UNDEAD)));
-    meas_players.add_field("tauren", std::to_string(GetOnlineRacePlayers(RACE_TAUREN)));
-    meas_players.add_field("troll", std::to_string(GetOnlineRacePlayers(RACE_TROLL)));
-    meas_players.add_field("belf", std::to_string(GetOnlineRacePlayers(RACE_BLOODELF)));
+    PlayerMetric("human").set(GetOnlineRacePlayers(RACE_HUMAN));
+    PlayerMetric("dwarf").set(GetOnlineRacePlayers(RACE_DWARF));
+    PlayerMetric("gnome").set(GetOnlineRacePlayers(RACE_GNOME));
+    PlayerMetric("nelf").set(GetOnlineRacePlayers(RACE_NIGHTELF));
+    PlayerMetric("draenei").set(GetOnlineRacePlayers(RACE_DRAENEI));
+
+    PlayerMetric("orc").set(GetOnlineRacePlayers(RACE_ORC));
+    PlayerMetric("undead").set(GetOnlineRacePlayers(RACE_UNDEAD));
+    PlayerMetric("tauren").set(GetOnlineRacePlayers(RACE_TAUREN));
+    PlayerMetric("troll").set(GetOnlineRacePlayers(RACE_TROLL));
+    PlayerMetric("belf").set(GetOnlineRacePlayers(RACE_BLOODELF));
     // class
-    meas_players.add_field("warrior", std::to_string(GetOnlineClassPlayers(CLASS_WARRIOR)));
-    meas_players.add_field("paladin", std::to_string(GetOnlineClassPlayers(CLASS_PALADIN)));
-    meas_players.add_field("hunter", std::to_string(GetOnlineClassPlayers(CLASS_HUNTER)));
-    meas_players.add_field("rogue", std::to_string(GetOnlineClassPlayers(CLASS_ROGUE)));
-    meas_players.add_field("priest", std::to_string(GetOnlineClassPlayers(CLASS_PRIEST)));
-    meas_players.add_field("shaman", std::to_string(GetOnlineClassPlayers(CLASS_SHAMAN)));
-    meas_players.add_field("mage", std::to_string(GetOnlineClassPlayers(CLASS_MAGE)));
-    meas_players.add_field("warlock", std::to_string(GetOnlineClassPlayers(CLASS_WARLOCK)));
-    meas_players.add_field("druid", std::to_string(GetOnlineClassPlayers(CLASS_DRUID)));
-
-    metric::measurement meas_latency("world.metrics.latency");
-    meas_latency.add_field("online", std::to_string(GetAverageLatency()));
+    PlayerMetric("warrior").set(GetOnlineClassPlayers(CLASS_WARRIOR));
+    PlayerMetric("paladin").set(GetOnlineClassPlayers(CLASS_PALADIN));
+    PlayerMetric("hunter").set(GetOnlineClassPlayers(CLASS_HUNTER));
+    PlayerMetric("rogue").set(GetOnlineClassPlayers(CLASS_ROGUE));
+    PlayerMetric("priest").set(GetOnlineClassPlayers(CLASS_PRIEST));
+    PlayerMetric("shaman").set(GetOnlineClassPlayers(CLASS_SHAMAN));
+    PlayerMetric("mage").set(GetOnlineClassPlayers(CLASS_MAGE));
+    PlayerMetric("warlock").set(GetOnlineClassPlayers(CLASS_WARLOCK));
+    PlayerMetric("druid").set(GetOnlineClassPlayers(CLASS_DRUID));
+
+    g_worldLatencyMetric.set(GetAverageLatency());
+}
+
+void World::GenerateServerMetrics()
+{
+    g_mapsMetric.set(sMapMgr.Maps().size());
+    g_instancesMetric.set(sMapMgr.GetNumInstances());
+    g_instancePlayersMetric.set(sMapMgr.GetNumPlayersInInstances());
+    g_bgMapPoolMetric.set(sMapMgr.GetBgMapPoolSize());
+    g_bgMapPoolHitsMetric.advance(sMapMgr.GetBgMapPoolHits());
+    g_bgMapPoolMissesMetric.advance(sMapMgr.GetBgMapPoolMisses());
+
+    g_worldDatabaseQueueMetric.set(WorldDatabase.GetDelayQueueSize());
+    g_characterDatabaseQueueMetric.set(CharacterDatabase.GetDelayQueueSize());
+    g_loginDatabaseQueueMetric.set(LoginDatabase.GetDelayQueueSize());
+
+    g_socketReceivedMetric.advance(MaNGOS::SocketStatistics::bytesReceived);
+    g_socketSentMetric.advance(MaNGOS::SocketStatistics::bytesSent);
+
+    BufferPoolStatistic bufferStatistic = BufferPool::GetStatistic();
+    g_bufferRequestsMetric.advance(bufferStatistic.requests);
+    g_bufferHeapAllocationsMetric.advance(bufferStatistic.heapAllocations);
+
+    for (uint32 i = 0; i < MAX_MEMORY_TAGS; ++i)
+    {
+        std::unique_ptr<metric::gauge>& target = g_memoryMetrics[i];
+        if (!target)
+            target = std::make_unique<metric::gauge>("memory.tracked", metric::tag_set{ { "tag", MemoryTracker::GetTagName(MemoryTag(i)) } });
+
+        target->set(MemoryTracker::GetStatistic(MemoryTag(i)).bytes);
+    }
+    g_residentMemoryMetric.set(MemoryTracker::GetProcessResidentSize());
+
+    for (uint32 i = 0; i < SlabAllocator::GetAllocatorCount(); ++i)
+    {
+        std::unique_ptr<metric::gauge>& target = g_slabMetrics[i];
+        if (!target)
+            target = std::make_unique<metric::gauge>("memory.slab.live", metric::tag_set{ { "type", SlabAllocator::GetAllocator(i)->GetName() } });
+
+        target->set(SlabAllocator::GetAllocator(i)->GetStatistic().liveObjects);
+    }
 }
 
 uint32 World::GetAverageLatency() const
@@ -25,6 +25,7 @@
 
 #include "Common.h"
 #include "Util/Timer.h"
+#include "Util/TokenBucket.h"
 #include "Globals/Locales.h"
 #include "Globals/SharedDefines.h"
 #include "Entities/Object.h"
@@ -98,6 +99,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
+    CONFIG_UINT32_LOGIN_ADMISSION_RATE,
+    CONFIG_UINT32_LOGIN_ADMISSION_BURST,
     CONFIG_UINT32_GAME_TYPE,
     CONFIG_UINT32_REALM_ZONE,
     CONFIG_UINT32_STRICT_PLAYER_NAMES,
@@ -177,6 +180,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE,
     CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,
     CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
+    CONFIG_UINT32_BATTLEGROUND_MAP_POOL_SIZE,
     CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN,
     CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,
@@ -459,6 +463,8 @@ class World
         uint32 GetActiveAndQueuedSessionCount() const { return m_sessions.size(); }
         uint32 GetActiveSessionCount() const { return m_sessions.size() - m_QueuedSessions.size(); }
         uint32 GetQueuedSessionCount() const { return m_QueuedSessions.size(); }
+        /// Get the number of authenticated sessions still waiting for login admission
+        uint32 GetAdmissionQueueSize() const { return m_admissionQueueSize; }
         /// Get the maximum number of parallel sessions on the server since last reboot
         uint32 GetMaxQueuedSessionCount() const { return m_maxQueuedSessionCount; }
         uint32 GetMaxActiveSessionCount() const { return m_maxActiveSessionCount; }
@@ -659,7 +665,8 @@ class World
         void ResetWeeklyQuests();
         void ResetMonthlyQuests();
 #ifdef BUILD_METRICS
-        void GeneratePacketMetrics(); // thread safe due to atomics
+        void GeneratePacketMetrics(); // world thread only, opcode counters are registered on first use
+        void GenerateServerMetrics();
         uint32 GetAverageLatency() const;
 #endif
 
@@ -737,6 +744,18 @@ class World
         std::mutex m_sessionAddQueueLock;
         std::deque<WorldSession*> m_sessionAddQueue;
 
+        // login admission, spreads a reconnect surge over several ticks, served round robin per remote address
+        void QueueForAdmission(WorldSession* s);
+        void RemoveClosedAdmissions();
+        void AdmitQueuedSessions(uint32 diff);
+        void SendAdmissionQueuePositions();
+
+        MaNGOS::TokenBucket m_sessionAdmission;
+        std::map<std::string, std::deque<WorldSession*>> m_admissionQueue;
+        std::deque<std::string> m_admissionOrder;            // addresses with waiting sessions, in service order
+        uint32 m_admissionQueueSize;
+        ShortIntervalTimer m_admissionStatusTimer;
+
         // used versions
         std::string m_DBVersion;
         std::string m_CreatureEventAIVersion;
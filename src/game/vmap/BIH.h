@@ -117,6 +117,7 @@ class BIH
             delete[] dat.indices;
         }
         size_t primCount() const { return objects.size(); }
+        size_t GetMemoryUsage() const { return (tree.capacity() + objects.capacity()) * sizeof(uint32); }
 
         template<typename RayCallback>
         void intersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst = false, bool ignoreM2Model = false) const
@@ -134,6 +134,11 @@ namespace VMAP
         delete[] iTreeValues;
     }
 
+    size_t StaticMapTree::GetMemoryUsage() const
+    {
+        return sizeof(StaticMapTree) + iTree.GetMemoryUsage() + iNTreeValues * sizeof(ModelInstance);
+    }
+
     //=========================================================
     /**
     If intersection is found within pMaxDist, sets pMaxDist to intersection distance and returns true.
@@ -97,6 +97,8 @@ namespace VMAP
             void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
             bool isTiled() const { return iIsTiled; }
             uint32 numLoadedTiles() const { return iLoadedTiles.size(); }
+            //! tree and instance slots, fixed once InitMap() succeeded
+            size_t GetMemoryUsage() const;
 
 #ifdef MMAP_GENERATOR
         public:
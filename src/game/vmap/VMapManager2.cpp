@@ -25,6 +25,7 @@
 #include "WorldModel.h"
 #include "VMapDefinitions.h"
 #include "Maps/GridMapDefines.h"
+#include "Util/MemoryTracker.h"
 
 using G3D::Vector3;
 
@@ -42,10 +43,13 @@ namespace VMAP
     {
         for (auto& iInstanceMapTree : iInstanceMapTrees)
         {
+            if (iInstanceMapTree.second)
+                MemoryTracker::Free(MEMORY_TAG_VMAP, iInstanceMapTree.second->GetMemoryUsage());
             delete iInstanceMapTree.second;
         }
         for (auto& iLoadedModelFile : iLoadedModelFiles)
         {
+            MemoryTracker::Free(MEMORY_TAG_VMAP, iLoadedModelFile.second.getModel()->GetMemoryUsage());
             delete iLoadedModelFile.second.getModel();
         }
     }
@@ -140,6 +144,8 @@ namespace VMAP
                 return false;
             }
 
+            MemoryTracker::Allocate(MEMORY_TAG_VMAP, newTree->GetMemoryUsage());
+
             // insert new data
             {
                 std::lock_guard<std::mutex> lock(m_vmStaticMapMutex);
@@ -159,6 +165,7 @@ namespace VMAP
             instanceTree->second->UnloadMap(this);
             if (instanceTree->second->numLoadedTiles() == 0)
             {
+                MemoryTracker::Free(MEMORY_TAG_VMAP, instanceTree->second->GetMemoryUsage());
                 delete instanceTree->second;
                 instanceTree->second = nullptr;
             }
@@ -175,6 +182,7 @@ namespace VMAP
             instanceTree->second->UnloadMapTile(x, y, this);
             if (instanceTree->second->numLoadedTiles() == 0)
             {
+                MemoryTracker::Free(MEMORY_TAG_VMAP, instanceTree->second->GetMemoryUsage());
                 delete instanceTree->second;
                 instanceTree->second = nullptr;
             }
@@ -320,6 +328,8 @@ namespace VMAP
                 return nullptr;
             }
 
+            MemoryTracker::Allocate(MEMORY_TAG_VMAP, worldmodel->GetMemoryUsage());
+
             // insert new data
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: loading file '%s%s'.", basepath.c_str(), filename.c_str());
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
@@ -340,6 +350,7 @@ namespace VMAP
         if (model->second.decRefCount() == 0)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: unloading file '%s'", filename.c_str());
+            MemoryTracker::Free(MEMORY_TAG_VMAP, model->second.getModel()->GetMemoryUsage());
             delete model->second.getModel();
             iLoadedModelFiles.erase(model);
         }
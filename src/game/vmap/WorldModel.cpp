@@ -209,6 +209,13 @@ namespace VMAP
                iTilesX * iTilesY;
     }
 
+    size_t WmoLiquid::GetMemoryUsage() const
+    {
+        return sizeof(WmoLiquid) +
+               (iTilesX + 1) * (iTilesY + 1) * sizeof(float) +
+               iTilesX * iTilesY;
+    }
+
     bool WmoLiquid::writeToFile(FILE* wf)
     {
         bool result = true;
@@ -404,6 +411,14 @@ namespace VMAP
         return 0;
     }
 
+    size_t GroupModel::GetMemoryUsage() const
+    {
+        return vertices.capacity() * sizeof(Vector3) +
+               triangles.capacity() * sizeof(MeshTriangle) +
+               meshTree.GetMemoryUsage() +
+               (iLiquid ? iLiquid->GetMemoryUsage() : 0);
+    }
+
     // ===================== WorldModel ==================================
 
     void WorldModel::setGroupModels(std::vector<GroupModel>& models)
@@ -412,6 +427,14 @@ namespace VMAP
         groupTree.build(groupModels, BoundsTrait<GroupModel>::getBounds, 1);
     }
 
+    size_t WorldModel::GetMemoryUsage() const
+    {
+        size_t size = sizeof(WorldModel) + groupModels.capacity() * sizeof(GroupModel) + groupTree.GetMemoryUsage();
+        for (GroupModel const& groupModel : groupModels)
+            size += groupModel.GetMemoryUsage();
+        return size;
+    }
+
     struct WModelRayCallBack
     {
         WModelRayCallBack(const std::vector<GroupModel>& mod): models(mod.begin()), hit(false) {}
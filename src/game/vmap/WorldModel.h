@@ -57,6 +57,7 @@ namespace VMAP
             float* GetHeightStorage() const { return iHeight; }
             uint8* GetFlagsStorage() const { return iFlags; }
             uint32 GetFileSize() const;
+            size_t GetMemoryUsage() const;
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid*& out);
         private:
@@ -95,6 +96,8 @@ namespace VMAP
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
+            //! heap memory held by the group, not counting the object itself
+            size_t GetMemoryUsage() const;
         protected:
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
@@ -125,6 +128,7 @@ namespace VMAP
             bool readFile(const std::string& filename);
             void setModelFlags(uint32 newFlags) { modelFlags = newFlags; }
             uint32 getModelFlags() const { return modelFlags; }
+            size_t GetMemoryUsage() const;
         protected:
             uint32 RootWMOID;
             std::vector<GroupModel> groupModels;
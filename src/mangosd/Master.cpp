@@ -228,6 +228,8 @@ int Master::Run()
         std::string bindIp = sConfig.GetStringDefault("BindIP", "0.0.0.0");
         int32 port = int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD));
         MaNGOS::AsyncListener<WorldSocket> listener(m_context, bindIp, port);
+        listener.SetAdmissionControl(sConfig.GetIntDefault("Network.AdmissionRate", 0), sConfig.GetIntDefault("Network.AdmissionBurst", 100),
+                                     sConfig.GetIntDefault("Network.AdmissionMaxPendingPerIP", 10));
 
         std::vector<std::thread> threads;
         for (int32 i = 0; i < networkThreadCount; ++i)
@@ -25,6 +25,7 @@
 #include "WorldRunnable.h"
 #include "Util/Timer.h"
 #include "Maps/MapManager.h"
+#include "Util/Tracer.h"
 
 #include "Database/DatabaseEnv.h"
 
@@ -41,6 +42,7 @@ void WorldRunnable::run()
     ///- Init new SQL thread for the world database
     WorldDatabase.ThreadStart();                            // let thread do safe mySQL requests (one connection call enough)
     sWorld.InitResultQueue();
+    Tracer::SetThreadName("world");
 
     uint32 diffTick = WorldTimer::tick(); // initialize world timer vars
     uint32 diffTime = 0; // used to compute real time elapsed in World::Update()
@@ -54,6 +56,7 @@ void WorldRunnable::run()
         diffTick = WorldTimer::tick();
         sWorld.Update(diffTick);
         diffTime = WorldTimer::getMSTime() - WorldTimer::tickTime();
+        sTracer.CheckSlowTick(diffTime);
 
         // we have to wait WORLD_SLEEP_CONST max between loops
         // don't wait if over
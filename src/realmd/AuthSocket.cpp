@@ -40,6 +40,43 @@
 //#include "Util/Util.h" -- for commented utf8ToUpperOnlyLatin
 
 extern DatabaseType LoginDatabase;
+extern boost::asio::io_context LoginDatabaseContext;
+
+std::atomic<uint32> AuthSocket::s_pendingQueries(0);
+
+namespace
+{
+    struct LogonChallengeQuery
+    {
+        std::unique_ptr<QueryResult> ipBanned;
+        std::unique_ptr<QueryResult> account;
+        std::unique_ptr<QueryResult> accountBanned;
+    };
+
+    struct RealmListQuery
+    {
+        std::unique_ptr<QueryResult> account;
+        RealmCharacterCounts numChars;
+    };
+}
+
+/// Runs query on a login database worker so no I/O thread blocks on the database, then hands its
+/// result to handler on this socket's executor. Handlers of one socket never run concurrently,
+/// as the next packet is only read once the previous handler has finished.
+template <typename Query, typename Handler>
+void AuthSocket::AsyncQuery(Query query, Handler handler)
+{
+    ++s_pendingQueries;
+    boost::asio::post(LoginDatabaseContext, [self = shared_from_this(), query = std::move(query), handler = std::move(handler)]() mutable
+    {
+        --s_pendingQueries;
+        auto result = std::make_shared<decltype(query())>(query());
+        boost::asio::post(self->GetAsioSocket().get_executor(), [self, result, handler = std::move(handler)]() mutable
+        {
+            handler(*result);
+        });
+    });
+}
 
 enum AccountFlags
 {
@@ -398,147 +435,161 @@ bool AuthSocket::_HandleLogonChallenge()
             // Memory will be freed on AuthSocket object destruction
             self->_safelogin = self->_login;
             LoginDatabase.escape_string(self->_safelogin);
-            self->_safelocale = self->m_locale;
-            LoginDatabase.escape_string(self->_safelocale);
-            LoginDatabase.escape_string(self->m_os);
 
             *pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
             *pkt << uint8(0x00);
 
-            ///- Verify that this IP is not in the ip_banned table
-            // No SQL injection possible (paste the IP address as passed by the socket)
-            std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", self->GetRemoteAddress().c_str()));
-
-            if (ip_banned_result)
-            {
-                *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
-            }
-            else
+            ///- Look up ip ban, account and account ban on a database worker, the I/O thread is free meanwhile
+            self->AsyncQuery([address = self->GetRemoteAddress(), safelogin = self->_safelogin]()
             {
+                std::shared_ptr<LogonChallengeQuery> query = std::make_shared<LogonChallengeQuery>();
+
+                ///- Verify that this IP is not in the ip_banned table
+                // No SQL injection possible (paste the IP address as passed by the socket)
+                query->ipBanned = LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
+                    "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", address.c_str());
+                if (query->ipBanned)
+                    return query;
+
                 ///- Get the account details from the account table
                 // No SQL injection (escaped user name)
-                auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", self->_safelogin.c_str());
-                if (queryResult)
+                query->account = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", safelogin.c_str());
+                if (!query->account)
+                    return query;
+
+                ///- If the account is banned, the logon attempt will be rejected
+                query->accountBanned = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
+                    "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", query->account->Fetch()[0].GetUInt32());
+                return query;
+            },
+            [self, pkt](std::shared_ptr<LogonChallengeQuery>& query)
+            {
+                if (query->ipBanned)
                 {
-                    Field* fields = queryResult->Fetch();
-
-                    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-                    bool locked = false;
-                    if (fields[1].GetUInt8() == 1)               // if ip is locked
-                    {
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
-                        DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
-                        if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
-                        {
-                            DEBUG_LOG("[AuthChallenge] Account IP differs");
-                            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                            locked = true;
-                        }
-                        else
-                            DEBUG_LOG("[AuthChallenge] Account IP matches");
-                    }
-                    else
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
-
-                    std::string databaseV = fields[4].GetCppString();
-                    std::string databaseS = fields[5].GetCppString();
-                    bool broken = false;
-
-                    if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
+                    *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                    BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
+                }
+                else
+                {
+                    if (query->account)
                     {
-                        *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                        DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
-                        broken = true;
-                    }
+                        Field* fields = query->account->Fetch();
 
-                    if (!locked && !broken)
-                    {
-                        ///- If the account is banned, reject the logon attempt
-                        auto banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                            "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", fields[0].GetUInt32());
-                        if (banresult)
+                        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+                        bool locked = false;
+                        if (fields[1].GetUInt8() == 1)               // if ip is locked
                         {
-                            if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
-                                BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
-                            }
-                            else
+                            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
+                            DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
+                            if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
                             {
+                                DEBUG_LOG("[AuthChallenge] Account IP differs");
                                 *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                                BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
+                                locked = true;
                             }
+                            else
+                                DEBUG_LOG("[AuthChallenge] Account IP matches");
                         }
                         else
-                        {
-                            DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                            BigNumber s;
-                            s.SetHexStr(databaseS.c_str());
-
-                            self->srp.CalculateHostPublicEphemeral();
-
-                            ///- Fill the response packet with the result
-                            *pkt << uint8(AUTH_LOGON_SUCCESS);
-
-                            // B may be calculated < 32B so we force minimal length to 32B
-                            pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
-                            *pkt << uint8(1);
-                            pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
-                            *pkt << uint8(32);
-                            pkt->append(self->srp.GetPrime().AsByteArray(32));
-                            pkt->append(s.AsByteArray());// 32 bytes
-                            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-                            uint8 securityFlags = 0;
+                            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
 
-                            self->_token = fields[6].GetCppString();
-                            if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
-                                securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+                        std::string databaseV = fields[4].GetCppString();
+                        std::string databaseS = fields[5].GetCppString();
+                        bool broken = false;
 
-                            if (!self->_token.empty() && self->_build <= 6141)
-                                securityFlags = SECURITY_FLAG_PIN;
-
-                            *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+                        if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
+                        {
+                            *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                            DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
+                            broken = true;
+                        }
 
-                            if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+                        if (!locked && !broken)
+                        {
+                            ///- If the account is banned, reject the logon attempt
+                            if (auto& banresult = query->accountBanned)
                             {
-                                uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
-                                EndianConvert(gridSeedPkt);
-                                self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
-                                self->m_promptPin = true;
-
-                                *pkt << gridSeedPkt;
-                                pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
+                                if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
+                                {
+                                    *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
+                                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
+                                }
+                                else
+                                {
+                                    *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
+                                }
                             }
-
-                            if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+                            else
                             {
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint64(0);
-                            }
+                                DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-                            if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                                *pkt << uint8(1);
+                                BigNumber s;
+                                s.SetHexStr(databaseS.c_str());
+
+                                self->srp.CalculateHostPublicEphemeral();
 
-                            uint8 secLevel = fields[3].GetUInt8();
-                            self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                                ///- Fill the response packet with the result
+                                *pkt << uint8(AUTH_LOGON_SUCCESS);
 
-                            ///- All good, await client's proof
-                            self->_status = STATUS_LOGON_PROOF;
+                                // B may be calculated < 32B so we force minimal length to 32B
+                                pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
+                                *pkt << uint8(1);
+                                pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
+                                *pkt << uint8(32);
+                                pkt->append(self->srp.GetPrime().AsByteArray(32));
+                                pkt->append(s.AsByteArray());// 32 bytes
+                                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                                uint8 securityFlags = 0;
+
+                                self->_token = fields[6].GetCppString();
+                                if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
+                                    securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+
+                                if (!self->_token.empty() && self->_build <= 6141)
+                                    securityFlags = SECURITY_FLAG_PIN;
+
+                                *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+
+                                if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+                                {
+                                    uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
+                                    EndianConvert(gridSeedPkt);
+                                    self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
+                                    self->m_promptPin = true;
+
+                                    *pkt << gridSeedPkt;
+                                    pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
+                                }
+
+                                if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+                                {
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint64(0);
+                                }
+
+                                if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
+                                    *pkt << uint8(1);
+
+                                uint8 secLevel = fields[3].GetUInt8();
+                                self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                                self->_accountId = fields[0].GetUInt32();
+
+                                ///- All good, await client's proof
+                                self->_status = STATUS_LOGON_PROOF;
+                            }
                         }
                     }
+                    else                                            // no account
+                        *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
                 }
-                else                                                // no account
-                    *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
-            }
 
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-            self->ProcessIncomingData();
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                self->ProcessIncomingData();
+            });
         });
     });
 
@@ -655,12 +706,21 @@ bool AuthSocket::_HandleLogonProof()
             BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", self->_login.c_str());
 
             uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
-            if (MaxWrongPassCount > 0)
+            if (MaxWrongPassCount == 0)
             {
-                // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-                LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", self->_safelogin.c_str());
+                self->ProcessIncomingData();
+                return;
+            }
 
-                if (auto loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", self->_safelogin.c_str()))
+            // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+            self->AsyncQuery([safelogin = self->_safelogin]()
+            {
+                LoginDatabase.DirectPExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", safelogin.c_str());
+                return LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", safelogin.c_str());
+            },
+            [self, MaxWrongPassCount](std::unique_ptr<QueryResult>& loginfail)
+            {
+                if (loginfail)
                 {
                     Field* fields = loginfail->Fetch();
                     uint32 failed_logins = fields[1].GetUInt32();
@@ -690,8 +750,8 @@ bool AuthSocket::_HandleLogonProof()
                         }
                     }
                 }
-            }
-            self->ProcessIncomingData();
+                self->ProcessIncomingData();
+            });
         }
     });
 
@@ -750,32 +810,37 @@ bool AuthSocket::_HandleReconnectChallenge()
             EndianConvert(body->build);
             self->_build = body->build;
 
-            auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", self->_safelogin.c_str());
-
-            // Stop if the account is not found
-            if (!queryResult)
+            self->AsyncQuery([safelogin = self->_safelogin]()
             {
-                sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
-                self->Close();
-                return;
-            }
+                return LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", safelogin.c_str());
+            },
+            [self](std::unique_ptr<QueryResult>& queryResult)
+            {
+                // Stop if the account is not found
+                if (!queryResult)
+                {
+                    sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
+                    self->Close();
+                    return;
+                }
 
-            Field* fields = queryResult->Fetch();
-            self->srp.SetStrongSessionKey(fields[0].GetString());
+                Field* fields = queryResult->Fetch();
+                self->srp.SetStrongSessionKey(fields[0].GetString());
 
-            ///- All good, await client's proof
-            self->_status = STATUS_RECON_PROOF;
+                ///- All good, await client's proof
+                self->_status = STATUS_RECON_PROOF;
 
-            ///- Sending response
-            std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
-            *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
-            *pkt << (uint8)0x00;
-            self->_reconnectProof.SetRand(16 * 8);
-            pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
-            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                ///- Sending response
+                std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+                *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
+                *pkt << (uint8)0x00;
+                self->_reconnectProof.SetRand(16 * 8);
+                pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
+                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
 
-            self->ProcessIncomingData();
+                self->ProcessIncomingData();
+            });
         });
     });
 
@@ -852,186 +917,78 @@ bool AuthSocket::_HandleRealmList()
             return;
         }
 
-        // Get the user id (else close the connection)
-        // No SQL injection (escaped user name)
-
-        auto queryResult = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", self->_safelogin.c_str());
-        if (!queryResult)
+        self->AsyncQuery([safelogin = self->_safelogin]()
         {
-            sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
-            self->Close();
-            return;
-        }
-
-        uint32 id = (*queryResult)[0].GetUInt32();
-        uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
-
-        ///- Update realm list if need
-        sRealmList.UpdateIfNeed();
-
-        ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-        ByteBuffer pkt;
-        self->LoadRealmlist(pkt, id, accountSecurityLevel);
-
-        std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
-        *hdr << (uint8)CMD_REALM_LIST;
-        *hdr << (uint16)pkt.size();
-        hdr->append(pkt);
-
-        self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-        self->ProcessIncomingData();
-    });
+            std::shared_ptr<RealmListQuery> query = std::make_shared<RealmListQuery>();
 
-    return true;
-}
+            // Get the user id (else close the connection)
+            // No SQL injection (escaped user name)
+            query->account = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", safelogin.c_str());
+            if (!query->account)
+                return query;
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
-{
-    switch (_build)
-    {
-        case 5875:                                          // 1.12.1
-        case 6005:                                          // 1.12.2
-        case 6141:                                          // 1.12.3
-        {
-            pkt << uint32(0);                               // unused value
-            pkt << uint8(getEligibleRealmCount(securityLevel));
+            uint32 accountId = (*query->account)[0].GetUInt32();
 
-            for (const auto& i : sRealmList)
+            // clients re-request the list every few seconds while on the realm screen
+            if (!sRealmList.GetCachedCharacterCounts(accountId, query->numChars))
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
+                // character counts of all realms in one round-trip
+                if (auto queryResult = LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", accountId))
                 {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                RealmFlags realmflags = i.second.realmflags;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
-                std::string name = i.first;
-                if (realmflags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    char buf[20];
-                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
-                    name += buf;
+                    do
+                    {
+                        Field* fields = queryResult->Fetch();
+                        query->numChars[fields[0].GetUInt32()] = fields[1].GetUInt8();
+                    }
+                    while (queryResult->NextRow());
                 }
-
-                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
-                if (!ok_build || (i.second.allowedSecurityLevel > _accountSecurityLevel))
-                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
-
-                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(_build, RealmZone(i.second.timezone));
-
-                pkt << uint32(i.second.icon);              // realm type
-                pkt << uint8(realmflags);                   // realmflags
-                pkt << name;                                // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(categoryId);                   // realm category
-                pkt << uint8(0x00);                         // unk, may be realm number/id?
+                sRealmList.CacheCharacterCounts(accountId, query->numChars);
             }
 
-            pkt << uint16(0x0002);                          // unused value (why 2?)
-            break;
-        }
+            ///- Update realm list if need
+            sRealmList.UpdateIfNeed();
 
-        case 8606:                                          // 2.4.3
-        case 10505:                                         // 3.2.2a
-        case 11159:                                         // 3.3.0a
-        case 11403:                                         // 3.3.2
-        case 11723:                                         // 3.3.3a
-        case 12340:                                         // 3.3.5a
-        default:                                            // and later
+            return query;
+        },
+        [self](std::shared_ptr<RealmListQuery>& query)
         {
-            pkt << uint32(0);                               // unused value
-            pkt << uint16(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
+            if (!query->account)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                uint8 lock = (i.second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
-
-                RealmFlags realmFlags = i.second.realmflags;
-
-                // Show offline state for unsupported client builds
-                if (!ok_build)
-                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
-
-                if (!buildInfo)
-                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+                sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
+                self->Close();
+                return;
+            }
 
-                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(_build, RealmZone(i.second.timezone));
+            uint8 accountSecurityLevel = (*query->account)[1].GetUInt8();
 
-                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
-                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
-                pkt << uint8(realmFlags);                   // see enum RealmFlags
-                pkt << i.first;                            // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(categoryId);                   // realm category (Cfg_Categories.dbc)
-                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+            ///- Copy the prebuilt realm list into the return packet and patch in # of user characters in each realm
+            std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
+            *hdr << (uint8)CMD_REALM_LIST;
+            *hdr << (uint16)0;                              // size, set below
+            self->LoadRealmlist(*hdr, query->numChars, accountSecurityLevel);
+            hdr->put<uint16>(1, uint16(hdr->size() - 3));
 
-                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    pkt << uint8(buildInfo->major_version);
-                    pkt << uint8(buildInfo->minor_version);
-                    pkt << uint8(buildInfo->bugfix_version);
-                    pkt << uint16(_build);
-                }
-            }
+            self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+            self->ProcessIncomingData();
+        });
+    });
 
-            pkt << uint16(0x0010);                          // unused value (why 10?)
-            break;
-        }
-    }
+    return true;
 }
 
-uint8 AuthSocket::getEligibleRealmCount(uint8 accountSecurityLevel)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, RealmCharacterCounts const& numChars, uint8 securityLevel)
 {
-    uint8 size = 0;
-    for (const auto& i : sRealmList)
-        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
-            size++;
+    std::shared_ptr<RealmListPacket const> realmList = sRealmList.GetRealmListPacket(_build, securityLevel, _accountSecurityLevel);
+
+    size_t start = pkt.wpos();
+    pkt.append(realmList->data);
 
-    return size;
+    for (auto const& numCharsPos : realmList->numCharsPos)
+    {
+        auto numCharsItr = numChars.find(numCharsPos.first);
+        if (numCharsItr != numChars.end())
+            pkt.put<uint8>(start + numCharsPos.second, numCharsItr->second);
+    }
 }
 
 /// Resume patch transfer
@@ -1148,25 +1105,39 @@ void AuthSocket::verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLog
     BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
     ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
-    // No SQL injection (escaped user input) and IP address as received by socket
+    // The session key must be stored before the client is told it may connect to the world server
     const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
-    // Note: In case of heavy load, this sync query will be a heavy bottleneck
-    LoginDatabase.DirectPExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-    std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-    if (loginfail)
-        LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s'," _NOW_ ",'%u')", loginfail->Fetch()[0].GetUInt32(), GetRemoteAddress().c_str(), LOGIN_TYPE_REALMD);
-    OPENSSL_free((void*)K_hex);
-
-    ///- Finish SRP6 and send the final result to the client
-    Sha1Hash sha;
-    srp.Finalize(sha);
+    AsyncQuery([sessionKey = std::string(K_hex), locale = m_locale, os = m_os, platform = m_platform, login = _login, accountId = _accountId, address = GetRemoteAddress()]()
+    {
+        static SqlStatementID updateAccount;
+        static SqlStatementID insertLogon;
+
+        SqlStatement stmt = LoginDatabase.CreateStatement(updateAccount, "UPDATE account SET sessionkey = ?, locale = ?, failed_logins = 0, os = ?, platform = ? WHERE username = ?");
+        stmt.addString(sessionKey);
+        stmt.addString(locale);
+        stmt.addString(os);
+        stmt.addString(platform);
+        stmt.addString(login);
+        bool result = stmt.DirectExecute();
+
+        stmt = LoginDatabase.CreateStatement(insertLogon, "INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES(?,?," _NOW_ ",?)");
+        stmt.PExecute(accountId, address.c_str(), uint32(LOGIN_TYPE_REALMD));
+        return result;
+    },
+    [self = shared_from_this()](bool /*result*/)
+    {
+        ///- Finish SRP6 and send the final result to the client
+        Sha1Hash sha;
+        self->srp.Finalize(sha);
 
-    SendProof(sha);
+        self->SendProof(sha);
 
-    ///- Set _status to authed!
-    _status = STATUS_AUTHED;
+        ///- Set _status to authed!
+        self->_status = STATUS_AUTHED;
 
-    ProcessIncomingData();
+        self->ProcessIncomingData();
+    });
+    OPENSSL_free((void*)K_hex);
 }
 
 int32 AuthSocket::generateToken(char const* b32key)
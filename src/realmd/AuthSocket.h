@@ -28,12 +28,15 @@
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
 #include "Util/ByteBuffer.h"
+#include "RealmList.h"
 
 #include "Network/AsyncSocket.hpp"
 
 #include <boost/asio.hpp>
 
+#include <atomic>
 #include <functional>
+#include <map>
 
 #define HMAC_RES_SIZE 20
 
@@ -50,12 +53,10 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         bool OnOpen() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void LoadRealmlist(ByteBuffer& pkt, RealmCharacterCounts const& numChars, uint8 accountSecurityLevel = 0);
         bool VerifyPinData(uint32 pin, const sAuthLogonPinData_C& clientData);
         int32 generateToken(char const* b32key);
 
-        uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
-
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -68,9 +69,15 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         bool _HandleXferCancel();
         bool _HandleXferAccept();
 
+        // queries posted to the login database workers and not yet started
+        static uint32 GetPendingQueryCount() { return s_pendingQueries; }
+
     private:
         void verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLogonProof_C> lp);
 
+        template <typename Query, typename Handler>
+        void AsyncQuery(Query query, Handler handler);
+
         enum eStatus
         {
             STATUS_CHALLENGE,
@@ -92,9 +99,9 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         std::string m_os;
         std::string m_platform;
         std::string m_locale;
-        std::string _safelocale;
         uint16 _build;
         AccountTypes _accountSecurityLevel;
+        uint32 _accountId = 0;
 
         BigNumber m_serverSecuritySalt;
         uint32 m_gridSeed = 0;
@@ -102,6 +109,8 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
 
         boost::asio::deadline_timer m_timeoutTimer;
 
+        static std::atomic<uint32> s_pendingQueries;
+
         virtual bool ProcessIncomingData() override;
 };
 #endif
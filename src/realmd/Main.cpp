@@ -33,6 +33,10 @@
 #include "Util/Util.h"
 #include "Network/AsyncListener.hpp"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 #include <openssl/opensslv.h>
 #include <openssl/crypto.h>
 #include <openssl/provider.h>
@@ -74,6 +78,25 @@ bool restart = false;
 DatabaseType LoginDatabase;                                 // Accessor to the realm server database
 
 boost::asio::io_context context;
+boost::asio::io_context LoginDatabaseContext;               // Login database workers, so network threads never block on queries
+
+#ifdef BUILD_METRICS
+namespace
+{
+    metric::gauge g_loginDatabaseQueueMetric("database.queue", { { "database", "login" } });
+    metric::gauge g_pendingQueriesMetric("realmd.queries.pending");
+    metric::counter g_socketReceivedMetric("network.bytes.received");
+    metric::counter g_socketSentMetric("network.bytes.sent");
+
+    void UpdateMetrics()
+    {
+        g_loginDatabaseQueueMetric.set(LoginDatabase.GetDelayQueueSize());
+        g_pendingQueriesMetric.set(AuthSocket::GetPendingQueryCount());
+        g_socketReceivedMetric.advance(MaNGOS::SocketStatistics::bytesReceived);
+        g_socketSentMetric.advance(MaNGOS::SocketStatistics::bytesSent);
+    }
+}
+#endif
 
 // Launch the realm server
 int main(int argc, char* argv[])
@@ -223,7 +246,7 @@ int main(int argc, char* argv[])
     }
 
     // Get the list of realms for the server
-    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20));
+    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20), sConfig.GetIntDefault("RealmCharacterCountsCacheTime", 10));
     if (sRealmList.size() == 0)
     {
         sLog.outError("No valid realms specified.");
@@ -243,11 +266,27 @@ int main(int argc, char* argv[])
             sConfig.GetStringDefault("BindIP", "0.0.0.0"),
             sConfig.GetIntDefault("RealmServerPort", DEFAULT_REALMSERVER_PORT)
     );
+    listener.SetAdmissionControl(sConfig.GetIntDefault("AdmissionRate", 0), sConfig.GetIntDefault("AdmissionBurst", 100),
+                                 sConfig.GetIntDefault("AdmissionMaxPendingPerIP", 10));
 
     std::vector<std::thread> threads;
     for (uint32 i = 0; i < networkThreadCount; ++i)
         threads.emplace_back([&]() { context.run(); });
 
+    // one worker per query connection
+    uint32 databaseThreadCount = std::max(1, sConfig.GetIntDefault("LoginDatabaseConnections", 2));
+    auto databaseWork = boost::asio::make_work_guard(LoginDatabaseContext);
+    std::vector<std::thread> databaseThreads;
+    for (uint32 i = 0; i < databaseThreadCount; ++i)
+    {
+        databaseThreads.emplace_back([&]()
+        {
+            LoginDatabase.ThreadStart();
+            LoginDatabaseContext.run();
+            LoginDatabase.ThreadEnd();
+        });
+    }
+
     // Catch termination signals
     HookSignals();
 
@@ -301,6 +340,11 @@ int main(int argc, char* argv[])
     auto const numLoops = sConfig.GetIntDefault("MaxPingTime", 30) * MINUTE * 10;
     uint32 loopCounter = 0;
 
+#ifdef BUILD_METRICS
+    // start the configured exporters
+    metric::metric::instance();
+#endif
+
 #ifndef _WIN32
     detachDaemon();
 #endif
@@ -313,6 +357,10 @@ int main(int argc, char* argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+#ifdef BUILD_METRICS
+        if (loopCounter % 10 == 0)
+            UpdateMetrics();
+#endif
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
@@ -325,6 +373,12 @@ int main(int argc, char* argv[])
     for (uint32 i = 0; i < networkThreadCount; ++i)
         threads[i].join();
 
+    databaseWork.reset();
+    LoginDatabaseContext.stop();
+
+    for (auto& thread : databaseThreads)
+        thread.join();
+
     // Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -366,9 +420,10 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    int nConnections = std::max(1, sConfig.GetIntDefault("LoginDatabaseConnections", 2));
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
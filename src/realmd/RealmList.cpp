@@ -100,7 +100,15 @@ uint8 GetRealmCategoryIdByBuildAndZone(uint16 _build, RealmZone _realmZone)
     return buildInfo ? RealmCategoryIdsByRealmZoneByMajorVersion[buildInfo->major_version][_realmZone] : _realmZone;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+namespace
+{
+    uint32 MakeRealmListPacketKey(uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel)
+    {
+        return uint32(build) | (uint32(securityLevel) << 16) | (uint32(accountSecurityLevel) << 24);
+    }
+}
+
+RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr)), m_characterCountsCacheTime(0)
 {
 }
 
@@ -111,18 +119,19 @@ RealmList& sRealmList
 }
 
 /// Load the realm list from the database
-void RealmList::Initialize(uint32 updateInterval)
+void RealmList::Initialize(uint32 updateInterval, uint32 characterCountsCacheTime)
 {
     m_UpdateInterval = updateInterval;
+    m_characterCountsCacheTime = characterCountsCacheTime;
 
     ///- Get the content of the realmlist table in the database
     UpdateRealms(true);
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
 {
     ///- Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID       = ID;
     realm.icon       = icon;
@@ -160,17 +169,77 @@ void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::strin
 
 void RealmList::UpdateIfNeed()
 {
-    // maybe disabled or updated recently
-    if (!m_UpdateInterval || m_NextUpdateTime > time(nullptr))
-        return;
+    {
+        std::lock_guard<std::mutex> guard(m_realmsLock);
 
-    m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
+        // maybe disabled or updated recently
+        if (!m_UpdateInterval || m_NextUpdateTime > time(nullptr))
+            return;
 
-    // Clears Realm list
-    m_realms.clear();
+        m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
+    }
 
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
+
+    // drop expired character counts so accounts which logged in once do not stay cached forever
+    std::lock_guard<std::mutex> guard(m_characterCountsLock);
+    time_t now = time(nullptr);
+    for (auto itr = m_characterCounts.begin(); itr != m_characterCounts.end();)
+    {
+        if (itr->second.expireTime <= now)
+            itr = m_characterCounts.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+uint32 RealmList::size() const
+{
+    std::lock_guard<std::mutex> guard(m_realmsLock);
+    return m_realms.size();
+}
+
+std::shared_ptr<RealmListPacket const> RealmList::GetRealmListPacket(uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel)
+{
+    uint32 packetKey = MakeRealmListPacketKey(build, securityLevel, accountSecurityLevel);
+
+    std::lock_guard<std::mutex> guard(m_realmsLock);
+
+    auto itr = m_realmListPackets.find(packetKey);
+    if (itr != m_realmListPackets.end())
+        return itr->second;
+
+    std::shared_ptr<RealmListPacket const> packet = BuildRealmListPacket(m_realms, packetKey);
+    m_realmListPackets[packetKey] = packet;
+    return packet;
+}
+
+bool RealmList::GetCachedCharacterCounts(uint32 accountId, RealmCharacterCounts& numChars)
+{
+    if (!m_characterCountsCacheTime)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_characterCountsLock);
+
+    auto itr = m_characterCounts.find(accountId);
+    if (itr == m_characterCounts.end() || itr->second.expireTime <= time(nullptr))
+        return false;
+
+    numChars = itr->second.numChars;
+    return true;
+}
+
+void RealmList::CacheCharacterCounts(uint32 accountId, RealmCharacterCounts const& numChars)
+{
+    if (!m_characterCountsCacheTime)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_characterCountsLock);
+
+    CachedCharacterCounts& cached = m_characterCounts[accountId];
+    cached.expireTime = time(nullptr) + m_characterCountsCacheTime;
+    cached.numChars = numChars;
 }
 
 void RealmList::UpdateRealms(bool init)
@@ -180,6 +249,8 @@ void RealmList::UpdateRealms(bool init)
     ////                                           0   1     2        3     4     5           6         7                     8           9
     auto queryResult = LoginDatabase.Query("SELECT id, name, address, port, icon, realmflags, timezone, allowedSecurityLevel, population, realmbuilds FROM realmlist WHERE (realmflags & 1) = 0 ORDER BY name");
 
+    RealmMap realms;
+
     ///- Circle through results and add them to the realm map
     if (queryResult)
     {
@@ -205,7 +276,7 @@ void RealmList::UpdateRealms(bool init)
             }
 
             UpdateRealm(
-                Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
+                realms, Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
                 fields[4].GetUInt8(), RealmFlags(realmflags), fields[6].GetUInt8(),
                 (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR),
                 fields[8].GetFloat(), fields[9].GetCppString());
@@ -215,4 +286,155 @@ void RealmList::UpdateRealms(bool init)
         }
         while (queryResult->NextRow());
     }
+
+    // rebuild the realm lists clients already asked for, outside of the lock, so requests never wait for it
+    RealmListPacketMap packets;
+    {
+        std::lock_guard<std::mutex> guard(m_realmsLock);
+        for (auto const& packet : m_realmListPackets)
+            packets[packet.first] = nullptr;
+    }
+
+    for (auto& packet : packets)
+        packet.second = BuildRealmListPacket(realms, packet.first);
+
+    std::lock_guard<std::mutex> guard(m_realmsLock);
+    m_realms.swap(realms);
+    m_realmListPackets.swap(packets);
+}
+
+uint8 RealmList::GetEligibleRealmCount(RealmMap const& realms, uint8 accountSecurityLevel)
+{
+    uint8 size = 0;
+    for (const auto& i : realms)
+        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
+            size++;
+
+    return size;
+}
+
+std::shared_ptr<RealmListPacket const> RealmList::BuildRealmListPacket(RealmMap const& realms, uint32 packetKey)
+{
+    uint16 build = uint16(packetKey & 0xFFFF);
+    uint8 securityLevel = uint8(packetKey >> 16);
+    AccountTypes accountSecurityLevel = AccountTypes(packetKey >> 24);
+
+    std::shared_ptr<RealmListPacket> packet = std::make_shared<RealmListPacket>();
+    ByteBuffer& pkt = packet->data;
+
+    switch (build)
+    {
+        case 5875:                                          // 1.12.1
+        case 6005:                                          // 1.12.2
+        case 6141:                                          // 1.12.3
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint8(GetEligibleRealmCount(realms, securityLevel));
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = i.second.realmbuilds.find(build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmflags = i.second.realmflags;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
+                std::string name = i.first;
+                if (realmflags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    char buf[20];
+                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
+                    name += buf;
+                }
+
+                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
+                if (!ok_build || (i.second.allowedSecurityLevel > accountSecurityLevel))
+                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
+
+                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(build, RealmZone(i.second.timezone));
+
+                pkt << uint32(i.second.icon);               // realm type
+                pkt << uint8(realmflags);                   // realmflags
+                pkt << name;                                // name
+                pkt << i.second.address;                    // address
+                pkt << float(i.second.populationLevel);
+                packet->numCharsPos.emplace_back(i.second.m_ID, pkt.wpos());
+                pkt << uint8(0);                            // numchars, patched in per account
+                pkt << uint8(categoryId);                   // realm category
+                pkt << uint8(0x00);                         // unk, may be realm number/id?
+            }
+
+            pkt << uint16(0x0002);                          // unused value (why 2?)
+            break;
+        }
+
+        case 8606:                                          // 2.4.3
+        case 10505:                                         // 3.2.2a
+        case 11159:                                         // 3.3.0a
+        case 11403:                                         // 3.3.2
+        case 11723:                                         // 3.3.3a
+        case 12340:                                         // 3.3.5a
+        default:                                            // and later
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint16(GetEligibleRealmCount(realms, securityLevel));
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = i.second.realmbuilds.find(build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                uint8 lock = (i.second.allowedSecurityLevel > accountSecurityLevel) ? 1 : 0;
+
+                RealmFlags realmFlags = i.second.realmflags;
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+
+                if (!buildInfo)
+                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+
+                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(build, RealmZone(i.second.timezone));
+
+                pkt << uint8(i.second.icon);                // realm type (this is second column in Cfg_Configs.dbc)
+                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
+                pkt << uint8(realmFlags);                   // see enum RealmFlags
+                pkt << i.first;                             // name
+                pkt << i.second.address;                    // address
+                pkt << float(i.second.populationLevel);
+                packet->numCharsPos.emplace_back(i.second.m_ID, pkt.wpos());
+                pkt << uint8(0);                            // numchars, patched in per account
+                pkt << uint8(categoryId);                   // realm category (Cfg_Categories.dbc)
+                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+
+                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    pkt << uint8(buildInfo->major_version);
+                    pkt << uint8(buildInfo->minor_version);
+                    pkt << uint8(buildInfo->bugfix_version);
+                    pkt << uint16(build);
+                }
+            }
+
+            pkt << uint16(0x0010);                          // unused value (why 10?)
+            break;
+        }
+    }
+
+    return packet;
 }
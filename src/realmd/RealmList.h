@@ -24,7 +24,12 @@
 #define _REALMLIST_H
 
 #include "Common.h"
+#include "Util/ByteBuffer.h"
+
 #include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 struct RealmBuildInfo
 {
@@ -41,6 +46,7 @@ RealmBuildInfo const* FindBuildInfo(uint16 _build);
 uint8 GetRealmCategoryIdByBuildAndZone(uint16 _build, RealmZone _realmZone);
 
 typedef std::set<uint32> RealmBuilds;
+typedef std::map<uint32, uint8> RealmCharacterCounts;      // realm id -> numchars
 
 /// Storage object for a realm
 struct Realm
@@ -56,6 +62,13 @@ struct Realm
     RealmBuildInfo realmBuildInfo;                          // build info for show version in list
 };
 
+/// Realm list packet body prebuilt for one client build and account security level
+struct RealmListPacket
+{
+    ByteBuffer data;                                        // body with every numchars byte left at 0
+    std::vector<std::pair<uint32, size_t> > numCharsPos;    // realm id -> position of its numchars byte in data
+};
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
@@ -67,20 +80,40 @@ class RealmList
         RealmList();
         ~RealmList() {}
 
-        void Initialize(uint32 updateInterval);
+        void Initialize(uint32 updateInterval, uint32 characterCountsCacheTime);
 
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        /// Prebuilt realm list for a client, only the per account character counts are left to patch in
+        std::shared_ptr<RealmListPacket const> GetRealmListPacket(uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel);
+
+        bool GetCachedCharacterCounts(uint32 accountId, RealmCharacterCounts& numChars);
+        void CacheCharacterCounts(uint32 accountId, RealmCharacterCounts const& numChars);
+
+        uint32 size() const;
     private:
+        struct CachedCharacterCounts
+        {
+            time_t expireTime;
+            RealmCharacterCounts numChars;
+        };
+
+        typedef std::map<uint32, std::shared_ptr<RealmListPacket const> > RealmListPacketMap;
+
         void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        static void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        static std::shared_ptr<RealmListPacket const> BuildRealmListPacket(RealmMap const& realms, uint32 packetKey);
+        static uint8 GetEligibleRealmCount(RealmMap const& realms, uint8 accountSecurityLevel);
     private:
         RealmMap m_realms;                                  ///< Internal map of realms
+        RealmListPacketMap m_realmListPackets;              ///< Prebuilt realm lists of m_realms, by build and security levels
+        mutable std::mutex m_realmsLock;                    ///< Guards m_realms and m_realmListPackets, read from network threads
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        std::unordered_map<uint32, CachedCharacterCounts> m_characterCounts;
+        std::mutex m_characterCountsLock;
+        uint32   m_characterCountsCacheTime;
 };
 
 #define sRealmList RealmList::Instance()
@@ -20,6 +20,24 @@
 #include <openssl/bn.h>
 #include <algorithm>
 
+namespace
+{
+    /// BN_CTX is a scratch pool of temporaries; one per thread is reused instead of allocating one per operation
+    struct ThreadBNContext
+    {
+        ThreadBNContext() : ctx(BN_CTX_new()) {}
+        ~ThreadBNContext() { BN_CTX_free(ctx); }
+
+        BN_CTX* ctx;
+    };
+
+    BN_CTX* GetBNContext()
+    {
+        thread_local ThreadBNContext context;
+        return context.ctx;
+    }
+}
+
 BigNumber::BigNumber()
 {
     _bn = BN_new();
@@ -95,27 +113,21 @@ BigNumber& BigNumber::operator-=(const BigNumber& bn)
 
 BigNumber& BigNumber::operator*=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mul(_bn, _bn, bn._bn, GetBNContext());
 
     return *this;
 }
 
 BigNumber& BigNumber::operator/=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_div(_bn, nullptr, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_div(_bn, nullptr, _bn, bn._bn, GetBNContext());
 
     return *this;
 }
 
 BigNumber& BigNumber::operator%=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod(_bn, _bn, bn._bn, GetBNContext());
 
     return *this;
 }
@@ -124,9 +136,7 @@ BigNumber BigNumber::Exp(const BigNumber& bn)
 {
     BigNumber ret;
 
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_exp(ret._bn, _bn, bn._bn, GetBNContext());
 
     return ret;
 }
@@ -135,9 +145,20 @@ BigNumber BigNumber::ModExp(const BigNumber& bn1, const BigNumber& bn2)
 {
     BigNumber ret;
 
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, GetBNContext());
+
+    return ret;
+}
+
+BigNumber BigNumber::ModExp(const BigNumber& bn1, const BigNumberMontgomery& mont)
+{
+    BigNumber ret;
+
+    // single word bases (like the SRP6 generator) have a cheaper dedicated path
+    if (BN_num_bits(_bn) <= BN_BITS2)
+        BN_mod_exp_mont_word(ret._bn, BN_get_word(_bn), bn1._bn, mont.GetModulus()._bn, GetBNContext(), mont.MontCtx());
+    else
+        BN_mod_exp_mont(ret._bn, _bn, bn1._bn, mont.GetModulus()._bn, GetBNContext(), mont.MontCtx());
 
     return ret;
 }
@@ -187,3 +208,14 @@ const char* BigNumber::AsDecStr() const
 {
     return BN_bn2dec(_bn);
 }
+
+BigNumberMontgomery::BigNumberMontgomery(const BigNumber& modulus) : _modulus(modulus)
+{
+    _mont = BN_MONT_CTX_new();
+    BN_MONT_CTX_set(_mont, _modulus.BN(), GetBNContext());
+}
+
+BigNumberMontgomery::~BigNumberMontgomery()
+{
+    BN_MONT_CTX_free(_mont);
+}
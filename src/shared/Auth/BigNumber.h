@@ -23,6 +23,9 @@
 #include <vector>
 
 struct bignum_st;
+struct bn_mont_ctx_st;
+
+class BigNumberMontgomery;
 
 class BigNumber
 {
@@ -75,6 +78,7 @@ class BigNumber
         bool isZero() const;
 
         BigNumber ModExp(const BigNumber& bn1, const BigNumber& bn2);
+        BigNumber ModExp(const BigNumber& bn1, const BigNumberMontgomery& mont);
         BigNumber Exp(const BigNumber&);
 
         int GetNumBytes(void) const;
@@ -91,4 +95,22 @@ class BigNumber
         struct bignum_st* _bn;
         uint8* _array;
 };
+
+/// Montgomery form of a fixed odd modulus, computed once and shared by all ModExp calls against it
+class BigNumberMontgomery
+{
+    public:
+        explicit BigNumberMontgomery(const BigNumber& modulus);
+        ~BigNumberMontgomery();
+
+        BigNumberMontgomery(const BigNumberMontgomery&) = delete;
+        BigNumberMontgomery& operator=(const BigNumberMontgomery&) = delete;
+
+        const BigNumber& GetModulus() const { return _modulus; }
+        struct bn_mont_ctx_st* MontCtx() const { return _mont; }
+
+    private:
+        BigNumber _modulus;
+        struct bn_mont_ctx_st* _mont;
+};
 #endif
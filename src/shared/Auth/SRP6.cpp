@@ -20,16 +20,61 @@
 #include "Auth/CryptoHash.h"
 #include "SRP6.h"
 
+namespace
+{
+    BigNumber MakePrime()
+    {
+        BigNumber prime;
+        prime.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+        return prime;
+    }
+
+    /// N, g and everything derived only from them, computed once and shared by all SRP6 instances
+    struct SRP6Parameters
+    {
+        SRP6Parameters() : N(MakePrime()), g(7), NMont(N)
+        {
+            // H(N) xor H(g) as used in the proof
+            BigNumber prime(N), generator(g);
+
+            Sha1Hash sha;
+            sha.Initialize();
+            sha.UpdateBigNumbers(&prime, nullptr);
+            sha.Finalize();
+            memcpy(NgHash, sha.GetDigest(), 20);
+            sha.Initialize();
+            sha.UpdateBigNumbers(&generator, nullptr);
+            sha.Finalize();
+            for (int i = 0; i < 20; ++i)
+            {
+                NgHash[i] ^= sha.GetDigest()[i];
+            }
+        }
+
+        BigNumber N;
+        BigNumber g;
+        BigNumberMontgomery NMont;
+        uint8 NgHash[20];
+    };
+
+    SRP6Parameters const& GetParameters()
+    {
+        static SRP6Parameters const parameters;
+        return parameters;
+    }
+}
+
 SRP6::SRP6()
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
+    SRP6Parameters const& parameters = GetParameters();
+    N = parameters.N;
+    g = parameters.g;
 }
 
 void SRP6::CalculateHostPublicEphemeral(void)
 {
     b.SetRand(19 * 8);
-    BigNumber gmod = g.ModExp(b, N);
+    BigNumber gmod = g.ModExp(b, GetParameters().NMont);
     B = ((v * 3) + gmod) % N;
 
     MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
@@ -37,21 +82,9 @@ void SRP6::CalculateHostPublicEphemeral(void)
 
 void SRP6::CalculateProof(std::string username)
 {
-    uint8 hash[20];
+    uint8 const* hash = GetParameters().NgHash;
 
     Sha1Hash sha;
-    sha.Initialize();
-    sha.UpdateBigNumbers(&N, nullptr);
-    sha.Finalize();
-    memcpy(hash, sha.GetDigest(), 20);
-    sha.Initialize();
-    sha.UpdateBigNumbers(&g, nullptr);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        hash[i] ^= sha.GetDigest()[i];
-    }
-
     sha.Initialize();
     sha.UpdateData(username);
     sha.Finalize();
@@ -81,7 +114,8 @@ bool SRP6::CalculateSessionKey(uint8* lp_A, int l)
     sha.UpdateBigNumbers(&A, &B, nullptr);
     sha.Finalize();
     u.SetBinary(sha.GetDigest(), 20);
-    S = (A * (v.ModExp(u, N))).ModExp(b, N);
+    BigNumberMontgomery const& NMont = GetParameters().NMont;
+    S = (A * (v.ModExp(u, NMont))).ModExp(b, NMont);
 
     return true;
 }
@@ -121,7 +155,7 @@ bool SRP6::CalculateVerifier(const std::string& rI, const char* salt)
     sha.Finalize();
     BigNumber x;
     x.SetBinary(sha.GetDigest(), Sha1Hash::GetLength());
-    v = g.ModExp(x, N);
+    v = g.ModExp(x, GetParameters().NMont);
 
     return true;
 }
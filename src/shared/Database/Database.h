@@ -25,6 +25,7 @@
 #include "Policies/ThreadingModel.h"
 #include "SqlPreparedStatement.h"
 #include "QueryResult.h"
+#include "Util/Tracer.h"
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
@@ -111,16 +112,20 @@ class Database
         virtual void InitDelayThread();
         // stop worker thread
         virtual void HaltDelayThread();
+        // statements waiting for the async worker thread
+        size_t GetDelayQueueSize() const { return m_threadBody ? m_threadBody->QueueSize() : 0; }
 
         /// Synchronous DB queries
         inline std::unique_ptr<QueryResult> Query(const char* sql)
         {
+            TraceSpan span("db", "Query");
             SqlConnection::Lock guard(getQueryConnection());
             return guard->Query(sql);
         }
 
         inline QueryNamedResult* QueryNamed(const char* sql)
         {
+            TraceSpan span("db", "QueryNamed");
             SqlConnection::Lock guard(getQueryConnection());
             return guard->QueryNamed(sql);
         }
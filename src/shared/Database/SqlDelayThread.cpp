@@ -38,6 +38,8 @@ void SqlDelayThread::run()
 #endif
 #endif
 
+    Tracer::SetThreadName("sql delay");
+
     const uint32 loopSleepms = 10;
 
     const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
@@ -55,6 +55,13 @@ class SqlDelayThread : public MaNGOS::Runnable
             return true;
         }
 
+        ///< Number of statements waiting for the worker, those being executed are not counted
+        size_t QueueSize()
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            return m_sqlQueue.size();
+        }
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
@@ -20,6 +20,7 @@
 #include "SqlDelayThread.h"
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
+#include "Util/Tracer.h"
 
 #include <cstdarg>
 
@@ -29,6 +30,7 @@
 
 bool SqlPlainRequest::Execute(SqlConnection* conn)
 {
+    TraceSpan span("db", "SqlPlainRequest");
     /// just do it
     LOCK_DB_CONN(conn);
     return conn->Execute(m_sql);
@@ -48,6 +50,7 @@ bool SqlTransaction::Execute(SqlConnection* conn)
     if (m_queue.empty())
         return true;
 
+    TraceSpan span("db", "SqlTransaction", "statements", int64(m_queue.size()));
     LOCK_DB_CONN(conn);
 
     conn->BeginTransaction();
@@ -78,6 +81,7 @@ SqlPreparedRequest::~SqlPreparedRequest()
 
 bool SqlPreparedRequest::Execute(SqlConnection* conn)
 {
+    TraceSpan span("db", "SqlPreparedRequest", "statement", m_nIndex);
     LOCK_DB_CONN(conn);
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
@@ -89,6 +93,7 @@ bool SqlQuery::Execute(SqlConnection* conn)
     if (!m_callback || !m_queue)
         return false;
 
+    TraceSpan span("db", "SqlQuery");
     LOCK_DB_CONN(conn);
     /// execute the query and store the result in the callback
     m_callback->SetResult(conn->Query(&m_sql[0]));
@@ -219,6 +224,7 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     if (!m_holder || !m_callback || !m_queue)
         return false;
 
+    TraceSpan span("db", "SqlQueryHolder", "queries", int64(m_holder->m_queries.size()));
     LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
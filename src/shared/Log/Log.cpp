@@ -24,6 +24,7 @@
 #include "Util/ByteBuffer.h"
 #include "Util/ProgressBar.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <thread>
@@ -68,13 +69,138 @@ enum LogType
 
 const int LogType_count = int(LogError) + 1;
 
+// outputs a single message can be written to
+enum LogTarget
+{
+    LOG_TARGET_STDOUT           = 0x0001,
+    LOG_TARGET_STDERR           = 0x0002,
+    LOG_TARGET_LOGFILE          = 0x0004,
+    LOG_TARGET_GM               = 0x0008,
+    LOG_TARGET_DB_ERRORS        = 0x0010,
+    LOG_TARGET_EVENTAI_ERRORS   = 0x0020,
+    LOG_TARGET_SCRIPT_ERRORS    = 0x0040,
+    LOG_TARGET_CHAR             = 0x0080,
+    LOG_TARGET_RA               = 0x0100,
+    LOG_TARGET_CUSTOM           = 0x0200,
+    LOG_TARGET_WORLD_PACKETS    = 0x0400,
+};
+
+// prefix of the message in the main log file
+enum LogPrefix
+{
+    LOG_PREFIX_NONE,
+    LOG_PREFIX_ERROR,
+    LOG_PREFIX_EVENTAI,
+    LOG_PREFIX_SCRIPT_LIBRARY
+};
+
+#define LOG_ASYNC_POLL_INTERVAL     10                      // ms, writer wakes up at least this often
+
+struct Log::LogMessage
+{
+    LogMessage() {}
+    LogMessage(LogType _type, uint32 _targets, LogPrefix _prefix = LOG_PREFIX_NONE) :
+        time(std::chrono::system_clock::now()), targets(_targets), type(_type), prefix(_prefix) {}
+
+    std::chrono::system_clock::time_point time;         // taken by the logging thread
+    uint32 targets = 0;                                 // LogTarget mask
+    LogType type = LogNormal;                           // console color
+    LogPrefix prefix = LOG_PREFIX_NONE;
+    uint32 account = 0;                                 // for gm log per account
+    bool timestamp = true;                              // prepend timestamp in files
+    bool newline = true;                                // append newline in files
+    std::string text;
+};
+
+// single producer single consumer ring, filled by one logging thread and drained by the writer thread
+class Log::LogQueue
+{
+    public:
+        explicit LogQueue(uint32 capacity) : m_slots(std::max(capacity, 1u)), m_head(0), m_tail(0) {}
+
+        // takes the message only if there is room for it
+        bool Push(LogMessage& msg)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == m_slots.size())
+                return false;
+
+            m_slots[tail % m_slots.size()] = std::move(msg);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Pop(LogMessage& msg)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            msg = std::move(m_slots[head % m_slots.size()]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<LogMessage> m_slots;
+        alignas(64) std::atomic<size_t> m_head;             // written by the writer thread only
+        alignas(64) std::atomic<size_t> m_tail;             // written by the owning thread only
+};
+
+thread_local std::shared_ptr<Log::LogQueue> Log::m_threadQueue;
+
 Log::Log() :
     raLogfile(nullptr), logfile(nullptr), gmLogfile(nullptr), charLogfile(nullptr), dberLogfile(nullptr),
-    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
+    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr),
+    m_asyncQueueSize(0), m_asyncFlushInterval(0), m_asyncOverflow(LOG_OVERFLOW_BLOCK), m_asyncRunning(false), m_asyncStop(false), m_asyncPushing(0),
+    m_asyncWritten(0), m_asyncDropped(0), m_asyncBlocked(0)
 {
     Initialize();
 }
 
+Log::~Log()
+{
+    StopAsyncWriter();
+
+    if (logfile != nullptr)
+        fclose(logfile);
+    logfile = nullptr;
+
+    if (gmLogfile != nullptr)
+        fclose(gmLogfile);
+    gmLogfile = nullptr;
+
+    if (charLogfile != nullptr)
+        fclose(charLogfile);
+    charLogfile = nullptr;
+
+    if (dberLogfile != nullptr)
+        fclose(dberLogfile);
+    dberLogfile = nullptr;
+
+    if (eventAiErLogfile != nullptr)
+        fclose(eventAiErLogfile);
+    eventAiErLogfile = nullptr;
+
+    if (scriptErrLogFile != nullptr)
+        fclose(scriptErrLogFile);
+    scriptErrLogFile = nullptr;
+
+    if (raLogfile != nullptr)
+        fclose(raLogfile);
+    raLogfile = nullptr;
+
+    if (worldLogfile != nullptr)
+        fclose(worldLogfile);
+    worldLogfile = nullptr;
+
+    if (customLogFile != nullptr)
+        fclose(customLogFile);
+    customLogFile = nullptr;
+}
+
 void Log::InitColors(const std::string& str)
 {
     if (str.empty())
@@ -220,6 +346,9 @@ void Log::SetLogFileLevel(char* level)
 
 void Log::Initialize()
 {
+    // files are reopened below, the writer must not use them meanwhile
+    StopAsyncWriter();
+
     /// Common log files data
     m_logsDir = sConfig.GetStringDefault("LogsDir");
     if (!m_logsDir.empty())
@@ -287,6 +416,13 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // Asynchronous output settings
+    m_asyncQueueSize = sConfig.GetIntDefault("LogAsyncQueueSize", 2048);
+    m_asyncFlushInterval = sConfig.GetIntDefault("LogAsyncFlushInterval", 0);
+    m_asyncOverflow = sConfig.GetIntDefault("LogAsyncOverflow", LOG_OVERFLOW_BLOCK) == LOG_OVERFLOW_DROP ? LOG_OVERFLOW_DROP : LOG_OVERFLOW_BLOCK;
+    if (sConfig.GetBoolDefault("LogAsync", false))
+        StartAsyncWriter();
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -319,20 +455,38 @@ FILE* Log::openGmlogPerAccount(uint32 account)
 
 void Log::outTimestamp(FILE* file)
 {
-    time_t t = time(nullptr);
-    tm* aTm = localtime(&t);
-    //       YYYY   year
-    //       MM     month (2 digits 01-12)
-    //       DD     day (2 digits 01-31)
-    //       HH     hour (2 digits 00-23)
-    //       MM     minutes (2 digits 00-59)
-    //       SS     seconds (2 digits 00-59)
-    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    outTimestamp(file, time(nullptr));
+}
+
+void Log::outTimestamp(FILE* file, time_t t)
+{
+    // batches written by the async writer mostly share the same second, skip localtime for them
+    thread_local time_t lastTime = -1;
+    thread_local char timestamp[32];
+
+    if (t != lastTime)
+    {
+        tm* aTm = localtime(&t);
+        //       YYYY   year
+        //       MM     month (2 digits 01-12)
+        //       DD     day (2 digits 01-31)
+        //       HH     hour (2 digits 00-23)
+        //       MM     minutes (2 digits 00-59)
+        //       SS     seconds (2 digits 00-59)
+        snprintf(timestamp, sizeof(timestamp), "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+        lastTime = t;
+    }
+
+    fputs(timestamp, file);
 }
 
 void Log::outTime() const
 {
-    time_t t = time(nullptr);
+    outTime(time(nullptr));
+}
+
+void Log::outTime(time_t t) const
+{
     tm* aTm = localtime(&t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
@@ -360,20 +514,31 @@ std::string Log::GetTimestampStr()
     return std::string(buf);
 }
 
-void Log::outString()
+// formats the message on the calling thread, printf style arguments can not outlive the call
+static std::string FormatLogText(const char* str, va_list ap)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
-    printf("\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    char buf[1024];
+
+    va_list copy;
+    va_copy(copy, ap);
+    int len = vsnprintf(buf, sizeof(buf), str, copy);
+    va_end(copy);
+
+    if (len < 0)
+        return std::string();
+
+    if (size_t(len) < sizeof(buf))
+        return std::string(buf, len);
 
-    fflush(stdout);
+    std::string text(len, '\0');
+    vsnprintf(&text[0], len + 1, str, ap);
+    return text;
+}
+
+void Log::outString()
+{
+    LogMessage msg(LogNormal, LOG_TARGET_STDOUT | LOG_TARGET_LOGFILE);
+    Write(std::move(msg));
 }
 
 void Log::outString(const char* str, ...)
@@ -381,596 +546,553 @@ void Log::outString(const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_colored)
-        SetColor(true, m_colors[LogNormal]);
-
-    if (m_includeTime)
-        outTime();
+    LogMessage msg(LogNormal, LOG_TARGET_STDOUT | LOG_TARGET_LOGFILE);
 
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    msg.text = FormatLogText(str, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(true);
+    Write(std::move(msg));
+}
 
-    printf("\n");
+void Log::outError(const char* err, ...)
+{
+    if (!err)
+        return;
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE, LOG_PREFIX_ERROR);
 
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
+    va_list ap;
+    va_start(ap, err);
+    msg.text = FormatLogText(err, ap);
+    va_end(ap);
 
-        fflush(logfile);
-    }
+    Write(std::move(msg));
+}
 
-    fflush(stdout);
+void Log::outErrorDb()
+{
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_DB_ERRORS, LOG_PREFIX_ERROR);
+    Write(std::move(msg));
 }
 
-void Log::outError(const char* err, ...)
+void Log::outErrorDb(const char* err, ...)
 {
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_DB_ERRORS, LOG_PREFIX_ERROR);
 
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    msg.text = FormatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
+    Write(std::move(msg));
+}
 
-    fprintf(stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
+void Log::outErrorEventAI()
+{
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_EVENTAI_ERRORS, LOG_PREFIX_EVENTAI);
+    Write(std::move(msg));
+}
+
+void Log::outErrorEventAI(const char* err, ...)
+{
+    if (!err)
+        return;
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_EVENTAI_ERRORS, LOG_PREFIX_EVENTAI);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    va_list ap;
+    va_start(ap, err);
+    msg.text = FormatLogText(err, ap);
+    va_end(ap);
 
-    fflush(stderr);
+    Write(std::move(msg));
 }
 
-void Log::outErrorDb()
+void Log::outBasic(const char* str, ...)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    if (!str)
+        return;
 
-    if (m_includeTime)
-        outTime();
+    uint32 targets = 0;
+    if (m_logLevel >= LOG_LVL_BASIC)
+        targets |= LOG_TARGET_STDOUT;
+    if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
+        targets |= LOG_TARGET_LOGFILE;
 
-    fprintf(stderr, "\n");
+    if (!targets)
+        return;
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
-    }
+    LogMessage msg(LogDetails, targets);
 
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
 
-    fflush(stderr);
+    Write(std::move(msg));
 }
 
-void Log::outErrorDb(const char* err, ...)
+void Log::outDetail(const char* str, ...)
 {
-    if (!err)
+    if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    uint32 targets = 0;
+    if (m_logLevel >= LOG_LVL_DETAIL)
+        targets |= LOG_TARGET_STDOUT;
+    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
+        targets |= LOG_TARGET_LOGFILE;
 
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
+    if (!targets)
+        return;
 
-    if (m_includeTime)
-        outTime();
+    LogMessage msg(LogDetails, targets);
 
     va_list ap;
-
-    va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
+    Write(std::move(msg));
+}
 
-    fprintf(stderr, "\n");
+void Log::outDebug(const char* str, ...)
+{
+    if (!str)
+        return;
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
+    uint32 targets = 0;
+    if (m_logLevel >= LOG_LVL_DEBUG)
+        targets |= LOG_TARGET_STDOUT;
+    if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
+        targets |= LOG_TARGET_LOGFILE;
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    if (!targets)
+        return;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    LogMessage msg(LogDebug, targets);
 
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
 
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
+    Write(std::move(msg));
+}
 
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
+void Log::outCommand(uint32 account, const char* str, ...)
+{
+    if (!str)
+        return;
+
+    uint32 targets = LOG_TARGET_GM;
+    if (m_logLevel >= LOG_LVL_DETAIL)
+        targets |= LOG_TARGET_STDOUT;
+    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
+        targets |= LOG_TARGET_LOGFILE;
 
-    fflush(stderr);
+    LogMessage msg(LogDetails, targets);
+    msg.account = account;
+
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
+
+    Write(std::move(msg));
 }
 
-void Log::outErrorEventAI()
+void Log::outChar(const char* str, ...)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_includeTime)
-        outTime();
+    if (!str || !charLogfile)
+        return;
 
-    fprintf(stderr, "\n");
+    LogMessage msg(LogNormal, LOG_TARGET_CHAR);
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
 
-    if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
+    Write(std::move(msg));
+}
 
-    fflush(stderr);
+void Log::outErrorScriptLib()
+{
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_SCRIPT_ERRORS, LOG_PREFIX_SCRIPT_LIBRARY);
+    Write(std::move(msg));
 }
 
-void Log::outErrorEventAI(const char* err, ...)
+void Log::outErrorScriptLib(const char* err, ...)
 {
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
+    LogMessage msg(LogError, LOG_TARGET_STDERR | LOG_TARGET_LOGFILE | LOG_TARGET_SCRIPT_ERRORS, LOG_PREFIX_SCRIPT_LIBRARY);
 
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    msg.text = FormatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
+    Write(std::move(msg));
+}
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
+void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opcodeName, ByteBuffer const& packet, bool incoming)
+{
+    if (!worldLogfile)
+        return;
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    LogMessage msg(LogNormal, LOG_TARGET_WORLD_PACKETS);
+    msg.newline = false;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    char buf[256];
+    snprintf(buf, sizeof(buf), "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+             incoming ? "CLIENT" : "SERVER",
+             socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    msg.text.reserve(strlen(buf) + packet.size() * 3 + packet.size() / 16 + 3);
+    msg.text = buf;
 
-    if (eventAiErLogfile)
+    size_t p = 0;
+    while (p < packet.size())
     {
-        outTimestamp(eventAiErLogfile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
-        va_end(ap);
+        for (size_t j = 0; j < 16 && p < packet.size(); ++j)
+        {
+            snprintf(buf, sizeof(buf), "%.2X ", packet[p++]);
+            msg.text += buf;
+        }
 
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
+        msg.text += '\n';
     }
 
-    fflush(stderr);
+    msg.text += "\n\n";
+
+    Write(std::move(msg));
 }
 
-void Log::outBasic(const char* str, ...)
+void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
 {
-    if (!str)
+    if (!charLogfile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
+    LogMessage msg(LogNormal, LOG_TARGET_CHAR);
+    msg.timestamp = false;
+    msg.newline = false;
 
-        if (m_includeTime)
-            outTime();
+    char buf[256];
+    snprintf(buf, sizeof(buf), "== START DUMP == (account: %u guid: %u name: %s )\n", account_id, guid, name);
+    msg.text = buf;
+    msg.text += str;
+    msg.text += "\n== END DUMP ==\n";
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    Write(std::move(msg));
+}
 
-        if (m_colored)
-            ResetColor(true);
+void Log::outRALog(const char* str, ...)
+{
+    if (!str || !raLogfile)
+        return;
 
-        printf("\n");
-    }
+    LogMessage msg(LogNormal, LOG_TARGET_RA);
 
-    if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
-    {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
 
-    fflush(stdout);
+    Write(std::move(msg));
 }
 
-void Log::outDetail(const char* str, ...)
+void Log::outCustomLog(const char* str, ...)
 {
-    if (!str)
+    if (!str || !customLogFile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    LogMessage msg(LogNormal, LOG_TARGET_CUSTOM);
 
-        if (m_colored)
-            ResetColor(true);
+    va_list ap;
+    va_start(ap, str);
+    msg.text = FormatLogText(str, ap);
+    va_end(ap);
 
-        printf("\n");
-    }
+    Write(std::move(msg));
+}
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
+void Log::Write(LogMessage&& msg)
+{
+    if (m_asyncRunning)
     {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
+        // StopAsyncWriter waits for pushes in flight before its last drain, a push that starts after the
+        // stop sees m_asyncRunning cleared and writes synchronously instead
+        ++m_asyncPushing;
+        bool queued = m_asyncRunning && QueueMessage(msg);
+        --m_asyncPushing;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        if (queued)
+            return;
     }
 
-    fflush(stdout);
+    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    WriteMessage(msg);
+    FlushTargets(msg.targets);
 }
 
-void Log::outDebug(const char* str, ...)
+// hands the message to the writer thread, false if the writer stopped while waiting for queue space
+bool Log::QueueMessage(LogMessage& msg)
 {
-    if (!str)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DEBUG)
+    if (!m_threadQueue)
     {
-        if (m_colored)
-            SetColor(true, m_colors[LogDebug]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+        m_threadQueue = std::make_shared<LogQueue>(m_asyncQueueSize);
+        std::lock_guard<std::mutex> guard(m_asyncQueuesLock);
+        m_asyncQueues.push_back(m_threadQueue);
+    }
 
-        if (m_colored)
-            ResetColor(true);
+    if (m_threadQueue->Push(msg))
+        return true;
 
-        printf("\n");
+    if (m_asyncOverflow == LOG_OVERFLOW_DROP)
+    {
+        ++m_asyncDropped;
+        return true;
     }
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
+    // queue is full, wait for the writer instead of losing the message
+    ++m_asyncBlocked;
+    m_asyncWakeup.notify_one();
+    while (m_asyncRunning)
     {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
+        if (m_threadQueue->Push(msg))
+            return true;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
     }
 
-    fflush(stdout);
+    return false;
 }
 
-void Log::outCommand(uint32 account, const char* str, ...)
+void Log::WriteMessage(LogMessage const& msg)
 {
-    if (!str)
-        return;
+    time_t t = std::chrono::system_clock::to_time_t(msg.time);
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
+    if (msg.targets & (LOG_TARGET_STDOUT | LOG_TARGET_STDERR))
     {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
+        bool stdout_stream = (msg.targets & LOG_TARGET_STDOUT) != 0;
+        FILE* stream = stdout_stream ? stdout : stderr;
+        bool colored = m_colored && !msg.text.empty();
+
+        if (colored)
+            SetColor(stdout_stream, m_colors[msg.type]);
 
         if (m_includeTime)
-            outTime();
+            outTime(t);
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+        utf8printf(stream, "%s", msg.text.c_str());
 
-        if (m_colored)
-            ResetColor(true);
+        if (colored)
+            ResetColor(stdout_stream);
 
-        printf("\n");
+        fprintf(stream, "\n");
     }
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
+    if ((msg.targets & LOG_TARGET_LOGFILE) && logfile)
     {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
-    }
+        outTimestamp(logfile, t);
 
-    if (m_gmlog_per_account)
-    {
-        if (FILE* per_file = openGmlogPerAccount(account))
+        switch (msg.prefix)
         {
-            va_list ap;
-            outTimestamp(per_file);
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n");
-            va_end(ap);
-            fclose(per_file);
+            case LOG_PREFIX_ERROR:
+                fprintf(logfile, "ERROR:");
+                break;
+            case LOG_PREFIX_EVENTAI:
+                fputs(msg.text.empty() ? "ERROR CreatureEventAI" : "ERROR CreatureEventAI: ", logfile);
+                break;
+            case LOG_PREFIX_SCRIPT_LIBRARY:
+                if (m_scriptLibName)
+                    fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
+                else
+                    fprintf(logfile, "<Scripting Library ERROR>: ");
+                break;
+            default:
+                break;
         }
-    }
-    else if (gmLogfile)
-    {
-        va_list ap;
-        outTimestamp(gmLogfile);
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
-        va_end(ap);
-        fflush(gmLogfile);
-    }
-
-    fflush(stdout);
-}
-
-void Log::outChar(const char* str, ...)
-{
-    if (!str)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (charLogfile)
-    {
-        va_list ap;
-        outTimestamp(charLogfile);
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
-        va_end(ap);
-        fflush(charLogfile);
-    }
-}
-
-void Log::outErrorScriptLib()
-{
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
 
-    fprintf(stderr, "\n");
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        fflush(logfile);
+        fprintf(logfile, "%s\n", msg.text.c_str());
     }
 
-    if (scriptErrLogFile)
+    if (msg.targets & LOG_TARGET_GM)
     {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        if (m_gmlog_per_account)
+        {
+            if (FILE* per_file = openGmlogPerAccount(msg.account))
+            {
+                WriteToFile(per_file, msg, t);
+                fclose(per_file);
+            }
+        }
+        else if (gmLogfile)
+            WriteToFile(gmLogfile, msg, t);
     }
 
-    fflush(stderr);
-}
+    if ((msg.targets & LOG_TARGET_DB_ERRORS) && dberLogfile)
+        WriteToFile(dberLogfile, msg, t);
 
-void Log::outErrorScriptLib(const char* err, ...)
-{
-    if (!err)
-        return;
+    if ((msg.targets & LOG_TARGET_EVENTAI_ERRORS) && eventAiErLogfile)
+        WriteToFile(eventAiErLogfile, msg, t);
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
+    if ((msg.targets & LOG_TARGET_SCRIPT_ERRORS) && scriptErrLogFile)
+        WriteToFile(scriptErrLogFile, msg, t);
 
-    if (m_includeTime)
-        outTime();
+    if ((msg.targets & LOG_TARGET_CHAR) && charLogfile)
+        WriteToFile(charLogfile, msg, t);
 
-    va_list ap;
+    if ((msg.targets & LOG_TARGET_RA) && raLogfile)
+        WriteToFile(raLogfile, msg, t);
 
-    va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
-    va_end(ap);
+    if ((msg.targets & LOG_TARGET_CUSTOM) && customLogFile)
+        WriteToFile(customLogFile, msg, t);
 
-    if (m_colored)
-        ResetColor(false);
+    if ((msg.targets & LOG_TARGET_WORLD_PACKETS) && worldLogfile)
+        WriteToFile(worldLogfile, msg, t);
+}
 
-    fprintf(stderr, "\n");
+void Log::WriteToFile(FILE* file, LogMessage const& msg, time_t t)
+{
+    if (msg.timestamp)
+        outTimestamp(file, t);
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
+    fputs(msg.text.c_str(), file);
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    if (msg.newline)
+        fputc('\n', file);
+}
 
-        fprintf(logfile, "\n");
+void Log::FlushTargets(uint32 targets)
+{
+    if (targets & LOG_TARGET_STDOUT)
+        fflush(stdout);
+    if (targets & LOG_TARGET_STDERR)
+        fflush(stderr);
+    if ((targets & LOG_TARGET_LOGFILE) && logfile)
         fflush(logfile);
-    }
-
-    if (scriptErrLogFile)
-    {
-        outTimestamp(scriptErrLogFile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
-        va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
+    if ((targets & LOG_TARGET_GM) && gmLogfile)
+        fflush(gmLogfile);
+    if ((targets & LOG_TARGET_DB_ERRORS) && dberLogfile)
+        fflush(dberLogfile);
+    if ((targets & LOG_TARGET_EVENTAI_ERRORS) && eventAiErLogfile)
+        fflush(eventAiErLogfile);
+    if ((targets & LOG_TARGET_SCRIPT_ERRORS) && scriptErrLogFile)
         fflush(scriptErrLogFile);
-    }
-
-    fflush(stderr);
+    if ((targets & LOG_TARGET_CHAR) && charLogfile)
+        fflush(charLogfile);
+    if ((targets & LOG_TARGET_RA) && raLogfile)
+        fflush(raLogfile);
+    if ((targets & LOG_TARGET_CUSTOM) && customLogFile)
+        fflush(customLogFile);
+    if ((targets & LOG_TARGET_WORLD_PACKETS) && worldLogfile)
+        fflush(worldLogfile);
 }
 
-void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opcodeName, ByteBuffer const& packet, bool incoming)
+void Log::StartAsyncWriter()
 {
-    if (!worldLogfile)
+    if (m_asyncWriter.joinable())
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    outTimestamp(worldLogfile);
+    m_asyncStop = false;
+    m_asyncRunning = true;
+    m_asyncWriter = std::thread(&Log::AsyncWriterLoop, this);
+}
 
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+void Log::StopAsyncWriter()
+{
+    if (!m_asyncWriter.joinable())
+        return;
 
-    size_t p = 0;
-    while (p < packet.size())
-    {
-        for (size_t j = 0; j < 16 && p < packet.size(); ++j)
-            fprintf(worldLogfile, "%.2X ", packet[p++]);
+    // new messages are written synchronously from now on, the writer drains what is already queued
+    m_asyncRunning = false;
+    m_asyncStop = true;
+    m_asyncWakeup.notify_one();
+    m_asyncWriter.join();
 
-        fprintf(worldLogfile, "\n");
-    }
+    // a Write that checked m_asyncRunning before it was cleared may not have pushed yet
+    while (m_asyncPushing)
+        std::this_thread::yield();
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    // messages pushed while the writer was finishing its last pass
+    WriteQueued(true);
 }
 
-void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
+void Log::AsyncWriterLoop()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+    uint32 unflushedTargets = 0;
 
-    if (charLogfile)
+    while (true)
     {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
+        // read before draining, everything queued before a stop request is still written
+        bool stopping = m_asyncStop;
+
+        unflushedTargets |= WriteQueued(false);
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (unflushedTargets && (stopping || now - lastFlush >= std::chrono::milliseconds(m_asyncFlushInterval)))
+        {
+            std::lock_guard<std::mutex> guard(m_worldLogMtx);
+            FlushTargets(unflushedTargets);
+            unflushedTargets = 0;
+            lastFlush = now;
+        }
+
+        if (stopping)
+            break;
+
+        std::unique_lock<std::mutex> lock(m_asyncWakeupLock);
+        m_asyncWakeup.wait_for(lock, std::chrono::milliseconds(LOG_ASYNC_POLL_INTERVAL));
     }
 }
 
-void Log::outRALog(const char* str, ...)
+uint32 Log::WriteQueued(bool flush)
 {
-    if (!str)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (raLogfile)
+    std::vector<LogMessage> batch;
     {
-        va_list ap;
-        outTimestamp(raLogfile);
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
-        va_end(ap);
-        fflush(raLogfile);
+        std::lock_guard<std::mutex> guard(m_asyncQueuesLock);
+        for (auto itr = m_asyncQueues.begin(); itr != m_asyncQueues.end();)
+        {
+            LogMessage msg;
+            while ((*itr)->Pop(msg))
+                batch.push_back(std::move(msg));
+
+            // the owning thread has exited and everything it queued is collected
+            if (itr->use_count() == 1 && (*itr)->Empty())
+                itr = m_asyncQueues.erase(itr);
+            else
+                ++itr;
+        }
     }
 
-    fflush(stdout);
-}
+    if (batch.empty())
+        return 0;
 
-void Log::outCustomLog(const char* str, ...)
-{
-    if (!str)
-        return;
+    // queues are per thread, restore the global order of the batch
+    std::stable_sort(batch.begin(), batch.end(), [](LogMessage const& a, LogMessage const& b) { return a.time < b.time; });
 
+    uint32 targets = 0;
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (customLogFile)
+    for (LogMessage const& msg : batch)
     {
-        va_list ap;
-        outTimestamp(customLogFile);
-        va_start(ap, str);
-        vfprintf(customLogFile, str, ap);
-        fprintf(customLogFile, "\n");
-        va_end(ap);
-        fflush(customLogFile);
+        WriteMessage(msg);
+        targets |= msg.targets;
     }
 
-    fflush(stdout);
+    if (flush)
+        FlushTargets(targets);
+
+    m_asyncWritten += batch.size();
+    return targets;
 }
 
 void Log::WaitBeforeContinueIfNeed()
@@ -998,19 +1120,22 @@ void Log::WaitBeforeContinueIfNeed()
 
 void Log::setScriptLibraryErrorFile(char const* fname, char const* libName)
 {
-    m_scriptLibName = libName;
+    {
+        std::lock_guard<std::mutex> guard(m_worldLogMtx);
+        m_scriptLibName = libName;
 
-    if (scriptErrLogFile)
-        fclose(scriptErrLogFile);
+        if (scriptErrLogFile)
+            fclose(scriptErrLogFile);
+        scriptErrLogFile = nullptr;
+    }
 
     if (!fname)
-    {
-        scriptErrLogFile = nullptr;
         return;
-    }
 
     std::string fileName = m_logsDir;
     fileName.append(fname);
+
+    std::lock_guard<std::mutex> guard(m_worldLogMtx);
     scriptErrLogFile = fopen(fileName.c_str(), "a");
 }
 
@@ -1110,14 +1235,13 @@ void script_error_log(const char* str, ...)
 
 void Log::traceLog()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (customLogFile)
-    {
-        fprintf(customLogFile, "%s\n", GetTraceLog().data());
-        fflush(customLogFile);
-    }
+    if (!customLogFile)
+        return;
 
-    fflush(stdout);
+    LogMessage msg(LogNormal, LOG_TARGET_CUSTOM);
+    msg.timestamp = false;
+    msg.text = GetTraceLog();
+    Write(std::move(msg));
 }
 
 // has to be in a locked enviroment on linux
@@ -22,7 +22,13 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 class Config;
 class ByteBuffer;
@@ -93,49 +99,19 @@ enum Color
 
 const int Color_count = int(WHITE) + 1;
 
+// what a logging thread does when its asynchronous queue is full
+enum LogOverflowPolicy
+{
+    LOG_OVERFLOW_BLOCK = 0,                                 // wait for the writer thread
+    LOG_OVERFLOW_DROP  = 1                                  // discard the message and count it
+};
+
 class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::mutex> >
 {
         friend class MaNGOS::OperatorNew<Log>;
         Log();
+        ~Log();
 
-        ~Log()
-        {
-            if (logfile != nullptr)
-                fclose(logfile);
-            logfile = nullptr;
-
-            if (gmLogfile != nullptr)
-                fclose(gmLogfile);
-            gmLogfile = nullptr;
-
-            if (charLogfile != nullptr)
-                fclose(charLogfile);
-            charLogfile = nullptr;
-
-            if (dberLogfile != nullptr)
-                fclose(dberLogfile);
-            dberLogfile = nullptr;
-
-            if (eventAiErLogfile != nullptr)
-                fclose(eventAiErLogfile);
-            eventAiErLogfile = nullptr;
-
-            if (scriptErrLogFile != nullptr)
-                fclose(scriptErrLogFile);
-            scriptErrLogFile = nullptr;
-
-            if (raLogfile != nullptr)
-                fclose(raLogfile);
-            raLogfile = nullptr;
-
-            if (worldLogfile != nullptr)
-                fclose(worldLogfile);
-            worldLogfile = nullptr;
-
-            if (customLogFile != nullptr)
-                fclose(customLogFile);
-            customLogFile = nullptr;
-        }
     public:
         void Initialize();
         void InitColors(const std::string& str);
@@ -178,8 +154,11 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         void SetColor(bool stdout_stream, Color color);
         void ResetColor(bool stdout_stream);
         void outTime() const;
+        void outTime(time_t t) const;
         static void outTimestamp(FILE* file);
+        static void outTimestamp(FILE* file, time_t t);
         static std::string GetTimestampStr();
+        std::string const& GetLogsDir() const { return m_logsDir; }
         bool HasLogFilter(uint32 filter) const { return (m_logFilter & filter) != 0; }
         void SetLogFilter(LogFilters filter, bool on) { if (on) m_logFilter |= filter; else m_logFilter &= ~filter; }
         bool HasLogLevelOrHigher(LogLevel loglvl) const { return m_logLevel >= loglvl || (m_logFileLevel >= loglvl && logfile); }
@@ -194,7 +173,31 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
 
         void traceLog();
 
+        // asynchronous output, Initialize starts the writer thread when LogAsync is set
+        // stopping it writes everything still queued, later messages are written synchronously
+        void StartAsyncWriter();
+        void StopAsyncWriter();
+
+        // asynchronous output statistics
+        bool IsAsync() const { return m_asyncRunning; }
+        uint64 GetAsyncWrittenCount() const { return m_asyncWritten; }
+        uint64 GetAsyncDroppedCount() const { return m_asyncDropped; }
+        uint64 GetAsyncBlockedCount() const { return m_asyncBlocked; }
+
     private:
+        struct LogMessage;
+        class LogQueue;
+
+        // writes synchronously or hands the message to the writer thread
+        void Write(LogMessage&& msg);
+        bool QueueMessage(LogMessage& msg);
+        void WriteMessage(LogMessage const& msg);
+        static void WriteToFile(FILE* file, LogMessage const& msg, time_t t);
+        void FlushTargets(uint32 targets);
+
+        void AsyncWriterLoop();
+        uint32 WriteQueued(bool flush);
+
         FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
@@ -231,6 +234,24 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         std::string m_gmlog_filename_format;
 
         char const* m_scriptLibName;
+
+        // asynchronous output, every logging thread fills its own queue which a single writer thread drains
+        uint32 m_asyncQueueSize;
+        uint32 m_asyncFlushInterval;                        // ms, 0 - flush after every written batch
+        LogOverflowPolicy m_asyncOverflow;
+        std::thread m_asyncWriter;
+        std::atomic<bool> m_asyncRunning;
+        std::atomic<bool> m_asyncStop;
+        std::atomic<uint32> m_asyncPushing;                 // Write calls between their m_asyncRunning check and their push
+        std::mutex m_asyncWakeupLock;
+        std::condition_variable m_asyncWakeup;
+        std::mutex m_asyncQueuesLock;
+        std::vector<std::shared_ptr<LogQueue>> m_asyncQueues;
+        static thread_local std::shared_ptr<LogQueue> m_threadQueue;
+
+        std::atomic<uint64> m_asyncWritten;
+        std::atomic<uint64> m_asyncDropped;
+        std::atomic<uint64> m_asyncBlocked;
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
@@ -17,6 +17,7 @@
  */
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
 #include <functional>
 
 #include "Config/Config.h"
@@ -74,7 +75,67 @@ void metric::measurement::set_condition(std::function<bool()> condition)
     m_condition = std::move(condition);
 }
 
-metric::metric::metric()
+class metric::metric::influx_exporter : public exporter
+{
+    public:
+        explicit influx_exporter(metric& owner) : m_owner(owner) {}
+
+        void write(std::vector<sample> const& samples) override
+        {
+            for (auto const& sample : samples)
+            {
+                std::map<std::string, boost::any> fields;
+
+                switch (sample.type)
+                {
+                    case metric_type::counter:
+                        if (!sample.delta)
+                            continue;
+
+                        fields["count"] = static_cast<int64>(sample.delta);
+                        fields["total"] = static_cast<int64>(sample.total);
+                        break;
+                    case metric_type::gauge:
+                        fields["value"] = sample.value;
+                        break;
+                    case metric_type::histogram:
+                        if (!sample.delta)
+                            continue;
+
+                        fields["count"] = static_cast<int64>(sample.delta);
+                        fields["sum"] = static_cast<int64>(sample.delta_sum);
+                        fields["max"] = static_cast<int64>(sample.max);
+                        fields["mean"] = static_cast<float>(sample.delta_sum) / sample.delta;
+                        fields["p50"] = percentile(sample, 0.50f);
+                        fields["p95"] = percentile(sample, 0.95f);
+                        fields["p99"] = percentile(sample, 0.99f);
+                        break;
+                }
+
+                m_owner.queue(std::make_unique<Measurement>(sample.name, sample.tags, fields));
+            }
+        }
+
+    private:
+        // upper bound of the bucket holding the given rank of this interval, the interval max for the overflow bucket
+        static int64 percentile(sample const& sample, float rank)
+        {
+            uint64 target = std::max<uint64>(1, static_cast<uint64>(sample.delta * rank + 0.5f));
+            uint64 seen = 0;
+            for (size_t i = 0; i < sample.bounds.size(); ++i)
+            {
+                seen += sample.delta_buckets[i];
+                if (seen >= target)
+                    return static_cast<int64>(std::min(sample.bounds[i], sample.max));
+            }
+
+            return static_cast<int64>(sample.max);
+        }
+
+        metric& m_owner;
+};
+
+metric::metric::metric() : m_enabled(false), m_influxEnabled(false), m_interval(1)
 {
     initialize();
 }
@@ -84,10 +145,23 @@ metric::metric::~metric()
     if (!m_enabled)
         return;
 
-	boost::asio::post(m_writeContext, [&] {
+    if (m_exporter)
+        registry::instance().remove_exporter(m_exporter);
+    if (m_exposition)
+        registry::instance().remove_exporter(m_exposition);
+
+    boost::asio::post(m_writeContext, [&] {
         m_sendTimer->cancel();
     });
 
+    // the pending accept would keep the queue context running
+    if (m_expositionServer)
+    {
+        boost::asio::post(m_queueContext, [&] {
+            m_expositionServer->stop();
+        });
+    }
+
     m_queueContextWork.get()->reset();
     m_writeContextWork.get()->reset();
 
@@ -100,9 +174,14 @@ metric::metric::~metric()
 
 void metric::metric::initialize()
 {
-    if (!(m_enabled = sConfig.GetBoolDefault("Metric.Enable", false)))
+    m_influxEnabled = sConfig.GetBoolDefault("Metric.Enable", false);
+    std::string listenAddress = sConfig.GetStringDefault("Metric.ListenAddress", "127.0.0.1");
+    int32 listenPort = sConfig.GetIntDefault("Metric.ListenPort", 0);
+
+    if (!(m_enabled = m_influxEnabled || listenPort > 0))
         return;
 
+    m_interval = uint32(std::max(1, sConfig.GetIntDefault("Metric.Interval", 1)));
     m_connectionInfo = {
         sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
         sConfig.GetIntDefault("Metric.Port", 8086),
@@ -111,6 +190,22 @@ void metric::metric::initialize()
         sConfig.GetStringDefault("Metric.Password", "")
     };
 
+    if (listenPort > 0)
+    {
+        try
+        {
+            m_exposition = std::make_shared<exposition_exporter>();
+            m_expositionServer = std::make_unique<exposition_server>(m_queueContext, listenAddress, uint16(listenPort), m_exposition);
+            registry::instance().add_exporter(m_exposition);
+            sLog.outString("Metric: serving /metrics on %s:%d", listenAddress.c_str(), listenPort);
+        }
+        catch (boost::system::system_error const& error)
+        {
+            sLog.outError("Metric: can not listen on %s:%d, %s", listenAddress.c_str(), listenPort, error.what());
+            m_exposition.reset();
+        }
+    }
+
     m_sendTimer.reset(new boost::asio::deadline_timer(m_writeContext));
     m_queueContextWork = std::make_unique<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(boost::asio::make_work_guard(m_queueContext));
     m_writeContextWork = std::make_unique<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(boost::asio::make_work_guard(m_writeContext));
@@ -124,6 +219,12 @@ void metric::metric::initialize()
         m_writeContext.run();
     });
 
+    if (m_influxEnabled)
+    {
+        m_exporter = std::make_shared<influx_exporter>(*this);
+        registry::instance().add_exporter(m_exporter);
+    }
+
     schedule_timer();
 }
 
@@ -143,6 +244,7 @@ void metric::metric::reload_config()
 
     boost::asio::post(m_writeContext, [&]
     {
+        m_interval = uint32(std::max(1, sConfig.GetIntDefault("Metric.Interval", 1)));
         m_connectionInfo = {
             sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
             sConfig.GetIntDefault("Metric.Port", 8086),
@@ -160,7 +262,7 @@ void metric::metric::report(std::string measurement, std::string key, boost::any
 
 void metric::metric::report(std::string measurement, std::map<std::string, boost::any> fields, std::map<std::string, std::string> tags)
 {
-    if (!m_enabled)
+    if (!m_influxEnabled)
         return;
 
     boost::asio::post(m_queueContext, [&, measurement, fields, tags]
@@ -170,6 +272,12 @@ void metric::metric::report(std::string measurement, std::map<std::string, boost
     });
 }
 
+void metric::metric::queue(std::unique_ptr<Measurement> measurement)
+{
+    std::lock_guard<std::mutex> guard(m_queueWriteLock);
+    m_measurementQueue.push_back(std::move(measurement));
+}
+
 void metric::metric::schedule_timer()
 {
     using namespace std::placeholders;
@@ -177,7 +285,7 @@ void metric::metric::schedule_timer()
     if (!m_sendTimer)
         return;
 
-    m_sendTimer->expires_from_now(boost::posix_time::seconds(1));
+    m_sendTimer->expires_from_now(boost::posix_time::seconds(m_interval));
     m_sendTimer->async_wait(std::bind(&metric::metric::prepare_send, this, _1));
 }
 
@@ -191,7 +299,11 @@ void metric::metric::prepare_send(const boost::system::error_code& ec)
         return;
     }
 
-    send();
+    // fold the per-thread metric cells, the influx exporter queues them for this send
+    registry::instance().collect();
+
+    if (m_influxEnabled)
+        send();
     schedule_timer();
 }
 
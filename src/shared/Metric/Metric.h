@@ -29,6 +29,8 @@
 #include <vector>
 
 #include "Measurement.h"
+#include "MetricExposition.h"
+#include "MetricRegistry.h"
 #include "Common.h"
 
 struct MetricConnectionInfo
@@ -120,6 +122,9 @@ namespace metric
             void report(std::string measurement, std::map<std::string, boost::any> fields, std::map<std::string, std::string> tags = {});
 
         private:
+            // turns the aggregated registry samples into line protocol measurements
+            class influx_exporter;
+
 			boost::asio::io_context m_queueContext;
 			boost::asio::io_context m_writeContext;
 
@@ -129,12 +134,18 @@ namespace metric
             std::thread m_queueServiceThread;
             std::thread m_writeServiceThread;
 
-            bool m_enabled;
+            bool m_enabled;                                 // collection running, for influx or the local endpoint
+            bool m_influxEnabled;
+            uint32 m_interval;
             MetricConnectionInfo m_connectionInfo;
+            std::shared_ptr<influx_exporter> m_exporter;
+            std::shared_ptr<exposition_exporter> m_exposition;
+            std::unique_ptr<exposition_server> m_expositionServer;
 
             std::mutex m_queueWriteLock;
             std::vector<std::unique_ptr<Measurement>> m_measurementQueue;
 
+            void queue(std::unique_ptr<Measurement> measurement);
             void schedule_timer();
             void prepare_send(const boost::system::error_code& ec);
             void send();
@@ -0,0 +1,245 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+#include "MetricExposition.h"
+
+#define EXPOSITION_MAX_REQUEST_SIZE  4096
+#define EXPOSITION_REQUEST_TIMEOUT   5                      // seconds
+
+namespace
+{
+    // metric names may only contain [a-zA-Z0-9_:] and must not start with a digit
+    std::string exposition_name(std::string const& name)
+    {
+        std::string result = name;
+        for (char& c : result)
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '_' && c != ':')
+                c = '_';
+
+        if (!result.empty() && isdigit(static_cast<unsigned char>(result[0])))
+            result.insert(result.begin(), '_');
+
+        return result;
+    }
+
+    void write_label_value(std::ostringstream& out, std::string const& value)
+    {
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '\\': out << "\\\\"; break;
+                case '"':  out << "\\\""; break;
+                case '\n': out << "\\n"; break;
+                default:   out << c; break;
+            }
+        }
+    }
+
+    void write_labels(std::ostringstream& out, metric::tag_set const& tags, char const* extraKey = nullptr, std::string const& extraValue = std::string())
+    {
+        if (tags.empty() && !extraKey)
+            return;
+
+        char const* separator = "{";
+        for (auto const& tag : tags)
+        {
+            out << separator << exposition_name(tag.first) << "=\"";
+            write_label_value(out, tag.second);
+            out << "\"";
+            separator = ",";
+        }
+
+        if (extraKey)
+        {
+            out << separator << extraKey << "=\"";
+            write_label_value(out, extraValue);
+            out << "\"";
+        }
+
+        out << "}";
+    }
+}
+
+void metric::exposition_exporter::write(std::vector<sample> const& samples)
+{
+    // one family per name, all its series grouped below a single TYPE line
+    std::vector<sample const*> ordered;
+    ordered.reserve(samples.size());
+    for (auto const& sample : samples)
+        ordered.push_back(&sample);
+
+    std::stable_sort(ordered.begin(), ordered.end(), [](sample const* a, sample const* b) { return a->name < b->name; });
+
+    std::ostringstream out;
+    std::string const* family = nullptr;
+    for (sample const* sample : ordered)
+    {
+        std::string name = exposition_name(sample->name);
+
+        switch (sample->type)
+        {
+            case metric_type::counter:
+                name += "_total";
+                if (!family || *family != sample->name)
+                    out << "# TYPE " << name << " counter\n";
+
+                out << name;
+                write_labels(out, sample->tags);
+                out << " " << sample->total << "\n";
+                break;
+            case metric_type::gauge:
+                if (!family || *family != sample->name)
+                    out << "# TYPE " << name << " gauge\n";
+
+                out << name;
+                write_labels(out, sample->tags);
+                out << " " << sample->value << "\n";
+                break;
+            case metric_type::histogram:
+            {
+                if (!family || *family != sample->name)
+                    out << "# TYPE " << name << " histogram\n";
+
+                uint64 cumulative = 0;
+                for (size_t i = 0; i < sample->buckets.size(); ++i)
+                {
+                    cumulative += sample->buckets[i];
+                    out << name << "_bucket";
+                    write_labels(out, sample->tags, "le", i < sample->bounds.size() ? std::to_string(sample->bounds[i]) : "+Inf");
+                    out << " " << cumulative << "\n";
+                }
+
+                out << name << "_sum";
+                write_labels(out, sample->tags);
+                out << " " << sample->sum << "\n";
+
+                out << name << "_count";
+                write_labels(out, sample->tags);
+                out << " " << sample->total << "\n";
+                break;
+            }
+        }
+
+        family = &sample->name;
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_text = out.str();
+}
+
+std::string metric::exposition_exporter::text() const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_text;
+}
+
+struct metric::exposition_server::connection
+{
+    explicit connection(boost::asio::io_context& context) : socket(context), timeout(context), request(EXPOSITION_MAX_REQUEST_SIZE) {}
+
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::steady_timer timeout;
+    boost::asio::streambuf request;
+    std::string response;
+};
+
+metric::exposition_server::exposition_server(boost::asio::io_context& context, std::string const& address, uint16 port, std::shared_ptr<exposition_exporter> source)
+    : m_context(context), m_acceptor(context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(address), port)), m_source(std::move(source))
+{
+    start_accept();
+}
+
+void metric::exposition_server::stop()
+{
+    boost::system::error_code error;
+    m_acceptor.close(error);
+}
+
+void metric::exposition_server::start_accept()
+{
+    auto client = std::make_shared<connection>(m_context);
+    m_acceptor.async_accept(client->socket, [this, client](boost::system::error_code const& error)
+    {
+        if (error == boost::asio::error::operation_aborted)
+            return;
+
+        if (!error)
+            read_request(client);
+
+        start_accept();
+    });
+}
+
+void metric::exposition_server::read_request(std::shared_ptr<connection> client)
+{
+    // a scraper that connects and never sends a request must not hold the socket forever
+    client->timeout.expires_after(std::chrono::seconds(EXPOSITION_REQUEST_TIMEOUT));
+    client->timeout.async_wait([client](boost::system::error_code const& error)
+    {
+        if (error)
+            return;
+
+        boost::system::error_code ignored;
+        client->socket.close(ignored);
+    });
+
+    boost::asio::async_read_until(client->socket, client->request, "\r\n\r\n", [this, client](boost::system::error_code const& error, std::size_t /*read*/)
+    {
+        if (error)
+        {
+            client->timeout.cancel();
+            return;
+        }
+
+        std::istream stream(&client->request);
+        std::string method, target;
+        stream >> method >> target;
+
+        if (method != "GET")
+            write_response(client, "405 Method Not Allowed", "");
+        else if (target != "/metrics")
+            write_response(client, "404 Not Found", "");
+        else
+            write_response(client, "200 OK", m_source->text());
+    });
+}
+
+void metric::exposition_server::write_response(std::shared_ptr<connection> client, char const* status, std::string const& body)
+{
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n";
+    response << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n";
+    response << "Content-Length: " << body.size() << "\r\n";
+    response << "Connection: close\r\n\r\n";
+    response << body;
+    client->response = response.str();
+
+    boost::asio::async_write(client->socket, boost::asio::buffer(client->response), [client](boost::system::error_code const& /*error*/, std::size_t /*written*/)
+    {
+        client->timeout.cancel();
+
+        boost::system::error_code ignored;
+        client->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        client->socket.close(ignored);
+    });
+}
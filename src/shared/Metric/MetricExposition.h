@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_METRICEXPOSITION_H
+#define MANGOSSERVER_METRICEXPOSITION_H
+
+#include <boost/asio.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "MetricRegistry.h"
+#include "Common.h"
+
+namespace metric
+{
+    // keeps the registry samples of the last collection rendered in the prometheus text format
+    class exposition_exporter : public exporter
+    {
+        public:
+            void write(std::vector<sample> const& samples) override;
+
+            std::string text() const;
+
+        private:
+            mutable std::mutex m_lock;
+            std::string m_text;
+    };
+
+    // plaintext http endpoint answering GET /metrics with the latest exposition, one request per connection
+    class exposition_server
+    {
+        public:
+            exposition_server(boost::asio::io_context& context, std::string const& address, uint16 port, std::shared_ptr<exposition_exporter> source);
+
+            // must run on the context thread
+            void stop();
+
+        private:
+            struct connection;
+
+            void start_accept();
+            void read_request(std::shared_ptr<connection> client);
+            void write_response(std::shared_ptr<connection> client, char const* status, std::string const& body);
+
+            boost::asio::io_context& m_context;
+            boost::asio::ip::tcp::acceptor m_acceptor;
+            std::shared_ptr<exposition_exporter> m_source;
+    };
+}
+
+#endif // MANGOSSERVER_METRICEXPOSITION_H
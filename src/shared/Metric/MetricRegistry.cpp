@@ -0,0 +1,186 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include "MetricRegistry.h"
+#include "Util/Errors.h"
+
+metric::base_metric::base_metric(metric_type type, std::string name, tag_set tags)
+    : m_type(type), m_name(std::move(name)), m_tags(std::move(tags))
+{
+    registry::instance().add(this);
+}
+
+metric::base_metric::~base_metric()
+{
+    registry::instance().remove(this);
+}
+
+metric::counter::counter(std::string name, tag_set tags)
+    : base_metric(metric_type::counter, std::move(name), std::move(tags)), m_last(0), m_advanced(0)
+{
+}
+
+void metric::counter::collect(sample& out)
+{
+    uint64 total = 0;
+    for (auto const& cell : m_cells)
+        total += cell.value.load(std::memory_order_relaxed);
+
+    out.total = total;
+    out.delta = total - m_last;
+    m_last = total;
+}
+
+metric::gauge::gauge(std::string name, tag_set tags)
+    : base_metric(metric_type::gauge, std::move(name), std::move(tags)), m_value(0)
+{
+}
+
+void metric::gauge::collect(sample& out)
+{
+    out.value = get();
+}
+
+metric::histogram::histogram(std::string name, tag_set tags, std::vector<uint64> bounds)
+    : base_metric(metric_type::histogram, std::move(name), std::move(tags)), m_bounds(std::move(bounds)),
+      m_lastCount(0), m_lastSum(0)
+{
+    MANGOS_ASSERT(m_bounds.size() <= METRIC_MAX_BUCKETS);
+    MANGOS_ASSERT(std::is_sorted(m_bounds.begin(), m_bounds.end()));
+    m_lastBuckets.resize(m_bounds.size() + 1, 0);
+}
+
+void metric::histogram::observe(uint64 value)
+{
+    cell& target = m_cells[thread_cell()];
+
+    size_t bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    target.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    target.count.fetch_add(1, std::memory_order_relaxed);
+    target.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64 max = target.max.load(std::memory_order_relaxed);
+    while (value > max && !target.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+std::vector<uint64> metric::histogram::exponential_bounds(uint64 start, uint64 factor, uint32 count)
+{
+    std::vector<uint64> bounds;
+    bounds.reserve(count);
+    for (uint64 bound = start; bounds.size() < count; bound *= factor)
+        bounds.push_back(bound);
+
+    return bounds;
+}
+
+void metric::histogram::collect(sample& out)
+{
+    out.bounds = m_bounds;
+    out.buckets.assign(m_bounds.size() + 1, 0);
+    out.delta_buckets.resize(m_bounds.size() + 1);
+    out.total = 0;
+    out.sum = 0;
+    out.max = 0;
+
+    for (auto& cell : m_cells)
+    {
+        out.total += cell.count.load(std::memory_order_relaxed);
+        out.sum += cell.sum.load(std::memory_order_relaxed);
+        out.max = std::max(out.max, cell.max.exchange(0, std::memory_order_relaxed));
+
+        for (size_t i = 0; i < out.buckets.size(); ++i)
+            out.buckets[i] += cell.buckets[i].load(std::memory_order_relaxed);
+    }
+
+    out.delta = out.total - m_lastCount;
+    out.delta_sum = out.sum - m_lastSum;
+    m_lastCount = out.total;
+    m_lastSum = out.sum;
+
+    for (size_t i = 0; i < out.buckets.size(); ++i)
+    {
+        out.delta_buckets[i] = out.buckets[i] - m_lastBuckets[i];
+        m_lastBuckets[i] = out.buckets[i];
+    }
+}
+
+metric::registry& metric::registry::instance()
+{
+    static registry instance;
+    return instance;
+}
+
+void metric::registry::add(base_metric* target)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_metrics.push_back(target);
+}
+
+void metric::registry::remove(base_metric* target)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto itr = std::find(m_metrics.begin(), m_metrics.end(), target);
+    if (itr == m_metrics.end())
+        return;
+
+    *itr = m_metrics.back();
+    m_metrics.pop_back();
+}
+
+void metric::registry::add_exporter(std::shared_ptr<exporter> const& target)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_exporters.push_back(target);
+    m_active.store(true, std::memory_order_relaxed);
+}
+
+void metric::registry::remove_exporter(std::shared_ptr<exporter> const& target)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_exporters.erase(std::remove(m_exporters.begin(), m_exporters.end(), target), m_exporters.end());
+    m_active.store(!m_exporters.empty(), std::memory_order_relaxed);
+}
+
+void metric::registry::collect()
+{
+    std::vector<sample> samples;
+    std::vector<std::shared_ptr<exporter>> exporters;
+
+    // Scope collecting, exporters may block on network so they run without the lock
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_exporters.empty())
+            return;
+
+        exporters = m_exporters;
+        samples.resize(m_metrics.size());
+        for (size_t i = 0; i < m_metrics.size(); ++i)
+        {
+            sample& out = samples[i];
+            out.type = m_metrics[i]->type();
+            out.name = m_metrics[i]->name();
+            out.tags = m_metrics[i]->tags();
+            m_metrics[i]->collect(out);
+        }
+    }
+
+    for (auto const& target : exporters)
+        target->write(samples);
+}
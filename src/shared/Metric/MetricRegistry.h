@@ -0,0 +1,251 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_METRICREGISTRY_H
+#define MANGOSSERVER_METRICREGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+/*
+ * Pre-registered metrics. Every counter, gauge and histogram is created once with a fixed
+ * name and tag set and then only updated through relaxed atomics. Counters and histograms
+ * are split into per-thread cells so concurrent map threads never share a cache line;
+ * the registry folds the cells together once per collection interval and hands the result
+ * to every attached exporter (InfluxDB, ...).
+ */
+namespace metric
+{
+    typedef std::map<std::string, std::string> tag_set;
+
+    enum class metric_type
+    {
+        counter,
+        gauge,
+        histogram
+    };
+
+    // number of per-thread cells kept by counters and histograms
+    constexpr uint32 METRIC_THREAD_CELLS = 16;
+    // maximum number of finite histogram bucket bounds
+    constexpr uint32 METRIC_MAX_BUCKETS = 16;
+
+    // cell used by the calling thread, assigned round robin on first use
+    inline uint32 thread_cell()
+    {
+        static std::atomic<uint32> next(0);
+        static thread_local uint32 const cell = next.fetch_add(1, std::memory_order_relaxed) % METRIC_THREAD_CELLS;
+        return cell;
+    }
+
+    // aggregated state of one metric at collection time
+    struct sample
+    {
+        metric_type type;
+        std::string name;
+        tag_set tags;
+
+        int64 value;                                        // gauge: current value
+        uint64 total;                                       // counter/histogram: cumulative count
+        uint64 delta;                                       // counter/histogram: count since last collection
+        uint64 sum;                                         // histogram: cumulative sum of observations
+        uint64 delta_sum;                                   // histogram: sum since last collection
+        uint64 max;                                         // histogram: largest observation since last collection
+        std::vector<uint64> bounds;                         // histogram: finite bucket upper bounds
+        std::vector<uint64> buckets;                        // histogram: cumulative count per bucket, last is +Inf
+        std::vector<uint64> delta_buckets;                  // histogram: count per bucket since last collection
+    };
+
+    class base_metric
+    {
+        public:
+            base_metric(metric_type type, std::string name, tag_set tags);
+            virtual ~base_metric();
+
+            base_metric(base_metric const&) = delete;
+            base_metric& operator=(base_metric const&) = delete;
+
+            metric_type type() const { return m_type; }
+            std::string const& name() const { return m_name; }
+            tag_set const& tags() const { return m_tags; }
+
+        protected:
+            friend class registry;
+            // called with the registry lock held, only ever from one collecting thread
+            virtual void collect(sample& out) = 0;
+
+        private:
+            metric_type m_type;
+            std::string m_name;
+            tag_set m_tags;
+    };
+
+    class counter : public base_metric
+    {
+        public:
+            counter(std::string name, tag_set tags = {});
+
+            void add(uint64 value = 1) { m_cells[thread_cell()].value.fetch_add(value, std::memory_order_relaxed); }
+
+            // for totals counted elsewhere, adds the growth since the previous call; one caller only
+            void advance(uint64 total)
+            {
+                if (total > m_advanced)
+                    add(total - m_advanced);
+                m_advanced = total;
+            }
+
+        protected:
+            void collect(sample& out) override;
+
+        private:
+            struct alignas(64) cell
+            {
+                std::atomic<uint64> value{0};
+            };
+
+            std::array<cell, METRIC_THREAD_CELLS> m_cells;
+            uint64 m_last;
+            uint64 m_advanced;
+    };
+
+    class gauge : public base_metric
+    {
+        public:
+            gauge(std::string name, tag_set tags = {});
+
+            void set(int64 value) { m_value.store(value, std::memory_order_relaxed); }
+            void add(int64 value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+            int64 get() const { return m_value.load(std::memory_order_relaxed); }
+
+        protected:
+            void collect(sample& out) override;
+
+        private:
+            std::atomic<int64> m_value;
+    };
+
+    class histogram : public base_metric
+    {
+        public:
+            // bounds are the inclusive upper limits of the finite buckets, in ascending order
+            histogram(std::string name, tag_set tags, std::vector<uint64> bounds);
+
+            void observe(uint64 value);
+
+            // start, start * factor, ... count bounds
+            static std::vector<uint64> exponential_bounds(uint64 start, uint64 factor, uint32 count);
+
+        protected:
+            void collect(sample& out) override;
+
+        private:
+            struct alignas(64) cell
+            {
+                std::atomic<uint64> count{0};
+                std::atomic<uint64> sum{0};
+                std::atomic<uint64> max{0};
+                std::array<std::atomic<uint64>, METRIC_MAX_BUCKETS + 1> buckets{};
+            };
+
+            std::vector<uint64> m_bounds;
+            std::array<cell, METRIC_THREAD_CELLS> m_cells;
+            uint64 m_lastCount;
+            uint64 m_lastSum;
+            std::vector<uint64> m_lastBuckets;
+    };
+
+    class exporter
+    {
+        public:
+            virtual ~exporter() {}
+
+            // called from the collecting thread once per collection interval
+            virtual void write(std::vector<sample> const& samples) = 0;
+    };
+
+    class registry
+    {
+        public:
+            static registry& instance();
+
+            // true while at least one exporter is attached; timers skip reading the clock otherwise
+            bool active() const { return m_active.load(std::memory_order_relaxed); }
+
+            void add_exporter(std::shared_ptr<exporter> const& target);
+            void remove_exporter(std::shared_ptr<exporter> const& target);
+
+            // aggregates every registered metric and passes the samples to all exporters
+            void collect();
+
+        private:
+            friend class base_metric;
+
+            registry() : m_active(false) {}
+
+            void add(base_metric* target);
+            void remove(base_metric* target);
+
+            std::mutex m_lock;
+            std::vector<base_metric*> m_metrics;
+            std::vector<std::shared_ptr<exporter>> m_exporters;
+            std::atomic<bool> m_active;
+    };
+
+    // records the lifetime of the scope into a histogram, in the given precision
+    template <class precision>
+    class timer
+    {
+        public:
+            explicit timer(histogram& target) : m_target(target), m_running(registry::instance().active())
+            {
+                if (m_running)
+                    m_startTime = std::chrono::steady_clock::now();
+            }
+
+            ~timer() { stop(); }
+
+            timer(timer const&) = delete;
+            timer& operator=(timer const&) = delete;
+
+            void stop()
+            {
+                if (!m_running)
+                    return;
+
+                m_running = false;
+                auto elapsed = std::chrono::duration_cast<precision>(std::chrono::steady_clock::now() - m_startTime).count();
+                m_target.observe(elapsed > 0 ? uint64(elapsed) : 0);
+            }
+
+        private:
+            histogram& m_target;
+            bool m_running;
+            std::chrono::steady_clock::time_point m_startTime;
+    };
+}
+
+#endif // MANGOSSERVER_METRICREGISTRY_H
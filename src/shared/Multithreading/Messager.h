@@ -21,6 +21,8 @@
 
 #include <vector>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <functional>
 
 template <class T>
@@ -29,8 +31,17 @@ class Messager
     public:
         void AddMessage(const std::function<void(T*)>& message)
         {
-            std::lock_guard<std::mutex> guard(m_messageMutex);
-            m_messageVector.push_back(message);
+            {
+                std::lock_guard<std::mutex> guard(m_messageMutex);
+                m_messageVector.push_back(message);
+            }
+            m_messageCondition.notify_one();
+        }
+        // blocks the calling thread until a message is queued or timeout elapses
+        void WaitForMessages(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_messageMutex);
+            m_messageCondition.wait_for(lock, timeout, [&] { return !m_messageVector.empty(); });
         }
         void Execute(T* object)
         {
@@ -46,7 +57,8 @@ class Messager
         }
     private:
         std::vector<std::function<void(T*)>> m_messageVector;
-        std::mutex m_messageMutex;  
+        std::mutex m_messageMutex;
+        std::condition_variable m_messageCondition;
 };
 
 #endif
\ No newline at end of file
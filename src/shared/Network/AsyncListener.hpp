@@ -23,6 +23,12 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include "AsyncSocket.hpp"
+#include "Util/TokenBucket.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
 
 namespace MaNGOS
 {
@@ -31,20 +37,118 @@ namespace MaNGOS
     {
         public:
             // constructor for accepting connection from client
-            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port)),
+                m_admissionTimer(io_context), m_admissionTimerArmed(false), m_maxPendingPerAddress(0)
             {
                 startAccept();
             }
+
+            // limits how fast accepted connections are started; connections over the rate wait, served round robin per remote address
+            void SetAdmissionControl(uint32 rate, uint32 burst, uint32 maxPendingPerAddress)
+            {
+                std::lock_guard<std::mutex> guard(m_admissionLock);
+                m_admission.SetRate(rate, burst);
+                m_maxPendingPerAddress = maxPendingPerAddress;
+            }
+
             void HandleAccept(std::shared_ptr<SocketType> connection, const boost::system::error_code& err)
             {
                 if (!err)
-                    connection->Start();
+                    admit(connection);
 
                 startAccept();
             }
         private:
+            typedef std::deque<std::shared_ptr<SocketType>> PendingConnections;
+
             boost::asio::io_context& m_context;
             boost::asio::ip::tcp::acceptor m_acceptor;
+
+            std::mutex m_admissionLock;
+            TokenBucket m_admission;
+            boost::asio::steady_timer m_admissionTimer;
+            bool m_admissionTimerArmed;
+            uint32 m_maxPendingPerAddress;
+            std::map<boost::asio::ip::address, PendingConnections> m_pending;
+            std::deque<boost::asio::ip::address> m_pendingOrder;  // addresses with waiting connections, in service order
+
+            void admit(std::shared_ptr<SocketType> connection)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_admissionLock);
+
+                    if (m_admission.IsLimited() && (!m_pending.empty() || !m_admission.TryConsume()))
+                    {
+                        boost::system::error_code ec;
+                        boost::asio::ip::tcp::endpoint remote = connection->GetAsioSocket().remote_endpoint(ec);
+                        if (ec)
+                            return;
+
+                        PendingConnections& pending = m_pending[remote.address()];
+                        if (m_maxPendingPerAddress && pending.size() >= m_maxPendingPerAddress)
+                        {
+                            connection->Close();
+                            return;
+                        }
+
+                        if (pending.empty())
+                            m_pendingOrder.push_back(remote.address());
+                        pending.push_back(connection);
+
+                        scheduleAdmission();
+                        return;
+                    }
+                }
+
+                connection->Start();
+            }
+
+            // must be called with m_admissionLock held
+            void scheduleAdmission()
+            {
+                if (m_admissionTimerArmed || m_pendingOrder.empty())
+                    return;
+
+                m_admissionTimerArmed = true;
+                m_admissionTimer.expires_after(m_admission.GetTimeToNextToken());
+                m_admissionTimer.async_wait([this](const boost::system::error_code& error)
+                {
+                    if (!error)
+                        admitPending();
+                });
+            }
+
+            void admitPending()
+            {
+                std::vector<std::shared_ptr<SocketType>> admitted;
+                {
+                    std::lock_guard<std::mutex> guard(m_admissionLock);
+                    m_admissionTimerArmed = false;
+
+                    while (!m_pendingOrder.empty() && m_admission.TryConsume())
+                    {
+                        boost::asio::ip::address address = m_pendingOrder.front();
+                        m_pendingOrder.pop_front();
+
+                        auto itr = m_pending.find(address);
+                        admitted.push_back(itr->second.front());
+                        itr->second.pop_front();
+
+                        // one connection per address and round so a single host can not starve the others
+                        if (itr->second.empty())
+                            m_pending.erase(itr);
+                        else
+                            m_pendingOrder.push_back(address);
+                    }
+
+                    scheduleAdmission();
+                }
+
+                for (auto& connection : admitted)
+                    if (!connection->IsClosed())
+                        connection->Start();
+            }
+
             void startAccept()
             {
                 // socket
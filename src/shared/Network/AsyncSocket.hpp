@@ -25,8 +25,17 @@
 #include "boost/lexical_cast.hpp"
 #include "Log/Log.h"
 
+#include <atomic>
+
 namespace MaNGOS
 {
+    // byte totals over every socket of the process, counted as reads and writes complete
+    struct SocketStatistics
+    {
+        static inline std::atomic<uint64> bytesReceived{0};
+        static inline std::atomic<uint64> bytesSent{0};
+    };
+
     // this socket is different in that it does not block on reads
     template <typename SocketType>
     class AsyncSocket : public std::enable_shared_from_this<SocketType>
@@ -89,13 +98,21 @@ namespace MaNGOS
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
+        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), [callback = std::move(callback)](const boost::system::error_code& error, std::size_t read)
+        {
+            SocketStatistics::bytesReceived.fetch_add(read, std::memory_order_relaxed);
+            callback(error, read);
+        });
     }
 
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, callback);
+        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, [callback = std::move(callback)](const boost::system::error_code& error, std::size_t read)
+        {
+            SocketStatistics::bytesReceived.fetch_add(read, std::memory_order_relaxed);
+            callback(error, read);
+        });
     }
 
     template<typename SocketType>
@@ -111,7 +128,11 @@ namespace MaNGOS
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
+        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), [callback = std::move(callback)](const boost::system::error_code& error, std::size_t written)
+        {
+            SocketStatistics::bytesSent.fetch_add(written, std::memory_order_relaxed);
+            callback(error, written);
+        });
     }
 
     template <typename SocketType>
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/BufferPool.h"
+#include "Util/MemoryTracker.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#define BUFFER_POOL_THREAD_CACHE_BYTES  (256 * 1024)        // per class and thread
+#define BUFFER_POOL_SHARED_CACHE_BYTES  (4 * 1024 * 1024)   // per class
+#define BUFFER_POOL_REQUEST_BATCH       256                 // requests counted per thread before they are published
+
+namespace
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct alignas(64) SharedList
+    {
+        std::mutex lock;
+        FreeBlock* head = nullptr;
+        uint32 count = 0;
+    };
+
+    // plain data, so it stays usable while the thread is being torn down
+    struct ThreadCache
+    {
+        FreeBlock* heads[BUFFER_POOL_CLASSES];
+        uint32 counts[BUFFER_POOL_CLASSES];
+        uint32 requests;
+        bool registered;
+        bool released;
+    };
+
+    // gives the cached blocks of an exiting thread back to the shared lists
+    struct ThreadCacheReleaser
+    {
+        ~ThreadCacheReleaser();
+        void Register() {}
+    };
+
+    SharedList s_shared[BUFFER_POOL_CLASSES];
+    std::atomic<uint64> s_requests(0);
+    std::atomic<uint64> s_heapAllocations(0);
+    std::atomic<uint64> s_heapFrees(0);
+
+    thread_local ThreadCache t_cache;
+    thread_local ThreadCacheReleaser t_releaser;
+
+    uint32 GetSizeClass(size_t size)
+    {
+        uint32 index = 0;
+        for (size_t block = BUFFER_POOL_MIN_BLOCK; block < size; block <<= 1)
+            ++index;
+        return index;
+    }
+
+    size_t GetBlockSize(uint32 index) { return size_t(BUFFER_POOL_MIN_BLOCK) << index; }
+    uint32 GetThreadCacheLimit(uint32 index) { return std::max<uint32>(8, BUFFER_POOL_THREAD_CACHE_BYTES / GetBlockSize(index)); }
+    uint32 GetSharedCacheLimit(uint32 index) { return std::max<uint32>(16, BUFFER_POOL_SHARED_CACHE_BYTES / GetBlockSize(index)); }
+
+    void* HeapAllocate(size_t size)
+    {
+        void* ptr = ::operator new(size);
+        s_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        MemoryTracker::Allocate(MEMORY_TAG_BUFFER_POOL, size);
+        return ptr;
+    }
+
+    void HeapFree(void* ptr, size_t size)
+    {
+        MemoryTracker::Free(MEMORY_TAG_BUFFER_POOL, size);
+        s_heapFrees.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(ptr);
+    }
+
+    ThreadCache* GetThreadCache()
+    {
+        ThreadCache& cache = t_cache;
+        if (cache.released)
+            return nullptr;
+
+        if (!cache.registered)
+        {
+            t_releaser.Register();
+            cache.registered = true;
+        }
+
+        return &cache;
+    }
+
+    // moves up to count blocks of the shared list into the thread cache
+    void Refill(ThreadCache& cache, uint32 index, uint32 count)
+    {
+        SharedList& shared = s_shared[index];
+        std::lock_guard<std::mutex> guard(shared.lock);
+        for (; count && shared.head; --count)
+        {
+            FreeBlock* block = shared.head;
+            shared.head = block->next;
+            --shared.count;
+
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+            ++cache.counts[index];
+        }
+    }
+
+    // moves up to count blocks of the thread cache into the shared list, what does not fit there goes back to the heap
+    void Flush(ThreadCache& cache, uint32 index, uint32 count)
+    {
+        FreeBlock* overflow = nullptr;
+        {
+            SharedList& shared = s_shared[index];
+            uint32 limit = GetSharedCacheLimit(index);
+
+            std::lock_guard<std::mutex> guard(shared.lock);
+            for (; count && cache.heads[index]; --count)
+            {
+                FreeBlock* block = cache.heads[index];
+                cache.heads[index] = block->next;
+                --cache.counts[index];
+
+                if (shared.count < limit)
+                {
+                    block->next = shared.head;
+                    shared.head = block;
+                    ++shared.count;
+                }
+                else
+                {
+                    block->next = overflow;
+                    overflow = block;
+                }
+            }
+        }
+
+        while (overflow)
+        {
+            FreeBlock* next = overflow->next;
+            HeapFree(overflow, GetBlockSize(index));
+            overflow = next;
+        }
+    }
+
+    ThreadCacheReleaser::~ThreadCacheReleaser()
+    {
+        ThreadCache& cache = t_cache;
+        for (uint32 i = 0; i < BUFFER_POOL_CLASSES; ++i)
+            Flush(cache, i, cache.counts[i]);
+
+        s_requests.fetch_add(cache.requests, std::memory_order_relaxed);
+        cache.requests = 0;
+        cache.released = true;
+    }
+}
+
+void* BufferPool::Allocate(size_t size)
+{
+    ThreadCache* cache = size <= BUFFER_POOL_MAX_BLOCK ? GetThreadCache() : nullptr;
+    if (!cache)
+    {
+        s_requests.fetch_add(1, std::memory_order_relaxed);
+        return HeapAllocate(size <= BUFFER_POOL_MAX_BLOCK ? GetBlockSize(GetSizeClass(size)) : size);
+    }
+
+    if (++cache->requests == BUFFER_POOL_REQUEST_BATCH)
+    {
+        s_requests.fetch_add(BUFFER_POOL_REQUEST_BATCH, std::memory_order_relaxed);
+        cache->requests = 0;
+    }
+
+    uint32 index = GetSizeClass(size);
+    if (!cache->heads[index])
+        Refill(*cache, index, GetThreadCacheLimit(index) / 2);
+
+    if (FreeBlock* block = cache->heads[index])
+    {
+        cache->heads[index] = block->next;
+        --cache->counts[index];
+        return block;
+    }
+
+    return HeapAllocate(GetBlockSize(index));
+}
+
+void BufferPool::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    ThreadCache* cache = size <= BUFFER_POOL_MAX_BLOCK ? GetThreadCache() : nullptr;
+    if (!cache)
+    {
+        HeapFree(ptr, size <= BUFFER_POOL_MAX_BLOCK ? GetBlockSize(GetSizeClass(size)) : size);
+        return;
+    }
+
+    uint32 index = GetSizeClass(size);
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = cache->heads[index];
+    cache->heads[index] = block;
+
+    uint32 limit = GetThreadCacheLimit(index);
+    if (++cache->counts[index] > limit)
+        Flush(*cache, index, limit / 2);
+}
+
+BufferPoolStatistic BufferPool::GetStatistic()
+{
+    BufferPoolStatistic statistic;
+    statistic.requests = s_requests.load(std::memory_order_relaxed);
+    statistic.heapAllocations = s_heapAllocations.load(std::memory_order_relaxed);
+    statistic.heapFrees = s_heapFrees.load(std::memory_order_relaxed);
+    statistic.cachedBytes = 0;
+
+    for (uint32 i = 0; i < BUFFER_POOL_CLASSES; ++i)
+    {
+        std::lock_guard<std::mutex> guard(s_shared[i].lock);
+        statistic.cachedBytes += uint64(s_shared[i].count) * GetBlockSize(i);
+    }
+
+    return statistic;
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_BUFFERPOOL_H
+#define MANGOS_BUFFERPOOL_H
+
+#include "Common.h"
+
+// power of two size classes from 64 bytes to 64 KB, larger requests go straight to the heap
+#define BUFFER_POOL_MIN_BLOCK       64
+#define BUFFER_POOL_MAX_BLOCK       65536
+#define BUFFER_POOL_CLASSES         11
+
+struct BufferPoolStatistic
+{
+    uint64 requests;                                        // blocks handed out since startup
+    uint64 heapAllocations;                                 // of those, taken from the heap instead of a free list
+    uint64 heapFrees;                                       // blocks given back to the heap
+    uint64 cachedBytes;                                     // held in the shared free lists, thread caches not included
+};
+
+/// Size-classed block pool for packet and buffer storage. Every thread keeps a small free list per
+/// class and exchanges half of it with the shared lists when it runs empty or full, so blocks freed
+/// on the network threads are reused by the map threads that build the next packets.
+class BufferPool
+{
+    public:
+        static void* Allocate(size_t size);
+        static void Free(void* ptr, size_t size);
+
+        static BufferPoolStatistic GetStatistic();
+};
+
+/// Standard allocator drawing from the buffer pool
+template <class T>
+class BufferPoolAllocator
+{
+    public:
+        typedef T value_type;
+
+        BufferPoolAllocator() noexcept {}
+        template <class U>
+        BufferPoolAllocator(BufferPoolAllocator<U> const&) noexcept {}
+
+        T* allocate(size_t count) { return static_cast<T*>(BufferPool::Allocate(count * sizeof(T))); }
+        void deallocate(T* ptr, size_t count) noexcept { BufferPool::Free(ptr, count * sizeof(T)); }
+
+        template <class U>
+        bool operator==(BufferPoolAllocator<U> const&) const noexcept { return true; }
+        template <class U>
+        bool operator!=(BufferPoolAllocator<U> const&) const noexcept { return false; }
+};
+
+#endif
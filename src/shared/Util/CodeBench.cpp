@@ -19,9 +19,157 @@
 #include "Util/CodeBench.h"
 #include "Log/Log.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
 ChronoTimeTracker::~ChronoTimeTracker()
 {
     std::chrono::nanoseconds elapsed = elapsedNanos();
     sLog.outError("%s: time elapsed: %ldns, %ldµs, %ldms, %lds",
         m_name.c_str(), nanos(elapsed).count(), micros(elapsed).count(), millis(elapsed).count(), secs(elapsed).count());
 }
+
+std::vector<BenchRegistry::BenchCase>& BenchRegistry::Cases()
+{
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+void BenchRegistry::Add(char const* name, BenchFunction function)
+{
+    Cases().push_back({ name, function });
+}
+
+static BenchState RunBenchOnce(BenchFunction function, uint64 iterations)
+{
+    BenchState state(iterations);
+    function(state);
+    return state;
+}
+
+std::vector<BenchResult> BenchRegistry::Run(BenchOptions const& options)
+{
+    std::vector<BenchCase> cases = Cases();
+    std::sort(cases.begin(), cases.end(), [](BenchCase const& a, BenchCase const& b) { return strcmp(a.name, b.name) < 0; });
+
+    std::vector<BenchResult> results;
+    for (BenchCase const& bench : cases)
+    {
+        if (!options.filter.empty() && std::string(bench.name).find(options.filter) == std::string::npos)
+            continue;
+
+        BenchResult result;
+        result.name = bench.name;
+        result.iterations = 1;
+        result.bytesProcessed = 0;
+        result.mean = result.median = result.stddev = result.min = result.max = 0.0;
+
+        // grow the iteration count until a single run is long enough to be measured reliably
+        uint64 const minNanos = uint64(options.minTime * 1e9);
+        BenchState state = RunBenchOnce(bench.function, result.iterations);
+        while (state.GetSkipReason().empty() && state.GetElapsedNanos() < minNanos && result.iterations < 1000000000)
+        {
+            uint64 elapsed = state.GetElapsedNanos();
+            double factor = elapsed ? std::min(std::max(1.4 * minNanos / elapsed, 2.0), 100.0) : 100.0;
+            result.iterations = uint64(result.iterations * factor);
+            state = RunBenchOnce(bench.function, result.iterations);
+        }
+
+        if (!state.GetSkipReason().empty())
+        {
+            result.skipped = state.GetSkipReason();
+            results.push_back(result);
+            continue;
+        }
+
+        // caches, branch predictors and allocators settle before anything is recorded
+        auto warmupEnd = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.warmupTime);
+        while (std::chrono::steady_clock::now() < warmupEnd)
+            RunBenchOnce(bench.function, result.iterations);
+
+        for (uint32 i = 0; i < std::max(options.repetitions, 1u); ++i)
+        {
+            state = RunBenchOnce(bench.function, result.iterations);
+            result.samples.push_back(double(state.GetElapsedNanos()) / result.iterations);
+        }
+
+        result.bytesProcessed = state.GetBytesProcessed();
+        result.label = state.GetLabel();
+
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (double sample : sorted)
+            sum += sample;
+
+        result.mean = sum / sorted.size();
+        result.median = sorted.size() % 2 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+        result.min = sorted.front();
+        result.max = sorted.back();
+
+        double variance = 0.0;
+        for (double sample : sorted)
+            variance += (sample - result.mean) * (sample - result.mean);
+        result.stddev = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0.0;
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+void BenchRegistry::Print(std::vector<BenchResult> const& results)
+{
+    printf("%-36s %14s %12s %12s %9s %12s %14s\n", "benchmark", "iterations", "mean ns", "median ns", "stddev", "min ns", "throughput");
+    for (BenchResult const& result : results)
+    {
+        if (!result.skipped.empty())
+        {
+            printf("%-36s skipped: %s\n", result.name.c_str(), result.skipped.c_str());
+            continue;
+        }
+
+        char throughput[32] = "";
+        if (result.bytesProcessed && result.median > 0.0)
+            snprintf(throughput, sizeof(throughput), "%.1f MiB/s", result.bytesProcessed / result.median * 1e9 / (1024 * 1024));
+
+        printf("%-36s %14" PRIu64 " %12.2f %12.2f %8.2f%% %12.2f %14s  %s\n", result.name.c_str(), result.iterations,
+               result.mean, result.median, result.mean > 0.0 ? result.stddev / result.mean * 100 : 0.0, result.min, throughput, result.label.c_str());
+    }
+}
+
+bool BenchRegistry::WriteJson(std::string const& file, std::vector<BenchResult> const& results)
+{
+    FILE* out = fopen(file.c_str(), "w");
+    if (!out)
+        return false;
+
+    fprintf(out, "{\n  \"date\": \"%s\",\n  \"benchmarks\": [", Log::GetTimestampStr().c_str());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        BenchResult const& result = results[i];
+        fprintf(out, "%s\n    {\"name\": \"%s\", ", i ? "," : "", result.name.c_str());
+        if (!result.skipped.empty())
+        {
+            fprintf(out, "\"skipped\": \"%s\"}", result.skipped.c_str());
+            continue;
+        }
+
+        fprintf(out, "\"iterations\": %" PRIu64 ", \"repetitions\": %u, \"mean_ns\": %.3f, \"median_ns\": %.3f, \"stddev_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f",
+                result.iterations, uint32(result.samples.size()), result.mean, result.median, result.stddev, result.min, result.max);
+        if (result.bytesProcessed)
+            fprintf(out, ", \"bytes_per_second\": %.0f", result.median > 0.0 ? result.bytesProcessed / result.median * 1e9 : 0.0);
+        if (!result.label.empty())
+            fprintf(out, ", \"label\": \"%s\"", result.label.c_str());
+        fputs("}", out);
+    }
+    fputs("\n  ]\n}\n", out);
+
+    bool failed = ferror(out) != 0;
+    fclose(out);
+    return !failed;
+}
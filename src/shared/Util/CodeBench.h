@@ -19,6 +19,12 @@
 #ifndef MANGOS_CODEBENCH_H
 #define MANGOS_CODEBENCH_H
 
+#include "Common.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
 struct ChronoTimeTracker
 {
     public:
@@ -50,5 +56,134 @@ struct ChronoTimeTracker
         inline constexpr std::chrono::seconds secs(std::chrono::nanoseconds nanos) { return std::chrono::duration_cast<std::chrono::seconds>(nanos); }
 };
 
+/// Passed to every benchmark, the timed part is the loop over KeepRunning()
+///
+///     BENCHMARK(ByteBufferAppend)
+///     {
+///         ByteBuffer buffer;                              // setup, not timed
+///         while (state.KeepRunning())
+///         {
+///             buffer.clear();
+///             buffer << uint32(1);
+///         }
+///         state.SetBytesProcessed(4);
+///     }
+class BenchState
+{
+    public:
+        explicit BenchState(uint64 iterations) : m_iterations(iterations), m_done(0), m_bytes(0), m_elapsed(0) {}
+
+        bool KeepRunning()
+        {
+            if (m_done == 0)
+                m_start = std::chrono::steady_clock::now();
+            else if (m_done == m_iterations)
+            {
+                m_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+                return false;
+            }
+
+            ++m_done;
+            return true;
+        }
+
+        uint64 GetIterations() const { return m_iterations; }
+
+        /// Bytes handled by one iteration, reported as throughput
+        void SetBytesProcessed(uint64 bytes) { m_bytes = bytes; }
+        uint64 GetBytesProcessed() const { return m_bytes; }
+
+        /// Free text printed next to the result, for what the timing does not show (memory use, hit rates, ...)
+        void SetLabel(std::string const& label) { m_label = label; }
+        std::string const& GetLabel() const { return m_label; }
+
+        /// Marks the benchmark as not runnable (missing data, ...), it is reported with the reason
+        void Skip(std::string const& reason) { m_skipped = reason; }
+        std::string const& GetSkipReason() const { return m_skipped; }
+
+        uint64 GetElapsedNanos() const { return m_elapsed; }
+
+    private:
+        uint64 m_iterations;
+        uint64 m_done;
+        uint64 m_bytes;
+        uint64 m_elapsed;
+        std::chrono::steady_clock::time_point m_start;
+        std::string m_skipped;
+        std::string m_label;
+};
+
+/// Keeps the compiler from discarding a value computed only for the benchmark
+template <class T>
+inline void BenchDoNotOptimize(T const& value)
+{
+#if defined(_MSC_VER)
+    static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+typedef void(*BenchFunction)(BenchState& state);
+
+struct BenchOptions
+{
+    BenchOptions() : repetitions(10), minTime(0.1), warmupTime(0.1) {}
+
+    std::string filter;                                     // only run benchmarks whose name contains this
+    uint32 repetitions;                                     // measured runs per benchmark
+    double minTime;                                         // seconds, the iteration count is raised until one run takes this long
+    double warmupTime;                                      // seconds spent running before measuring
+};
+
+struct BenchResult
+{
+    std::string name;
+    std::string skipped;                                    // reason, empty if the benchmark ran
+    uint64 iterations;                                      // per repetition
+    uint64 bytesProcessed;                                  // per iteration
+    std::string label;                                      // set by the benchmark in its last repetition
+    std::vector<double> samples;                            // ns per iteration of every repetition
+    double mean;
+    double median;
+    double stddev;
+    double min;
+    double max;
+};
+
+/// Benchmarks register themselves through BENCHMARK(name) at static initialization
+class BenchRegistry
+{
+    public:
+        struct Registrar
+        {
+            Registrar(char const* name, BenchFunction function) { BenchRegistry::Add(name, function); }
+        };
+
+        static void Add(char const* name, BenchFunction function);
+
+        static std::vector<BenchResult> Run(BenchOptions const& options);
+
+        /// Prints a summary table to stdout
+        static void Print(std::vector<BenchResult> const& results);
+        /// Writes the results as JSON for comparing runs, returns false if the file can not be written
+        static bool WriteJson(std::string const& file, std::vector<BenchResult> const& results);
+
+    private:
+        struct BenchCase
+        {
+            char const* name;
+            BenchFunction function;
+        };
+
+        static std::vector<BenchCase>& Cases();
+};
+
+#define BENCHMARK(name) \
+    static void name(BenchState& state); \
+    static BenchRegistry::Registrar name##Registrar(#name, name); \
+    static void name(BenchState& state)
+
 #endif
 
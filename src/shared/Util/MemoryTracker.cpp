@@ -0,0 +1,83 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/MemoryTracker.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <windows.h>
+#  include <psapi.h>
+#elif PLATFORM == PLATFORM_UNIX
+#  include <unistd.h>
+#endif
+
+MemoryTracker::Counters MemoryTracker::s_counters[MAX_MEMORY_TAGS];
+
+MemoryTagStatistic MemoryTracker::GetStatistic(MemoryTag tag)
+{
+    Counters const& counters = s_counters[tag];
+
+    MemoryTagStatistic statistic;
+    statistic.bytes = counters.bytes.load(std::memory_order_relaxed);
+    statistic.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    statistic.allocations = counters.allocations.load(std::memory_order_relaxed);
+    statistic.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+    return statistic;
+}
+
+char const* MemoryTracker::GetTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MEMORY_TAG_TERRAIN:        return "terrain";
+        case MEMORY_TAG_MMAP:           return "mmap";
+        case MEMORY_TAG_VMAP:           return "vmap";
+        case MEMORY_TAG_OBJECTMGR:      return "objectmgr";
+        case MEMORY_TAG_AUCTIONS:       return "auctions";
+        case MEMORY_TAG_SESSION_QUEUES: return "session_queues";
+        case MEMORY_TAG_BUFFER_POOL:    return "buffer_pool";
+        case MEMORY_TAG_SPELLS:         return "spells";
+        case MEMORY_TAG_WORLD_OBJECTS:  return "world_objects";
+    }
+
+    return "unknown";
+}
+
+uint64 MemoryTracker::GetProcessResidentSize()
+{
+#if PLATFORM == PLATFORM_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return 0;
+#elif PLATFORM == PLATFORM_UNIX
+    // second field of statm is the resident page count
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+
+    unsigned long size = 0, resident = 0;
+    int read = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+    if (read != 2)
+        return 0;
+
+    return uint64(resident) * uint64(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MEMORYTRACKER_H
+#define MANGOS_MEMORYTRACKER_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <memory>
+
+/// Subsystems whose heap usage is accounted separately
+enum MemoryTag
+{
+    MEMORY_TAG_TERRAIN          = 0,                        // GridMap height, area and liquid data
+    MEMORY_TAG_MMAP             = 1,                        // everything Detour allocates: navmeshes, tiles, queries
+    MEMORY_TAG_VMAP             = 2,                        // static map trees and world models
+    MEMORY_TAG_OBJECTMGR        = 3,                        // spawn data and cell guid maps
+    MEMORY_TAG_AUCTIONS         = 4,                        // auction entries and auction house maps
+    MEMORY_TAG_SESSION_QUEUES   = 5,                        // packets waiting in session receive queues
+    MEMORY_TAG_BUFFER_POOL      = 6,                        // blocks the buffer pool took from the heap, in use or cached
+    MEMORY_TAG_SPELLS           = 7,                        // slabs of spells, aura holders and auras
+    MEMORY_TAG_WORLD_OBJECTS    = 8,                        // slabs of creatures and gameobjects
+};
+
+#define MAX_MEMORY_TAGS 9
+
+struct MemoryTagStatistic
+{
+    uint64 bytes;                                           // currently accounted
+    uint64 peakBytes;
+    uint64 allocations;                                     // currently live
+    uint64 totalAllocations;                                // since startup
+};
+
+/// Byte and allocation counters per subsystem, fed by the allocation sites of the tagged containers and
+/// loaders. Updates are relaxed atomics so accounting is safe from map threads and the network threads.
+class MemoryTracker
+{
+    public:
+        /// Blocks which are only ever freed together may be accounted as a single allocation
+        static void Allocate(MemoryTag tag, size_t size, uint32 allocations = 1)
+        {
+            Counters& counters = s_counters[tag];
+            uint64 bytes = counters.bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            counters.allocations.fetch_add(allocations, std::memory_order_relaxed);
+            counters.totalAllocations.fetch_add(allocations, std::memory_order_relaxed);
+
+            uint64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+            while (bytes > peak && !counters.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed));
+        }
+
+        static void Free(MemoryTag tag, size_t size, uint32 allocations = 1)
+        {
+            Counters& counters = s_counters[tag];
+            counters.bytes.fetch_sub(size, std::memory_order_relaxed);
+            counters.allocations.fetch_sub(allocations, std::memory_order_relaxed);
+        }
+
+        static MemoryTagStatistic GetStatistic(MemoryTag tag);
+        static char const* GetTagName(MemoryTag tag);
+
+        /// Resident set size of the whole process in bytes, 0 where the platform does not expose it
+        static uint64 GetProcessResidentSize();
+
+    private:
+        struct alignas(64) Counters
+        {
+            std::atomic<uint64> bytes{0};
+            std::atomic<uint64> peakBytes{0};
+            std::atomic<uint64> allocations{0};
+            std::atomic<uint64> totalAllocations{0};
+        };
+
+        static Counters s_counters[MAX_MEMORY_TAGS];
+};
+
+/// Standard allocator accounting every block of a container to a tag
+template <class T, MemoryTag Tag>
+class MemoryTrackingAllocator
+{
+    public:
+        typedef T value_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef MemoryTrackingAllocator<U, Tag> other;
+        };
+
+        MemoryTrackingAllocator() noexcept {}
+        template <class U>
+        MemoryTrackingAllocator(MemoryTrackingAllocator<U, Tag> const&) noexcept {}
+
+        T* allocate(size_t count)
+        {
+            T* ptr = std::allocator<T>().allocate(count);
+            MemoryTracker::Allocate(Tag, count * sizeof(T));
+            return ptr;
+        }
+
+        void deallocate(T* ptr, size_t count) noexcept
+        {
+            MemoryTracker::Free(Tag, count * sizeof(T));
+            std::allocator<T>().deallocate(ptr, count);
+        }
+
+        template <class U>
+        bool operator==(MemoryTrackingAllocator<U, Tag> const&) const noexcept { return true; }
+        template <class U>
+        bool operator!=(MemoryTrackingAllocator<U, Tag> const&) const noexcept { return false; }
+};
+
+/// Base for heap objects which account their own size to a tag when created with new
+template <MemoryTag Tag>
+struct MemoryTracked
+{
+    static void* operator new(size_t size)
+    {
+        void* ptr = ::operator new(size);
+        MemoryTracker::Allocate(Tag, size);
+        return ptr;
+    }
+
+    static void operator delete(void* ptr, size_t size)
+    {
+        MemoryTracker::Free(Tag, size);
+        ::operator delete(ptr);
+    }
+};
+
+#endif
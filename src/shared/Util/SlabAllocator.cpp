@@ -0,0 +1,253 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/SlabAllocator.h"
+#include "Util/Errors.h"
+
+#include <cstddef>
+#include <new>
+
+#define SLAB_THREAD_CACHE_BYTES     (32 * 1024)             // per allocator and thread
+#define SLAB_PUBLISH_BATCH          32                      // allocations or frees counted per thread before they are published
+
+SlabAllocator* SlabAllocator::s_allocators[MAX_SLAB_ALLOCATORS];
+std::atomic<uint32> SlabAllocator::s_allocatorCount(0);
+
+// plain data, so it stays usable while the thread is being torn down
+struct SlabThreadCache
+{
+    SlabAllocator::FreeSlot* heads[MAX_SLAB_ALLOCATORS];
+    uint32 counts[MAX_SLAB_ALLOCATORS];
+    int32 live[MAX_SLAB_ALLOCATORS];                        // not yet published
+    uint32 allocations[MAX_SLAB_ALLOCATORS];                // not yet published
+    bool registered;
+    bool released;
+
+    static SlabThreadCache* Get();
+    static void Release();
+};
+
+namespace
+{
+    // gives the cached slots of an exiting thread back to the shared lists
+    struct SlabThreadCacheReleaser
+    {
+        ~SlabThreadCacheReleaser() { SlabThreadCache::Release(); }
+        void Register() {}
+    };
+
+    thread_local SlabThreadCache t_cache;
+    thread_local SlabThreadCacheReleaser t_releaser;
+}
+
+SlabThreadCache* SlabThreadCache::Get()
+{
+    SlabThreadCache& cache = t_cache;
+    if (cache.released)
+        return nullptr;
+
+    if (!cache.registered)
+    {
+        t_releaser.Register();
+        cache.registered = true;
+    }
+
+    return &cache;
+}
+
+void SlabThreadCache::Release()
+{
+    SlabThreadCache& cache = t_cache;
+    for (uint32 i = 0; i < SlabAllocator::GetAllocatorCount(); ++i)
+    {
+        SlabAllocator* allocator = SlabAllocator::s_allocators[i];
+        allocator->Flush(cache.heads[i], cache.counts[i], cache.counts[i]);
+        allocator->Publish(cache.live[i], cache.allocations[i]);
+    }
+
+    cache.released = true;
+}
+
+SlabAllocator::SlabAllocator(char const* name, size_t objectSize, MemoryTag tag) : m_name(name), m_tag(tag), m_head(nullptr),
+    m_slabs(0), m_liveObjects(0), m_peakObjects(0), m_allocations(0), m_heapFallbacks(0)
+{
+    size_t const alignment = alignof(std::max_align_t);
+    m_objectSize = (std::max(objectSize, sizeof(FreeSlot)) + alignment - 1) & ~(alignment - 1);
+    m_cacheLimit = std::max<uint32>(16, SLAB_THREAD_CACHE_BYTES / m_objectSize);
+    MANGOS_ASSERT(m_objectSize <= SLAB_SIZE / 4);
+
+    m_index = s_allocatorCount.load(std::memory_order_relaxed);
+    MANGOS_ASSERT(m_index < MAX_SLAB_ALLOCATORS);
+    s_allocators[m_index] = this;
+    s_allocatorCount.store(m_index + 1, std::memory_order_release);
+}
+
+void* SlabAllocator::Allocate(size_t size)
+{
+    if (size > m_objectSize)
+    {
+        m_heapFallbacks.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    SlabThreadCache* cache = SlabThreadCache::Get();
+    if (!cache)
+    {
+        // thread is exiting, take the slot straight from the shared list
+        FreeSlot* head = nullptr;
+        uint32 count = 0;
+        Refill(head, count, 1);
+        if (!head)
+            Carve(head, count);
+
+        FreeSlot* slot = head;
+        head = slot->next;
+        --count;
+        Flush(head, count, count);
+
+        int32 live = 1;
+        uint32 allocations = 1;
+        Publish(live, allocations);
+        return slot;
+    }
+
+    FreeSlot*& head = cache->heads[m_index];
+    uint32& count = cache->counts[m_index];
+    if (!head)
+    {
+        Refill(head, count, m_cacheLimit / 2);
+        if (!head)
+            Carve(head, count);
+    }
+
+    FreeSlot* slot = head;
+    head = slot->next;
+    --count;
+
+    ++cache->allocations[m_index];
+    if (++cache->live[m_index] >= SLAB_PUBLISH_BATCH || cache->allocations[m_index] >= SLAB_PUBLISH_BATCH)
+        Publish(cache->live[m_index], cache->allocations[m_index]);
+
+    return slot;
+}
+
+void SlabAllocator::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size > m_objectSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+    slot->next = nullptr;
+
+    SlabThreadCache* cache = SlabThreadCache::Get();
+    if (!cache)
+    {
+        uint32 count = 1;
+        Flush(slot, count, count);
+
+        int32 live = -1;
+        uint32 allocations = 0;
+        Publish(live, allocations);
+        return;
+    }
+
+    FreeSlot*& head = cache->heads[m_index];
+    uint32& count = cache->counts[m_index];
+    slot->next = head;
+    head = slot;
+    if (++count > m_cacheLimit)
+        Flush(head, count, m_cacheLimit / 2);
+
+    if (--cache->live[m_index] <= -SLAB_PUBLISH_BATCH)
+        Publish(cache->live[m_index], cache->allocations[m_index]);
+}
+
+SlabStatistic SlabAllocator::GetStatistic() const
+{
+    SlabStatistic statistic;
+    statistic.objectSize = m_objectSize;
+    statistic.slabs = m_slabs.load(std::memory_order_relaxed);
+    statistic.liveObjects = std::max<int64>(0, m_liveObjects.load(std::memory_order_relaxed));
+    statistic.peakObjects = std::max<int64>(0, m_peakObjects.load(std::memory_order_relaxed));
+    statistic.allocations = m_allocations.load(std::memory_order_relaxed);
+    statistic.heapFallbacks = m_heapFallbacks.load(std::memory_order_relaxed);
+    return statistic;
+}
+
+// adds the slots of a new slab to the list, lowest address first
+void SlabAllocator::Carve(FreeSlot*& head, uint32& count)
+{
+    char* slab = static_cast<char*>(::operator new(SLAB_SIZE));
+    m_slabs.fetch_add(1, std::memory_order_relaxed);
+    MemoryTracker::Allocate(m_tag, SLAB_SIZE);
+
+    for (size_t slots = SLAB_SIZE / m_objectSize; slots > 0; --slots)
+    {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + (slots - 1) * m_objectSize);
+        slot->next = head;
+        head = slot;
+        ++count;
+    }
+}
+
+// moves up to batch slots of the shared list into the given one
+void SlabAllocator::Refill(FreeSlot*& head, uint32& count, uint32 batch)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (; batch && m_head; --batch)
+    {
+        FreeSlot* slot = m_head;
+        m_head = slot->next;
+
+        slot->next = head;
+        head = slot;
+        ++count;
+    }
+}
+
+// moves up to batch slots of the given list into the shared one
+void SlabAllocator::Flush(FreeSlot*& head, uint32& count, uint32 batch)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (; batch && head; --batch)
+    {
+        FreeSlot* slot = head;
+        head = slot->next;
+        --count;
+
+        slot->next = m_head;
+        m_head = slot;
+    }
+}
+
+void SlabAllocator::Publish(int32& live, uint32& allocations)
+{
+    int64 current = m_liveObjects.fetch_add(live, std::memory_order_relaxed) + live;
+    m_allocations.fetch_add(allocations, std::memory_order_relaxed);
+    live = 0;
+    allocations = 0;
+
+    int64 peak = m_peakObjects.load(std::memory_order_relaxed);
+    while (current > peak && !m_peakObjects.compare_exchange_weak(peak, current, std::memory_order_relaxed));
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SLABALLOCATOR_H
+#define MANGOS_SLABALLOCATOR_H
+
+#include "Common.h"
+#include "Util/MemoryTracker.h"
+
+#include <atomic>
+#include <mutex>
+
+#define MAX_SLAB_ALLOCATORS 8
+#define SLAB_SIZE           (64 * 1024)
+
+struct SlabStatistic
+{
+    uint64 objectSize;                                      // slot size, the type size rounded up to the alignment
+    uint64 slabs;                                           // carved so far, kept until shutdown
+    uint64 liveObjects;
+    uint64 peakObjects;
+    uint64 allocations;                                     // since startup
+    uint64 heapFallbacks;                                   // objects too large for a slot, served by the heap
+};
+
+struct SlabThreadCache;
+
+/// Fixed size allocator for one type of short lived game object. Slots are carved from 64 KB slabs, freed slots
+/// go to a per thread free list first and are exchanged in batches with a shared one, so an object freed after
+/// its owner moved to another map thread is reused there. Slabs are never given back, the live and peak counts
+/// show how much of them is in use.
+class SlabAllocator
+{
+    public:
+        /// Slabs are accounted to the given memory tag as they are carved
+        SlabAllocator(char const* name, size_t objectSize, MemoryTag tag);
+
+        void* Allocate(size_t size);
+        void Free(void* ptr, size_t size);
+
+        char const* GetName() const { return m_name; }
+        SlabStatistic GetStatistic() const;
+
+        static uint32 GetAllocatorCount() { return s_allocatorCount.load(std::memory_order_acquire); }
+        static SlabAllocator const* GetAllocator(uint32 index) { return s_allocators[index]; }
+
+    private:
+        friend struct SlabThreadCache;
+
+        struct FreeSlot
+        {
+            FreeSlot* next;
+        };
+
+        void Carve(FreeSlot*& head, uint32& count);
+        void Refill(FreeSlot*& head, uint32& count, uint32 batch);
+        void Flush(FreeSlot*& head, uint32& count, uint32 batch);
+        void Publish(int32& live, uint32& allocations);
+
+        char const* m_name;
+        MemoryTag m_tag;
+        size_t m_objectSize;
+        uint32 m_index;
+        uint32 m_cacheLimit;                                // slots a thread keeps before it flushes half of them
+
+        std::mutex m_lock;
+        FreeSlot* m_head;
+
+        std::atomic<uint64> m_slabs;
+        std::atomic<int64> m_liveObjects;
+        std::atomic<int64> m_peakObjects;
+        std::atomic<uint64> m_allocations;
+        std::atomic<uint64> m_heapFallbacks;
+
+        static SlabAllocator* s_allocators[MAX_SLAB_ALLOCATORS];
+        static std::atomic<uint32> s_allocatorCount;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TOKENBUCKET_H
+#define MANGOS_TOKENBUCKET_H
+
+#include "Common.h"
+#include <algorithm>
+#include <chrono>
+
+namespace MaNGOS
+{
+    /// Rate limiter admitting up to rate events per second, with bursts of up to burst events.
+    /// Not thread safe, callers sharing a bucket must serialize access.
+    class TokenBucket
+    {
+        public:
+            TokenBucket() : m_rate(0), m_burst(0), m_tokens(0.0), m_lastRefill(std::chrono::steady_clock::now()) {}
+
+            /// rate 0 disables limiting
+            void SetRate(uint32 rate, uint32 burst)
+            {
+                m_rate = rate;
+                m_burst = std::max(burst, uint32(1));
+                m_tokens = m_burst;
+                m_lastRefill = std::chrono::steady_clock::now();
+            }
+
+            bool IsLimited() const { return m_rate != 0; }
+            uint32 GetRate() const { return m_rate; }
+
+            bool TryConsume()
+            {
+                if (!m_rate)
+                    return true;
+
+                Refill();
+                if (m_tokens < 1.0)
+                    return false;
+
+                m_tokens -= 1.0;
+                return true;
+            }
+
+            /// time until TryConsume can succeed again
+            std::chrono::milliseconds GetTimeToNextToken()
+            {
+                if (!m_rate)
+                    return std::chrono::milliseconds(0);
+
+                Refill();
+                if (m_tokens >= 1.0)
+                    return std::chrono::milliseconds(0);
+
+                return std::chrono::milliseconds(uint32((1.0 - m_tokens) * 1000 / m_rate) + 1);
+            }
+
+        private:
+            void Refill()
+            {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+                m_lastRefill = now;
+                m_tokens = std::min(double(m_burst), m_tokens + elapsed * m_rate);
+            }
+
+            uint32 m_rate;
+            uint32 m_burst;
+            double m_tokens;
+            std::chrono::steady_clock::time_point m_lastRefill;
+    };
+}
+
+#endif
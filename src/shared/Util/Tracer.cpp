@@ -0,0 +1,365 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/Tracer.h"
+#include "Config/Config.h"
+#include "Log/Log.h"
+#include "Policies/Singleton.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+INSTANTIATE_SINGLETON_1(Tracer);
+
+#define TRACE_DEFAULT_BUFFER_SIZE   16384                   // spans kept per thread
+
+std::atomic<bool> Tracer::s_enabled(false);
+std::chrono::steady_clock::time_point const Tracer::s_epoch = std::chrono::steady_clock::now();
+thread_local Tracer::TraceBuffer* Tracer::s_threadBuffer = nullptr;
+thread_local char const* Tracer::s_threadName = nullptr;
+
+/// Ring of the last spans of one thread. Only the owning thread writes, dumps read concurrently and
+/// discard whatever the owner may have overwritten while they were copying.
+class Tracer::TraceBuffer
+{
+    public:
+        TraceBuffer(uint32 threadId, uint32 size) : m_threadId(threadId), m_name(nullptr), m_events(size), m_mask(size - 1), m_head(0) {}
+
+        void Push(TraceEvent const& event)
+        {
+            uint64 head = m_head.load(std::memory_order_relaxed);
+            m_events[head & m_mask] = event;
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        void Collect(uint64 since, std::vector<TraceEvent>& events) const
+        {
+            uint64 const size = m_events.size();
+            uint64 head = m_head.load(std::memory_order_acquire);
+            uint64 first = head > size ? head - size : 0;
+
+            std::vector<TraceEvent> copied;
+            copied.reserve(head - first);
+            for (uint64 i = first; i < head; ++i)
+                copied.push_back(m_events[i & m_mask]);
+
+            // the owner may already be writing the slot of event 'after', which is also the one of event 'after - size'
+            uint64 after = m_head.load(std::memory_order_acquire);
+            uint64 overwritten = after + 1 > size ? after + 1 - size : 0;
+            size_t skip = overwritten > first ? size_t(std::min(overwritten - first, uint64(copied.size()))) : 0;
+
+            for (size_t i = skip; i < copied.size(); ++i)
+                if (copied[i].start + copied[i].duration >= since)
+                    events.push_back(copied[i]);
+        }
+
+        uint32 GetThreadId() const { return m_threadId; }
+        char const* GetName() const { return m_name.load(std::memory_order_relaxed); }
+        void SetName(char const* name) { m_name.store(name, std::memory_order_relaxed); }
+
+    private:
+        uint32 m_threadId;
+        std::atomic<char const*> m_name;
+        std::vector<TraceEvent> m_events;
+        uint64 m_mask;
+        std::atomic<uint64> m_head;
+};
+
+Tracer::Tracer() : m_bufferSize(TRACE_DEFAULT_BUFFER_SIZE), m_nextThreadId(1),
+    m_slowTickThreshold(0), m_slowTickInterval(0), m_slowTickKeep(0), m_nextSlowTickCapture(0), m_capturing(false)
+{
+}
+
+Tracer::~Tracer()
+{
+    if (m_captureThread.joinable())
+        m_captureThread.join();
+}
+
+void Tracer::Initialize()
+{
+    // power of two, so the ring index is a mask
+    uint32 size = std::max(sConfig.GetIntDefault("Trace.BufferSize", TRACE_DEFAULT_BUFFER_SIZE), 16);
+    uint32 bufferSize = 16;
+    while (bufferSize < size)
+        bufferSize <<= 1;
+
+    {
+        std::lock_guard<std::mutex> guard(m_buffersLock);
+        m_bufferSize = bufferSize;
+    }
+
+    m_slowTickThreshold = sConfig.GetIntDefault("Trace.SlowTick.Threshold", 1000);
+    m_slowTickInterval = sConfig.GetIntDefault("Trace.SlowTick.Interval", 60);
+    m_slowTickKeep = std::max(sConfig.GetIntDefault("Trace.SlowTick.Keep", 20), 1);
+
+    m_slowTickDir = sConfig.GetStringDefault("Trace.SlowTick.Directory", "");
+    if (m_slowTickDir.empty())
+        m_slowTickDir = sLog.GetLogsDir() + "slowticks";
+
+    if ((m_slowTickDir.at(m_slowTickDir.length() - 1) != '/') && (m_slowTickDir.at(m_slowTickDir.length() - 1) != '\\'))
+        m_slowTickDir.push_back('/');
+
+    if (m_slowTickThreshold)
+    {
+        boost::system::error_code error;
+        MaNGOS::Filesystem::create_directories(m_slowTickDir, error);
+        if (error)
+        {
+            sLog.outError("Tracer: could not create slow tick directory %s, captures disabled: %s", m_slowTickDir.c_str(), error.message().c_str());
+            m_slowTickThreshold = 0;
+        }
+    }
+
+    s_enabled.store(sConfig.GetBoolDefault("Trace.Enable", true), std::memory_order_relaxed);
+}
+
+void Tracer::Record(TraceEvent const& event)
+{
+    TraceBuffer* buffer = s_threadBuffer;
+    if (!buffer)
+        buffer = CreateThreadBuffer();
+
+    buffer->Push(event);
+}
+
+void Tracer::SetThreadName(char const* name)
+{
+    // threads usually name themselves before tracing is enabled, so the name waits for the buffer
+    s_threadName = name;
+    if (s_threadBuffer)
+        s_threadBuffer->SetName(name);
+}
+
+Tracer::TraceBuffer* Tracer::CreateThreadBuffer()
+{
+    Tracer& tracer = sTracer;
+
+    std::lock_guard<std::mutex> guard(tracer.m_buffersLock);
+    // buffers outlive their threads, so a dump still shows what an exited thread did
+    tracer.m_buffers.push_back(std::make_shared<TraceBuffer>(tracer.m_nextThreadId++, tracer.m_bufferSize));
+    s_threadBuffer = tracer.m_buffers.back().get();
+    s_threadBuffer->SetName(s_threadName);
+    return s_threadBuffer;
+}
+
+static void WriteTraceString(FILE* file, char const* text)
+{
+    fputc('"', file);
+    for (char const* c = text ? text : ""; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', file);
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+std::vector<Tracer::TraceThread> Tracer::Collect(uint64 since)
+{
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> guard(m_buffersLock);
+        buffers = m_buffers;
+    }
+
+    std::vector<TraceThread> threads(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        threads[i].id = buffers[i]->GetThreadId();
+        threads[i].name = buffers[i]->GetName();
+        buffers[i]->Collect(since, threads[i].events);
+    }
+
+    return threads;
+}
+
+int32 Tracer::WriteChromeTrace(std::string const& file, std::vector<TraceThread> const& threads)
+{
+    FILE* out = fopen(file.c_str(), "w");
+    if (!out)
+        return -1;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+
+    int32 count = 0;
+    bool first = true;
+    for (TraceThread const& thread : threads)
+    {
+        if (thread.name)
+        {
+            fprintf(out, "%s\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", first ? "" : ",", thread.id);
+            WriteTraceString(out, thread.name);
+            fputs("}}", out);
+            first = false;
+        }
+
+        for (TraceEvent const& event : thread.events)
+        {
+            fprintf(out, "%s\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ".%03u,\"dur\":" UI64FMTD ".%03u,\"cat\":",
+                    first ? "" : ",", thread.id,
+                    event.start / 1000, uint32(event.start % 1000), event.duration / 1000, uint32(event.duration % 1000));
+            WriteTraceString(out, event.category);
+            fputs(",\"name\":", out);
+            WriteTraceString(out, event.name);
+
+            if (event.argNames[0])
+            {
+                fputs(",\"args\":{", out);
+                for (uint32 i = 0; i < 2 && event.argNames[i]; ++i)
+                {
+                    if (i)
+                        fputc(',', out);
+                    WriteTraceString(out, event.argNames[i]);
+                    fprintf(out, ":" SI64FMTD, event.args[i]);
+                }
+                fputc('}', out);
+            }
+
+            fputc('}', out);
+            first = false;
+            ++count;
+        }
+    }
+
+    fputs("\n]}\n", out);
+    bool failed = ferror(out) != 0;
+    fclose(out);
+
+    return failed ? -1 : count;
+}
+
+int32 Tracer::Dump(std::string const& file, uint32 seconds)
+{
+    uint64 now = Now();
+    uint64 window = uint64(seconds) * 1000000000ULL;
+
+    return WriteChromeTrace(file, Collect(now > window ? now - window : 0));
+}
+
+void Tracer::CheckSlowTick(uint32 tickTime)
+{
+    if (!m_slowTickThreshold || tickTime < m_slowTickThreshold || !IsEnabled())
+        return;
+
+    // a server which stays slow would otherwise write a capture every tick
+    time_t now = time(nullptr);
+    if (now < m_nextSlowTickCapture || m_capturing.load(std::memory_order_acquire))
+        return;
+
+    m_nextSlowTickCapture = now + m_slowTickInterval;
+
+    if (m_captureThread.joinable())
+        m_captureThread.join();
+
+    // one extra second of context before the tick, the summary only looks at the tick itself
+    uint64 end = Now();
+    uint64 tickStart = end > uint64(tickTime) * 1000000 ? end - uint64(tickTime) * 1000000 : 0;
+    uint64 since = tickStart > 1000000000ULL ? tickStart - 1000000000ULL : 0;
+
+    std::string name = m_slowTickDir + "slowtick_" + Log::GetTimestampStr() + "_" + std::to_string(tickTime) + "ms";
+    sLog.outError("World tick took %u ms (threshold %u ms), writing capture %s.json", tickTime, m_slowTickThreshold, name.c_str());
+
+    // only the copy happens on the calling thread, formatting and writing would stretch the next tick further
+    m_capturing.store(true, std::memory_order_release);
+    m_captureThread = std::thread(&Tracer::WriteSlowTickCapture, this, std::move(name), Collect(since), tickStart, tickTime);
+}
+
+void Tracer::WriteSlowTickCapture(std::string name, std::vector<TraceThread> threads, uint64 tickStart, uint32 tickTime)
+{
+    WriteChromeTrace(name + ".json", threads);
+    WriteSlowTickSummary(name + ".txt", threads, tickStart, tickTime);
+
+    // rotate, the timestamp in the names keeps them in capture order
+    try
+    {
+        std::vector<std::string> captures;
+        for (auto const& entry : MaNGOS::Filesystem::directory_iterator(m_slowTickDir))
+        {
+            std::string file = entry.path().filename().string();
+            if (file.compare(0, 9, "slowtick_") == 0 && file.size() > 5 && file.compare(file.size() - 5, 5, ".json") == 0)
+                captures.push_back(entry.path().string());
+        }
+
+        std::sort(captures.begin(), captures.end());
+        for (size_t i = 0; i + m_slowTickKeep < captures.size(); ++i)
+        {
+            MaNGOS::Filesystem::remove(captures[i]);
+            MaNGOS::Filesystem::remove(captures[i].substr(0, captures[i].size() - 5) + ".txt");
+        }
+    }
+    catch (MaNGOS::Filesystem::filesystem_error const& e)
+    {
+        sLog.outError("Tracer: could not rotate slow tick captures: %s", e.what());
+    }
+
+    m_capturing.store(false, std::memory_order_release);
+}
+
+void Tracer::WriteSlowTickSummary(std::string const& file, std::vector<TraceThread> const& threads, uint64 tickStart, uint32 tickTime)
+{
+    struct SpanTotal
+    {
+        std::string name;
+        uint32 count;
+        uint64 total;
+        uint64 max;
+    };
+
+    // spans carrying a map are kept apart per map instance, everything else per category and name
+    std::map<std::string, SpanTotal> totals;
+    for (TraceThread const& thread : threads)
+    {
+        for (TraceEvent const& event : thread.events)
+        {
+            if (event.start < tickStart)
+                continue;
+
+            std::string name = std::string(event.category) + "  " + event.name;
+            if (event.argNames[0] && strcmp(event.argNames[0], "map") == 0)
+                name += " map=" + std::to_string(event.args[0]) + " instance=" + std::to_string(event.args[1]);
+
+            SpanTotal& total = totals[name];
+            total.name = name;
+            ++total.count;
+            total.total += event.duration;
+            total.max = std::max(total.max, event.duration);
+        }
+    }
+
+    std::vector<SpanTotal> sorted;
+    sorted.reserve(totals.size());
+    for (auto const& total : totals)
+        sorted.push_back(total.second);
+
+    std::sort(sorted.begin(), sorted.end(), [](SpanTotal const& a, SpanTotal const& b) { return a.total > b.total; });
+
+    FILE* out = fopen(file.c_str(), "w");
+    if (!out)
+        return;
+
+    fprintf(out, "World tick of %u ms, threshold %u ms. Spans started during the tick by total time:\n\n", tickTime, m_slowTickThreshold);
+    fprintf(out, "%12s %12s %8s  %s\n", "total ms", "max ms", "count", "span");
+    for (SpanTotal const& total : sorted)
+        fprintf(out, "%12.3f %12.3f %8u  %s\n", total.total / 1000000.0, total.max / 1000000.0, total.count, total.name.c_str());
+
+    fclose(out);
+}
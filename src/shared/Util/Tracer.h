@@ -0,0 +1,142 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TRACER_H
+#define MANGOS_TRACER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// One finished span. All strings must outlive the tracer (literals, opcode table names, ...).
+struct TraceEvent
+{
+    char const* category;
+    char const* name;
+    char const* argNames[2];
+    int64 args[2];
+    uint64 start;                                           // nanoseconds since the tracer was created
+    uint64 duration;                                        // nanoseconds
+};
+
+/// Records spans of every thread into per-thread ring buffers, so the last seconds before a
+/// slow tick can be dumped as a Chrome trace (chrome://tracing, ui.perfetto.dev) afterwards.
+/// Recording is one relaxed load while disabled and two clock reads plus a buffer write while enabled.
+class Tracer : public MaNGOS::Singleton<Tracer, MaNGOS::ClassLevelLockable<Tracer, std::mutex> >
+{
+        friend class MaNGOS::OperatorNew<Tracer>;
+        Tracer();
+        ~Tracer();
+
+    public:
+        void Initialize();
+
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+        static uint64 Now() { return uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count()); }
+        static void Record(TraceEvent const& event);
+
+        /// Names the calling thread in dumps
+        static void SetThreadName(char const* name);
+
+        /// Writes all spans which ended in the last seconds to file, returns the number of spans written or -1 on error
+        int32 Dump(std::string const& file, uint32 seconds);
+
+        /// Called once per world tick. Ticks over Trace.SlowTick.Threshold write their spans and a summary
+        /// of them to the rotating slow tick directory, from a separate thread.
+        void CheckSlowTick(uint32 tickTime);
+
+    private:
+        class TraceBuffer;
+
+        struct TraceThread
+        {
+            uint32 id;
+            char const* name;
+            std::vector<TraceEvent> events;
+        };
+
+        static TraceBuffer* CreateThreadBuffer();
+
+        std::vector<TraceThread> Collect(uint64 since);
+        static int32 WriteChromeTrace(std::string const& file, std::vector<TraceThread> const& threads);
+        void WriteSlowTickCapture(std::string name, std::vector<TraceThread> threads, uint64 tickStart, uint32 tickTime);
+        void WriteSlowTickSummary(std::string const& file, std::vector<TraceThread> const& threads, uint64 tickStart, uint32 tickTime);
+
+        static std::atomic<bool> s_enabled;
+        static std::chrono::steady_clock::time_point const s_epoch;
+        static thread_local TraceBuffer* s_threadBuffer;
+        static thread_local char const* s_threadName;
+
+        std::mutex m_buffersLock;
+        std::vector<std::shared_ptr<TraceBuffer>> m_buffers;
+        uint32 m_bufferSize;
+        uint32 m_nextThreadId;
+
+        uint32 m_slowTickThreshold;                         // ms, 0 disables captures
+        uint32 m_slowTickInterval;                          // minimum seconds between two captures
+        uint32 m_slowTickKeep;                              // captures kept in the directory
+        std::string m_slowTickDir;
+        time_t m_nextSlowTickCapture;
+        std::atomic<bool> m_capturing;
+        std::thread m_captureThread;
+};
+
+#define sTracer MaNGOS::Singleton<Tracer>::Instance()
+
+/// Scoped span, recorded when it goes out of scope
+class TraceSpan
+{
+    public:
+        TraceSpan(char const* category, char const* name) : TraceSpan(category, name, nullptr, 0, nullptr, 0) {}
+        TraceSpan(char const* category, char const* name, char const* argName, int64 arg) : TraceSpan(category, name, argName, arg, nullptr, 0) {}
+        TraceSpan(char const* category, char const* name, char const* argName1, int64 arg1, char const* argName2, int64 arg2)
+            : m_event{ category, name, { argName1, argName2 }, { arg1, arg2 }, 0, 0 }, m_running(Tracer::IsEnabled())
+        {
+            if (m_running)
+                m_event.start = Tracer::Now();
+        }
+
+        ~TraceSpan() { Stop(); }
+
+        TraceSpan(TraceSpan const&) = delete;
+        TraceSpan& operator=(TraceSpan const&) = delete;
+
+        /// Ends the span before the scope does
+        void Stop()
+        {
+            if (!m_running)
+                return;
+
+            m_running = false;
+            m_event.duration = Tracer::Now() - m_event.start;
+            Tracer::Record(m_event);
+        }
+
+    private:
+        TraceEvent m_event;
+        bool m_running;
+};
+
+#endif